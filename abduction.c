@@ -0,0 +1,436 @@
+#include "abduction.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Aucune proposition en cours plus haut dans le parcours */
+#define ABD_AUCUNE UINT32_MAX
+
+enum { ABD_NON_VU, ABD_EN_COURS, ABD_FAIT };
+
+/* État d’un calcul d’abduction */
+typedef struct {
+    const BCCompilee *C;
+    const OptionsAbduction *O;
+    const Allocateur *A;
+    uint8_t *etat;            // par proposition : ABD_*
+    uint32_t *profondeur;     // par proposition en cours : profondeur dans le parcours
+    Explications *memo;       // par proposition terminée
+    PropId *tampon;           // union de deux explications
+    bool complet;
+} Abduction;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : abduction_options_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Options par défaut : aucune limite, aucun fait connu, seules
+ *  les propositions qu’aucune règle ne conclut sont supposables.
+ *
+ * Paramètres :
+ *  - O : options à initialiser
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void abduction_options_init(OptionsAbduction *O) {
+    O->max_explications = 0;
+    O->max_taille = 0;
+    O->connus = NULL;
+    O->abductibles = NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : explications_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Prépare un ensemble d’explications vide.
+ *
+ * Paramètres :
+ *  - E : ensemble à initialiser
+ *  - A : allocateur des explications
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void explications_init(Explications *E, const Allocateur *A) {
+    E->e = NULL;
+    E->nb = E->cap = 0;
+    E->complet = true;
+    E->alloc = A;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ajouter_explication
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute une copie d’une explication (identifiants triés).
+ *
+ * Paramètres :
+ *  - E     : ensemble d’explications
+ *  - faits : identifiants triés
+ *  - nb    : nombre d’identifiants
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void ajouter_explication(Explications *E, const PropId *faits, uint32_t nb) {
+    if (E->nb == E->cap) {
+        E->cap = E->cap ? E->cap * 2 : 4;
+        E->e = (Explication *)mem_reallouer(E->alloc, E->e, E->cap * sizeof(Explication));
+    }
+    Explication *x = &E->e[E->nb++];
+    x->nb = nb;
+    x->faits = NULL;
+    if (nb) {
+        x->faits = (PropId *)mem_allouer(E->alloc, nb * sizeof(PropId));
+        memcpy(x->faits, faits, nb * sizeof(PropId));
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : vider_explications
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère les explications d’un ensemble en gardant son tableau.
+ *
+ * Paramètres :
+ *  - E : ensemble à vider
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void vider_explications(Explications *E) {
+    for (size_t i = 0; i < E->nb; i++) mem_liberer(E->alloc, E->e[i].faits);
+    E->nb = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : explications_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère un ensemble d’explications rendu par abduire.
+ *
+ * Paramètres :
+ *  - E : ensemble à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void explications_detruire(Explications *E) {
+    vider_explications(E);
+    mem_liberer(E->alloc, E->e);
+    E->e = NULL;
+    E->cap = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : est_inclus
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste l’inclusion de deux explications (parcours fusionné des
+ *  identifiants triés).
+ *
+ * Paramètres :
+ *  - a : explication supposée incluse
+ *  - b : explication supposée englobante
+ *
+ * Valeur de retour :
+ *  - true si a ⊆ b
+ */
+static bool est_inclus(const Explication *a, const Explication *b) {
+    if (a->nb > b->nb) return false;
+
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < a->nb; i++) {
+        while (j < b->nb && b->faits[j] < a->faits[i]) j++;
+        if (j == b->nb || b->faits[j] != a->faits[i]) return false;
+        j++;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : reunir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Union triée de deux explications.
+ *
+ * Paramètres :
+ *  - a, b : explications
+ *  - out  : destination (au moins a->nb + b->nb places)
+ *
+ * Valeur de retour :
+ *  - taille de l’union
+ */
+static uint32_t reunir(const Explication *a, const Explication *b, PropId *out) {
+    uint32_t i = 0, j = 0, n = 0;
+
+    while (i < a->nb && j < b->nb) {
+        if (a->faits[i] < b->faits[j]) out[n++] = a->faits[i++];
+        else if (b->faits[j] < a->faits[i]) out[n++] = b->faits[j++];
+        else {
+            out[n++] = a->faits[i++];
+            j++;
+        }
+    }
+    while (i < a->nb) out[n++] = a->faits[i++];
+    while (j < b->nb) out[n++] = b->faits[j++];
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : comparer_explications
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ordre de qsort : taille croissante, puis identifiants.
+ *
+ * Paramètres :
+ *  - a, b : pointeurs sur deux Explication
+ *
+ * Valeur de retour :
+ *  - négatif, nul ou positif
+ */
+static int comparer_explications(const void *a, const void *b) {
+    const Explication *x = (const Explication *)a;
+    const Explication *y = (const Explication *)b;
+
+    if (x->nb != y->nb) return x->nb < y->nb ? -1 : 1;
+    for (uint32_t i = 0; i < x->nb; i++)
+        if (x->faits[i] != y->faits[i]) return x->faits[i] < y->faits[i] ? -1 : 1;
+    return 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : minimiser
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ne garde que les explications minimales pour l’inclusion (les
+ *  doublons disparaissent), triées par taille croissante, puis
+ *  tronque à max_explications.
+ *
+ * Paramètres :
+ *  - X : calcul en cours (options, indicateur de complétude)
+ *  - E : ensemble à réduire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - n : explications gardées (E->e[0..n[)
+ */
+static void minimiser(Abduction *X, Explications *E) {
+    if (E->nb > 1) qsort(E->e, E->nb, sizeof(Explication), comparer_explications);
+
+    size_t n = 0;
+    for (size_t i = 0; i < E->nb; i++) {
+        bool garde = true;
+        for (size_t k = 0; k < n && garde; k++)
+            if (est_inclus(&E->e[k], &E->e[i])) garde = false;
+
+        if (garde) E->e[n++] = E->e[i];
+        else mem_liberer(E->alloc, E->e[i].faits);
+    }
+    E->nb = n;
+
+    size_t max = X->O->max_explications;
+    if (max && E->nb > max) {
+        for (size_t i = max; i < E->nb; i++) mem_liberer(E->alloc, E->e[i].faits);
+        E->nb = max;
+        E->complet = false;
+        X->complet = false;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : produit
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Remplace acc par le produit acc × E (unions deux à deux), en
+ *  écartant les unions plus grandes que max_taille, puis minimise.
+ *
+ * Paramètres :
+ *  - X   : calcul en cours
+ *  - acc : explications accumulées (remplacées)
+ *  - E   : explications d’une prémisse supplémentaire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void produit(Abduction *X, Explications *acc, const Explications *E) {
+    Explications r;
+    explications_init(&r, X->A);
+    size_t max = X->O->max_taille;
+
+    for (size_t i = 0; i < acc->nb; i++) {
+        for (size_t j = 0; j < E->nb; j++) {
+            uint32_t n = reunir(&acc->e[i], &E->e[j], X->tampon);
+            if (max && n > max) continue;
+            ajouter_explication(&r, X->tampon, n);
+        }
+    }
+    minimiser(X, &r);
+
+    explications_detruire(acc);
+    *acc = r;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : explorer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule les explications minimales d’une proposition : le
+ *  singleton {p} si p est supposable, plus, pour chaque règle qui
+ *  conclut p, le produit des explications de ses prémisses. Une
+ *  proposition déjà en cours (cycle) n’a pas d’explication ; le
+ *  résultat n’est alors mémorisé que si le cycle se referme sur p
+ *  lui-même.
+ *
+ * Paramètres :
+ *  - X    : calcul en cours
+ *  - p    : proposition à expliquer
+ *  - prof : profondeur de p dans le parcours
+ *  - out  : explications de p (ensemble vide initialisé)
+ *
+ * Valeur de retour :
+ *  - plus petite profondeur d’une proposition en cours rencontrée
+ *    (ABD_AUCUNE si le résultat ne dépend d’aucun cycle ouvert)
+ *
+ * Variables locales :
+ *  - bas    : plus petite profondeur en cours rencontrée sous p
+ *  - regles : règles qui concluent p (nb_regles)
+ *  - acc    : produit des prémisses de la règle courante
+ */
+static uint32_t explorer(Abduction *X, PropId p, uint32_t prof, Explications *out) {
+    const BCCompilee *C = X->C;
+    const OptionsAbduction *O = X->O;
+
+    if (O->connus && O->connus[p]) {
+        ajouter_explication(out, NULL, 0);
+        return ABD_AUCUNE;
+    }
+    if (X->etat[p] == ABD_FAIT) {
+        const Explications *M = &X->memo[p];
+        for (size_t i = 0; i < M->nb; i++) ajouter_explication(out, M->e[i].faits, M->e[i].nb);
+        return ABD_AUCUNE;
+    }
+    if (X->etat[p] == ABD_EN_COURS) return X->profondeur[p];
+
+    X->etat[p] = ABD_EN_COURS;
+    X->profondeur[p] = prof;
+    uint32_t bas = ABD_AUCUNE;
+
+    const uint32_t *regles;
+    uint32_t nb_regles = bcc_producteurs(C, p, &regles);
+    bool produite = nb_regles != 0;
+    if (O->abductibles ? O->abductibles[p] : !produite) ajouter_explication(out, &p, 1);
+
+    for (uint32_t k = 0; k < nb_regles; k++) {
+        const RegleCompilee *R = &C->regles[regles[k]];
+        Explications acc;
+        explications_init(&acc, X->A);
+        ajouter_explication(&acc, NULL, 0);
+
+        for (uint32_t j = 0; j < R->nb && acc.nb; j++) {
+            Explications E;
+            explications_init(&E, X->A);
+            uint32_t b = explorer(X, C->premisses[R->debut + j], prof + 1, &E);
+            if (b < bas) bas = b;
+            produit(X, &acc, &E);
+            explications_detruire(&E);
+        }
+
+        for (size_t i = 0; i < acc.nb; i++) {
+            if (out->nb == out->cap) {
+                out->cap = out->cap ? out->cap * 2 : 4;
+                out->e = (Explication *)mem_reallouer(out->alloc, out->e, out->cap * sizeof(Explication));
+            }
+            out->e[out->nb++] = acc.e[i];
+        }
+        acc.nb = 0;
+        explications_detruire(&acc);
+    }
+    minimiser(X, out);
+
+    if (bas < prof) {
+        X->etat[p] = ABD_NON_VU;
+        return bas;
+    }
+
+    X->etat[p] = ABD_FAIT;
+    for (size_t i = 0; i < out->nb; i++) ajouter_explication(&X->memo[p], out->e[i].faits, out->e[i].nb);
+    return ABD_AUCUNE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : abduire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Cherche les ensembles minimaux de faits supposables qui, avec
+ *  les faits connus, permettent de déduire l’observation. Les
+ *  explications sont triées par taille croissante. Un fait connu
+ *  n’apparaît jamais dans une explication ; si l’observation est
+ *  déjà déductible des faits connus, la seule explication est vide.
+ *
+ * Paramètres :
+ *  - C           : BC compilée
+ *  - observation : proposition à expliquer
+ *  - O           : options (NULL : valeurs par défaut)
+ *  - res         : explications (à libérer par explications_detruire)
+ *
+ * Valeur de retour :
+ *  - nombre d’explications (0 : observation inexplicable dans les
+ *    limites données)
+ *
+ * Variables locales :
+ *  - X  : état du calcul (mémo, profondeur de chaque proposition)
+ *  - np : nombre de propositions
+ */
+size_t abduire(const BCCompilee *C, PropId observation, const OptionsAbduction *O, Explications *res) {
+    OptionsAbduction defaut;
+    size_t np = bcc_nb_propositions(C);
+    Abduction X;
+
+    if (!O) {
+        abduction_options_init(&defaut);
+        O = &defaut;
+    }
+    X.C = C;
+    X.O = O;
+    X.A = C->symboles.alloc;
+    X.complet = true;
+    explications_init(res, X.A);
+    if (observation >= np) return 0;
+
+    TRACE_DEBUT("abduire");
+
+    X.etat = (uint8_t *)mem_allouer_zero(X.A, np);
+    X.profondeur = (uint32_t *)mem_allouer(X.A, np * sizeof(uint32_t));
+    X.memo = (Explications *)mem_allouer(X.A, np * sizeof(Explications));
+    for (size_t p = 0; p < np; p++) explications_init(&X.memo[p], X.A);
+    X.tampon = (PropId *)mem_allouer(X.A, (np ? np : 1) * sizeof(PropId));
+
+    explorer(&X, observation, 0, res);
+    res->complet = X.complet;
+
+    for (size_t p = 0; p < np; p++) explications_detruire(&X.memo[p]);
+    mem_liberer(X.A, X.memo);
+    mem_liberer(X.A, X.profondeur);
+    mem_liberer(X.A, X.etat);
+    mem_liberer(X.A, X.tampon);
+
+    TRACE_FIN("abduire");
+    return res->nb;
+}
@@ -0,0 +1,48 @@
+#ifndef ABDUCTION_H
+#define ABDUCTION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+
+/*
+ * Abduction : ensembles minimaux de faits de base qui, ajoutés aux
+ * faits connus, permettent de déduire une observation. Le graphe des
+ * règles est parcouru à rebours depuis l’observation (arbre ET/OU :
+ * OU entre les règles qui concluent une proposition, ET entre les
+ * prémisses d’une règle). Les explications d’une règle sont le
+ * produit de celles de ses prémisses ; à chaque étape, seuls les
+ * ensembles minimaux (au sens de l’inclusion) sont gardés et ceux
+ * qui dépassent la taille maximale sont écartés. Le résultat de
+ * chaque proposition est mémorisé, sauf s’il dépend d’un cycle encore
+ * ouvert plus haut dans le parcours (un cycle n’apporte jamais
+ * d’explication minimale).
+ */
+
+typedef struct {
+    size_t max_explications;     // par proposition, les plus petites gardées (0 : pas de limite)
+    size_t max_taille;           // faits par explication (0 : pas de limite)
+    const uint8_t *connus;       // par proposition : déjà vrai (NULL : aucun)
+    const uint8_t *abductibles;  // par proposition : peut être supposé (NULL : non conclues)
+} OptionsAbduction;
+
+/* Explication : identifiants triés */
+typedef struct {
+    PropId *faits;
+    uint32_t nb;
+} Explication;
+
+typedef struct {
+    Explication *e;
+    size_t nb;
+    size_t cap;
+    bool complet;                // false : max_explications a écarté des explications
+    const Allocateur *alloc;
+} Explications;
+
+void abduction_options_init(OptionsAbduction *O);
+size_t abduire(const BCCompilee *C, PropId observation, const OptionsAbduction *O, Explications *res);
+void explications_detruire(Explications *E);
+
+#endif
@@ -0,0 +1,327 @@
+#include "alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : systeme_allouer / systeme_reallouer / systeme_liberer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Opérations de l’allocateur par défaut (bibliothèque C).
+ *
+ * Paramètres :
+ *  - ctx : inutilisé
+ *  - p   : bloc existant
+ *  - n   : taille demandée en octets
+ *
+ * Valeur de retour :
+ *  - bloc alloué, ou NULL en cas d’échec
+ */
+static void *systeme_allouer(void *ctx, size_t n) {
+    (void)ctx;
+    return malloc(n);
+}
+
+static void *systeme_reallouer(void *ctx, void *p, size_t n) {
+    (void)ctx;
+    return realloc(p, n);
+}
+
+static void systeme_liberer(void *ctx, void *p) {
+    (void)ctx;
+    free(p);
+}
+
+const Allocateur allocateur_systeme = {
+    systeme_allouer, systeme_reallouer, systeme_liberer, NULL, NULL
+};
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : echouer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Signale un échec d’allocation : appelle le gestionnaire de
+ *  l’allocateur s’il existe, puis interrompt le programme.
+ *
+ * Paramètres :
+ *  - A : allocateur en échec
+ *  - n : taille demandée en octets
+ *
+ * Valeur de retour :
+ *  - Aucune (ne retourne pas)
+ */
+static void echouer(const Allocateur *A, size_t n) {
+    if (A->echec) A->echec(A->ctx, n);
+    fprintf(stderr, "Allocation de %zu octets impossible\n", n);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mem_allouer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Alloue un bloc avec l’allocateur donné. Une taille nulle est
+ *  arrondie à 1 pour obtenir un pointeur libérable.
+ *
+ * Paramètres :
+ *  - A : allocateur (NULL : allocateur système)
+ *  - n : taille en octets
+ *
+ * Valeur de retour :
+ *  - pointeur vers le bloc alloué (jamais NULL)
+ */
+void *mem_allouer(const Allocateur *A, size_t n) {
+    if (!A) A = &allocateur_systeme;
+    if (n == 0) n = 1;
+
+    void *p = A->allouer(A->ctx, n);
+    if (!p) echouer(A, n);
+    return p;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mem_allouer_zero
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Alloue un bloc initialisé à zéro.
+ *
+ * Paramètres :
+ *  - A : allocateur (NULL : allocateur système)
+ *  - n : taille en octets
+ *
+ * Valeur de retour :
+ *  - pointeur vers le bloc alloué (jamais NULL)
+ */
+void *mem_allouer_zero(const Allocateur *A, size_t n) {
+    void *p = mem_allouer(A, n);
+    memset(p, 0, n);
+    return p;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mem_reallouer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Redimensionne un bloc (p == NULL : nouvelle allocation).
+ *
+ * Paramètres :
+ *  - A : allocateur (NULL : allocateur système)
+ *  - p : bloc à redimensionner
+ *  - n : nouvelle taille en octets
+ *
+ * Valeur de retour :
+ *  - pointeur vers le bloc redimensionné (jamais NULL)
+ */
+void *mem_reallouer(const Allocateur *A, void *p, size_t n) {
+    if (!A) A = &allocateur_systeme;
+    if (n == 0) n = 1;
+
+    void *q = A->reallouer(A->ctx, p, n);
+    if (!q) echouer(A, n);
+    return q;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mem_liberer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Rend un bloc à l’allocateur qui l’a fourni (NULL accepté).
+ *
+ * Paramètres :
+ *  - A : allocateur (NULL : allocateur système)
+ *  - p : bloc à libérer
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void mem_liberer(const Allocateur *A, void *p) {
+    if (!p) return;
+    if (!A) A = &allocateur_systeme;
+    A->liberer(A->ctx, p);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mem_dupliquer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Duplique une chaîne de caractères avec l’allocateur donné.
+ *
+ * Paramètres :
+ *  - A : allocateur (NULL : allocateur système)
+ *  - s : chaîne à copier
+ *
+ * Valeur de retour :
+ *  - copie de la chaîne (jamais NULL)
+ */
+char *mem_dupliquer(const Allocateur *A, const char *s) {
+    size_t n = strlen(s) + 1;
+    char *p = (char *)mem_allouer(A, n);
+    memcpy(p, s, n);
+    return p;
+}
+
+/*
+ * Chaque bloc de l’allocateur comptable est précédé d’un en-tête
+ * contenant sa taille (aligné comme max_align_t).
+ */
+typedef union {
+    size_t taille;
+    max_align_t alignement;
+} EnTete;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : accepter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie qu’une croissance de "plus" octets respecte la limite.
+ *
+ * Paramètres :
+ *  - C    : compteur
+ *  - plus : octets supplémentaires
+ *
+ * Valeur de retour :
+ *  - true si la croissance est permise
+ */
+static bool accepter(CompteurAlloc *C, size_t plus) {
+    if (C->limite && (plus > C->limite || C->octets > C->limite - plus)) {
+        C->nb_refus++;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compteur_allouer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Alloue un bloc précédé de son en-tête et met à jour les
+ *  compteurs.
+ *
+ * Paramètres :
+ *  - ctx : compteur
+ *  - n   : taille demandée
+ *
+ * Valeur de retour :
+ *  - bloc utilisable, ou NULL (échec du parent ou limite atteinte)
+ */
+static void *compteur_allouer(void *ctx, size_t n) {
+    CompteurAlloc *C = (CompteurAlloc *)ctx;
+    if (!accepter(C, n)) return NULL;
+
+    EnTete *e = (EnTete *)C->parent->allouer(C->parent->ctx, sizeof(EnTete) + n);
+    if (!e) return NULL;
+
+    e->taille = n;
+    C->octets += n;
+    if (C->octets > C->pic) C->pic = C->octets;
+    C->nb_allocations++;
+    return e + 1;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compteur_liberer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère un bloc et retire sa taille des compteurs.
+ *
+ * Paramètres :
+ *  - ctx : compteur
+ *  - p   : bloc fourni par compteur_allouer
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void compteur_liberer(void *ctx, void *p) {
+    CompteurAlloc *C = (CompteurAlloc *)ctx;
+    EnTete *e = (EnTete *)p - 1;
+
+    C->octets -= e->taille;
+    C->nb_allocations--;
+    C->parent->liberer(C->parent->ctx, e);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compteur_reallouer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Redimensionne un bloc en tenant compte de la limite.
+ *
+ * Paramètres :
+ *  - ctx : compteur
+ *  - p   : bloc existant (NULL : allocation)
+ *  - n   : nouvelle taille
+ *
+ * Valeur de retour :
+ *  - bloc redimensionné, ou NULL (l’ancien reste valide)
+ */
+static void *compteur_reallouer(void *ctx, void *p, size_t n) {
+    CompteurAlloc *C = (CompteurAlloc *)ctx;
+    if (!p) return compteur_allouer(ctx, n);
+
+    EnTete *e = (EnTete *)p - 1;
+    size_t ancienne = e->taille;
+    if (n > ancienne && !accepter(C, n - ancienne)) return NULL;
+
+    e = (EnTete *)C->parent->reallouer(C->parent->ctx, e, sizeof(EnTete) + n);
+    if (!e) return NULL;
+
+    e->taille = n;
+    C->octets = C->octets - ancienne + n;
+    if (C->octets > C->pic) C->pic = C->octets;
+    return e + 1;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compteur_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise un allocateur comptable.
+ *
+ * Paramètres :
+ *  - C      : compteur
+ *  - parent : allocateur sous-jacent (NULL : allocateur système)
+ *  - limite : octets autorisés simultanément (0 : sans limite)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void compteur_init(CompteurAlloc *C, const Allocateur *parent, size_t limite) {
+    C->vtable.allouer = compteur_allouer;
+    C->vtable.reallouer = compteur_reallouer;
+    C->vtable.liberer = compteur_liberer;
+    C->vtable.echec = NULL;
+    C->vtable.ctx = C;
+    C->parent = parent ? parent : &allocateur_systeme;
+    C->octets = C->pic = 0;
+    C->limite = limite;
+    C->nb_allocations = C->nb_refus = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compteur_allocateur
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne l’allocateur à transmettre aux structures.
+ *
+ * Paramètres :
+ *  - C : compteur
+ *
+ * Valeur de retour :
+ *  - allocateur comptable (valide tant que C existe)
+ */
+const Allocateur *compteur_allocateur(CompteurAlloc *C) {
+    return &C->vtable;
+}
@@ -0,0 +1,52 @@
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Allocateur interchangeable : chaque structure (Liste, Regle, BC,
+ * BaseFaits, HashTable, BC compilée, session) retient l’allocateur
+ * reçu à l’initialisation et l’utilise pour toute sa mémoire.
+ * allouer et reallouer retournent NULL en cas d’échec ; echec
+ * (facultatif) est alors appelé avant l’arrêt du programme et peut
+ * en sortir par longjmp : la structure en cours de modification reste
+ * cohérente et libérable (seul le bloc en construction peut être perdu).
+ */
+typedef struct Allocateur {
+    void *(*allouer)(void *ctx, size_t n);
+    void *(*reallouer)(void *ctx, void *p, size_t n);
+    void (*liberer)(void *ctx, void *p);
+    void (*echec)(void *ctx, size_t n);
+    void *ctx;
+} Allocateur;
+
+/* malloc / realloc / free */
+extern const Allocateur allocateur_systeme;
+
+/* Ne retournent jamais NULL ; A == NULL désigne allocateur_systeme */
+void *mem_allouer(const Allocateur *A, size_t n);
+void *mem_allouer_zero(const Allocateur *A, size_t n);
+void *mem_reallouer(const Allocateur *A, void *p, size_t n);
+void mem_liberer(const Allocateur *A, void *p);
+char *mem_dupliquer(const Allocateur *A, const char *s);
+
+/*
+ * Allocateur comptable : compte les octets demandés au-dessus d’un
+ * allocateur parent et refuse toute allocation qui dépasserait la
+ * limite (0 = sans limite). Non partagé entre threads.
+ */
+typedef struct {
+    Allocateur vtable;       // à transmettre aux structures (echec modifiable)
+    const Allocateur *parent;
+    size_t octets;           // octets actuellement alloués
+    size_t pic;              // maximum atteint
+    size_t limite;
+    size_t nb_allocations;   // allocations vivantes
+    size_t nb_refus;         // allocations refusées par la limite
+} CompteurAlloc;
+
+void compteur_init(CompteurAlloc *C, const Allocateur *parent, size_t limite);
+const Allocateur *compteur_allocateur(CompteurAlloc *C);
+
+#endif
@@ -0,0 +1,856 @@
+/*
+ * LO21_bench : micro-benchmarks des primitives des ADT (liste,
+ * table de hachage, base de faits, symboles, base de connaissances,
+ * ensembles compressés, propagation sur règles longues, diagramme
+ * de décision, lots en tranches de bits).
+ *
+ * Usage : LO21_bench [--tailles 100,1000,10000] [--repetitions N]
+ *                    [--echauffement N] [--filtre texte] [--csv]
+ *
+ * Pour chaque cas et chaque taille : échauffement, puis N mesures
+ * dont on donne médiane, minimum, moyenne et écart-type en ns/op,
+ * ainsi que le nombre d’allocations par opération.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "list.h"
+#include "hash.h"
+#include "facts.h"
+#include "kb.h"
+#include "symbols.h"
+#include "ensemble.h"
+#include "veille.h"
+#include "diagramme.h"
+#include "lot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* ------------------------------------------------------------
+ * Comptage des allocations (édition de liens avec --wrap, voir
+ * CMakeLists.txt) : seuls les appels faits par le code du projet
+ * sont comptés.
+ * ------------------------------------------------------------ */
+static size_t nb_allocations = 0;
+
+#ifdef BENCH_COMPTER_ALLOCS
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t k, size_t n);
+void *__real_realloc(void *p, size_t n);
+
+void *__wrap_malloc(size_t n) {
+    nb_allocations++;
+    return __real_malloc(n);
+}
+
+void *__wrap_calloc(size_t k, size_t n) {
+    nb_allocations++;
+    return __real_calloc(k, n);
+}
+
+void *__wrap_realloc(void *p, size_t n) {
+    nb_allocations++;
+    return __real_realloc(p, n);
+}
+#endif
+
+/* Nombre maximal d’opérations pour les primitives en O(n) par appel */
+#define OPS_LINEAIRES 1000
+
+/* Au-delà, liste_contient_rec risque de dépasser la pile (récursion) */
+#define TAILLE_MAX_RECURSIVE 20000
+
+typedef struct {
+    double ns;        // durée de la section mesurée
+    size_t ops;       // opérations effectuées dans la section
+    size_t allocs;    // allocations dans la section
+    double extra;     // information propre au cas (ex. facteur de charge)
+} Mesure;
+
+typedef struct {
+    const char *nom;
+    const char *extra;                 // libellé de Mesure.extra (NULL si inutilisé)
+    size_t taille_max;                 // 0 : pas de limite
+    void (*executer)(size_t n, char **noms, Mesure *m);
+} CasBench;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : maintenant_ns
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit l’horloge monotone.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - temps courant en nanosecondes
+ */
+static double maintenant_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Début et fin de la section mesurée d’un cas */
+static double chrono_debut;
+static size_t allocs_debut;
+
+static void mesure_debut(void) {
+    allocs_debut = nb_allocations;
+    chrono_debut = maintenant_ns();
+}
+
+static void mesure_fin(Mesure *m, size_t ops) {
+    m->ns = maintenant_ns() - chrono_debut;
+    m->allocs = nb_allocations - allocs_debut;
+    m->ops = ops;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : aleatoire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Générateur pseudo-aléatoire déterministe (xorshift64) pour
+ *  choisir les clés recherchées.
+ *
+ * Paramètres :
+ *  - etat : état du générateur (mis à jour)
+ *
+ * Valeur de retour :
+ *  - nombre pseudo-aléatoire sur 64 bits
+ */
+static uint64_t aleatoire(uint64_t *etat) {
+    uint64_t x = *etat;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *etat = x;
+}
+
+/* ------------------------------------------------------------
+ * Cas mesurés : la préparation et le nettoyage sont hors
+ * section mesurée.
+ * ------------------------------------------------------------ */
+
+static void cas_liste_ajout(size_t n, char **noms, Mesure *m) {
+    Liste L;
+    liste_init(&L);
+    mesure_debut();
+    for (size_t i = 0; i < n; i++) liste_ajouter_en_queue(&L, noms[i]);
+    mesure_fin(m, n);
+    liste_vider(&L);
+}
+
+static void cas_liste_contient(size_t n, char **noms, Mesure *m) {
+    Liste L;
+    liste_init(&L);
+    for (size_t i = 0; i < n; i++) liste_ajouter_en_queue(&L, noms[i]);
+
+    uint64_t graine = 88172645463325252ull;
+    size_t trouves = 0;
+    mesure_debut();
+    for (size_t k = 0; k < OPS_LINEAIRES; k++) {
+        trouves += liste_contient_rec(&L, noms[aleatoire(&graine) % n]);
+    }
+    mesure_fin(m, OPS_LINEAIRES);
+    m->extra = (double)trouves / OPS_LINEAIRES;
+    liste_vider(&L);
+}
+
+static void cas_hash_insert(size_t n, char **noms, Mesure *m) {
+    HashTable ht;
+    hash_table_init(&ht);
+    mesure_debut();
+    for (size_t i = 0; i < n; i++) hash_table_insert(&ht, noms[i]);
+    mesure_fin(m, n);
+    m->extra = (double)ht.nb_elements / (double)ht.nb_alveoles;
+    hash_table_detruire(&ht);
+}
+
+static void cas_hash_contient(size_t n, char **noms, Mesure *m) {
+    HashTable ht;
+    hash_table_init(&ht);
+    for (size_t i = 0; i < n; i++) hash_table_insert(&ht, noms[i]);
+
+    uint64_t graine = 88172645463325252ull;
+    size_t trouves = 0;
+    mesure_debut();
+    for (size_t k = 0; k < n; k++) trouves += hash_table_contains(&ht, noms[aleatoire(&graine) % n]);
+    mesure_fin(m, n);
+    m->extra = (double)ht.nb_elements / (double)ht.nb_alveoles;
+    (void)trouves;
+    hash_table_detruire(&ht);
+}
+
+static void cas_hash_absent(size_t n, char **noms, Mesure *m) {
+    HashTable ht;
+    hash_table_init(&ht);
+    for (size_t i = 0; i < n / 2; i++) hash_table_insert(&ht, noms[i]);
+
+    // Recherche des noms de la seconde moitié, jamais insérés
+    mesure_debut();
+    size_t trouves = 0;
+    for (size_t k = n / 2; k < n; k++) trouves += hash_table_contains(&ht, noms[k]);
+    mesure_fin(m, n - n / 2);
+    m->extra = (double)ht.nb_elements / (double)ht.nb_alveoles;
+    (void)trouves;
+    hash_table_detruire(&ht);
+}
+
+static void cas_bf_contient(size_t n, char **noms, Mesure *m) {
+    BaseFaits BF;
+    bf_init(&BF);
+    for (size_t i = 0; i < n; i++) bf_ajouter(&BF, noms[i]);
+
+    uint64_t graine = 88172645463325252ull;
+    size_t trouves = 0;
+    mesure_debut();
+    for (size_t k = 0; k < n; k++) trouves += bf_contient(&BF, noms[aleatoire(&graine) % n]);
+    mesure_fin(m, n);
+    (void)trouves;
+    bf_detruire(&BF);
+}
+
+static void cas_bf_ajout(size_t n, char **noms, Mesure *m) {
+    BaseFaits BF;
+    bf_init(&BF);
+    mesure_debut();
+    for (size_t i = 0; i < n; i++) bf_ajouter(&BF, noms[i]);
+    mesure_fin(m, n);
+    bf_detruire(&BF);
+}
+
+static void cas_bf_lot(size_t n, char **noms, Mesure *m) {
+    BaseFaits BF;
+    bf_init(&BF);
+    mesure_debut();
+    bf_affirmer_lot(&BF, (const char *const *)noms, n);
+    mesure_fin(m, n);
+    bf_detruire(&BF);
+}
+
+/* Sessions sur une base partagée de n faits : copie complète ou couche */
+#define SESSIONS 64
+#define FAITS_SESSION 8
+
+static void cas_session_copie(size_t n, char **noms, Mesure *m) {
+    BaseFaits base, BF;
+    bf_init(&base);
+    bf_affirmer_lot(&base, (const char *const *)noms, n);
+
+    StatsFaits s;
+    mesure_debut();
+    for (size_t k = 0; k < SESSIONS; k++) {
+        bf_init(&BF);
+        bf_union(&BF, &base);
+        for (size_t i = 0; i < FAITS_SESSION; i++) bf_ajouter(&BF, "fait_de_session");
+        if (k == 0) bf_stats(&BF, &s);
+        bf_detruire(&BF);
+    }
+    mesure_fin(m, SESSIONS);
+    m->extra = (double)(s.octets_ordre + s.index.octets);
+    bf_detruire(&base);
+}
+
+static void cas_session_couche(size_t n, char **noms, Mesure *m) {
+    BaseFaits base, BF;
+    bf_init(&base);
+    bf_affirmer_lot(&base, (const char *const *)noms, n);
+
+    StatsFaits s;
+    mesure_debut();
+    for (size_t k = 0; k < SESSIONS; k++) {
+        bf_init_sur(&BF, &base, NULL);
+        for (size_t i = 0; i < FAITS_SESSION; i++) bf_ajouter(&BF, "fait_de_session");
+        if (k == 0) bf_stats(&BF, &s);
+        bf_detruire(&BF);
+    }
+    mesure_fin(m, SESSIONS);
+    m->extra = (double)(s.octets_ordre + s.index.octets);
+    bf_detruire(&base);
+}
+
+static void cas_symboles_chercher(size_t n, char **noms, Mesure *m) {
+    TableSymboles T;
+    symboles_init(&T);
+    for (size_t i = 0; i < n; i++) symboles_interner(&T, noms[i]);
+
+    uint64_t graine = 88172645463325252ull;
+    size_t trouves = 0;
+    mesure_debut();
+    for (size_t k = 0; k < n; k++) trouves += symboles_chercher(&T, noms[aleatoire(&graine) % n]) != PROP_AUCUNE;
+    mesure_fin(m, n);
+    (void)trouves;
+    symboles_detruire(&T);
+}
+
+/* Vocabulaire simulé des cas "ensemble_*" (identifiants tirés dans [0, VOCABULAIRE)) */
+#define VOCABULAIRE 100000000u
+
+static void cas_ensemble_ajout(size_t n, char **noms, Mesure *m) {
+    (void)noms;
+    EnsembleFaits E;
+    ensemble_init(&E);
+
+    uint64_t graine = 88172645463325252ull;
+    mesure_debut();
+    for (size_t i = 0; i < n; i++) ensemble_ajouter(&E, (PropId)(aleatoire(&graine) % VOCABULAIRE));
+    mesure_fin(m, n);
+    m->extra = (double)ensemble_octets(&E) / (double)n;
+    ensemble_detruire(&E);
+}
+
+static void cas_ensemble_contient_tous(size_t n, char **noms, Mesure *m) {
+    (void)noms;
+    EnsembleFaits E;
+    ensemble_init(&E);
+    PropId *ids = (PropId *)malloc(n * sizeof(PropId));
+    if (!ids) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+
+    uint64_t graine = 88172645463325252ull;
+    for (size_t i = 0; i < n; i++) {
+        ids[i] = (PropId)(aleatoire(&graine) % VOCABULAIRE);
+        ensemble_ajouter(&E, ids[i]);
+    }
+
+    // Règles à 4 prémisses, toutes présentes (pire cas : 4 tests par appel)
+    size_t vrais = 0;
+    mesure_debut();
+    for (size_t k = 0; k + 4 <= n; k += 4) vrais += ensemble_contient_tous(&E, ids + k, 4);
+    mesure_fin(m, n / 4);
+    (void)vrais;
+
+    free(ids);
+    ensemble_detruire(&E);
+}
+
+/* Prémisses par règle des cas "*_hypothese" */
+#define PREMISSES_LONGUES 128
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : preparer_longues
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Compile une BC de n / 8 règles à PREMISSES_LONGUES prémisses
+ *  (hors mesure) et sépare les noms en faits de base (affirmés)
+ *  et hypothèses (un nom sur 16, essayés un par un).
+ *
+ * Paramètres :
+ *  - n      : nombre de noms
+ *  - noms   : noms disponibles
+ *  - C      : BC compilée (à détruire par l’appelant)
+ *  - base   : reçoit les faits de base (n identifiants au plus)
+ *  - nb     : reçoit le nombre de faits de base
+ *  - hyps   : reçoit les hypothèses (n identifiants au plus)
+ *  - nb_hyp : reçoit le nombre d’hypothèses
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void preparer_longues(size_t n, char **noms, BCCompilee *C, PropId *base, size_t *nb,
+                             PropId *hyps, size_t *nb_hyp) {
+    BaseConnaissances BC;
+    bc_init(&BC);
+    size_t nb_regles = n / 8 ? n / 8 : 1;
+    for (size_t i = 0; i < nb_regles; i++) {
+        Regle R;
+        regle_init(&R);
+        for (size_t k = 0; k < PREMISSES_LONGUES; k++) regle_ajouter_premisse(&R, noms[(i * 7 + k) % n]);
+        regle_definir_conclusion(&R, noms[(i * 13 + 5) % n]);
+        bc_ajouter_regle_en_queue(&BC, &R);
+        regle_detruire(&R);
+    }
+    bcc_compiler(C, &BC);
+    bc_vider(&BC);
+
+    *nb = *nb_hyp = 0;
+    for (size_t i = 0; i < n; i++) {
+        PropId p = symboles_chercher(&C->symboles, noms[i]);
+        if (p == PROP_AUCUNE) continue;
+        if (i % 16 == 0) hyps[(*nb_hyp)++] = p;
+        else base[(*nb)++] = p;
+    }
+}
+
+static void cas_session_hypothese(size_t n, char **noms, Mesure *m) {
+    BCCompilee C;
+    PropId *base = (PropId *)malloc(2 * n * sizeof(PropId));
+    if (!base) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    size_t nb, nb_hyp;
+    preparer_longues(n, noms, &C, base, &nb, base + n, &nb_hyp);
+    Session S;
+    session_init(&S, &C);
+
+    // Chaque hypothèse : remise à zéro, faits de base, hypothèse, saturation
+    size_t ops = nb_hyp < OPS_LINEAIRES ? nb_hyp : OPS_LINEAIRES;
+    mesure_debut();
+    for (size_t k = 0; k < ops; k++) {
+        session_reinitialiser(&S);
+        session_affirmer_lot(&S, base, nb);
+        session_affirmer(&S, base[n + k]);
+        session_saturer(&S);
+    }
+    mesure_fin(m, ops);
+
+    session_detruire(&S);
+    bcc_detruire(&C);
+    free(base);
+}
+
+static void cas_veille_hypothese(size_t n, char **noms, Mesure *m) {
+    BCCompilee C;
+    PropId *base = (PropId *)malloc(2 * n * sizeof(PropId));
+    if (!base) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    size_t nb, nb_hyp;
+    preparer_longues(n, noms, &C, base, &nb, base + n, &nb_hyp);
+    SessionVeille V;
+    veille_init(&V, &C);
+    for (size_t i = 0; i < nb; i++) veille_affirmer(&V, base[i]);
+    veille_saturer(&V);
+    size_t niveau = veille_niveau(&V);
+
+    // Chaque hypothèse : affirmée, propagée, puis retirée par retour arrière
+    size_t ops = nb_hyp < OPS_LINEAIRES ? nb_hyp : OPS_LINEAIRES;
+    mesure_debut();
+    for (size_t k = 0; k < ops; k++) {
+        veille_affirmer(&V, base[n + k]);
+        veille_saturer(&V);
+        veille_revenir(&V, niveau);
+    }
+    mesure_fin(m, ops);
+    m->extra = (double)V.deplacements / (double)ops;
+
+    veille_detruire(&V);
+    bcc_detruire(&C);
+    free(base);
+}
+
+/* Entrées des cas "*_classification" (2^ENTREES_CLASSIF jeux possibles) */
+#define ENTREES_CLASSIF 10
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : preparer_classification
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Compile une BC de classification (hors mesure) : n règles à 2
+ *  ou 3 des ENTREES_CLASSIF premiers noms, chacune vers une
+ *  conclusion propre, et tire OPS_LINEAIRES jeux d’entrées.
+ *
+ * Paramètres :
+ *  - n     : nombre de noms (au moins ENTREES_CLASSIF + 1)
+ *  - noms  : noms disponibles
+ *  - C     : BC compilée (à détruire par l’appelant)
+ *  - jeux  : reçoit OPS_LINEAIRES masques d’entrées
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void preparer_classification(size_t n, char **noms, BCCompilee *C, uint32_t *jeux) {
+    BaseConnaissances BC;
+    bc_init(&BC);
+    for (size_t i = ENTREES_CLASSIF; i < n; i++) {
+        Regle R;
+        regle_init(&R);
+        for (size_t k = 0; k < 2 + i % 2; k++) regle_ajouter_premisse(&R, noms[(i * 7 + k * 3) % ENTREES_CLASSIF]);
+        regle_definir_conclusion(&R, noms[i]);
+        bc_ajouter_regle_en_queue(&BC, &R);
+        regle_detruire(&R);
+    }
+    bcc_compiler(C, &BC);
+    bc_vider(&BC);
+
+    uint64_t etat = 0x9E3779B97F4A7C15ull;
+    for (size_t k = 0; k < OPS_LINEAIRES; k++) jeux[k] = (uint32_t)(aleatoire(&etat) & ((1u << ENTREES_CLASSIF) - 1));
+}
+
+static void cas_session_classification(size_t n, char **noms, Mesure *m) {
+    BCCompilee C;
+    uint32_t jeux[OPS_LINEAIRES];
+    preparer_classification(n, noms, &C, jeux);
+    PropId entrees[ENTREES_CLASSIF];
+    for (size_t i = 0; i < ENTREES_CLASSIF; i++) entrees[i] = symboles_chercher(&C.symboles, noms[i]);
+    Session S;
+    session_init(&S, &C);
+
+    // Chaque requête : remise à zéro, entrées, saturation
+    size_t conclusions = 0;
+    mesure_debut();
+    for (size_t k = 0; k < OPS_LINEAIRES; k++) {
+        session_reinitialiser(&S);
+        for (size_t i = 0; i < ENTREES_CLASSIF; i++)
+            if (jeux[k] & (1u << i)) session_affirmer(&S, entrees[i]);
+        conclusions += session_saturer(&S);
+    }
+    mesure_fin(m, OPS_LINEAIRES);
+    m->extra = (double)conclusions / OPS_LINEAIRES;
+
+    session_detruire(&S);
+    bcc_detruire(&C);
+}
+
+static void cas_diagramme_classification(size_t n, char **noms, Mesure *m) {
+    BCCompilee C;
+    uint32_t jeux[OPS_LINEAIRES];
+    preparer_classification(n, noms, &C, jeux);
+    PropId entrees[ENTREES_CLASSIF];
+    for (size_t i = 0; i < ENTREES_CLASSIF; i++) entrees[i] = symboles_chercher(&C.symboles, noms[i]);
+    Diagramme D;
+    diagramme_compiler(&D, &C, (size_t)1 << 24);
+    uint8_t *vrai = (uint8_t *)calloc(bcc_nb_propositions(&C), 1);
+    if (!vrai) {
+        perror("calloc");
+        exit(EXIT_FAILURE);
+    }
+
+    // Chaque requête : entrées, puis un chemin jusqu’à la liste des conclusions
+    size_t conclusions = 0;
+    mesure_debut();
+    for (size_t k = 0; k < OPS_LINEAIRES; k++) {
+        for (size_t i = 0; i < ENTREES_CLASSIF; i++) vrai[entrees[i]] = (uint8_t)((jeux[k] >> i) & 1u);
+        const PropId *c;
+        conclusions += diagramme_evaluer(&D, vrai, &c);
+    }
+    mesure_fin(m, OPS_LINEAIRES);
+    m->extra = (double)conclusions / OPS_LINEAIRES;
+
+    free(vrai);
+    diagramme_detruire(&D);
+    bcc_detruire(&C);
+}
+
+static void cas_lot_classification(size_t n, char **noms, Mesure *m) {
+    BCCompilee C;
+    uint32_t jeux[OPS_LINEAIRES];
+    preparer_classification(n, noms, &C, jeux);
+    PropId entrees[ENTREES_CLASSIF];
+    for (size_t i = 0; i < ENTREES_CLASSIF; i++) entrees[i] = symboles_chercher(&C.symboles, noms[i]);
+    SessionLot L;
+    lot_init(&L, &C);
+
+    // Mêmes requêtes, LOT_TAILLE à la fois (ns et conclusions par requête)
+    size_t conclusions = 0;
+    mesure_debut();
+    for (size_t k = 0; k < OPS_LINEAIRES; k += LOT_TAILLE) {
+        lot_reinitialiser(&L);
+        for (size_t q = 0; q < LOT_TAILLE && k + q < OPS_LINEAIRES; q++)
+            for (size_t i = 0; i < ENTREES_CLASSIF; i++)
+                if (jeux[k + q] & (1u << i)) lot_affirmer(&L, q, entrees[i]);
+        conclusions += lot_saturer(&L);
+    }
+    mesure_fin(m, OPS_LINEAIRES);
+    m->extra = (double)conclusions / OPS_LINEAIRES;
+
+    lot_detruire(&L);
+    bcc_detruire(&C);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : remplir_bc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Construit une BC de n règles à 4 prémisses (hors mesure).
+ *
+ * Paramètres :
+ *  - BC   : base de connaissances initialisée
+ *  - n    : nombre de règles
+ *  - noms : noms disponibles (au moins n)
+ *  - ids  : identifiants des règles ajoutées (peut être NULL)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void remplir_bc(BaseConnaissances *BC, size_t n, char **noms, RegleId *ids) {
+    for (size_t i = 0; i < n; i++) {
+        Regle R;
+        regle_init(&R);
+        for (size_t k = 0; k < 4; k++) regle_ajouter_premisse(&R, noms[(i + k) % n]);
+        regle_definir_conclusion(&R, noms[(i + 4) % n]);
+        RegleId id = bc_ajouter_regle_en_queue(BC, &R);
+        if (ids) ids[i] = id;
+        regle_detruire(&R);
+    }
+}
+
+static void cas_bc_ajout(size_t n, char **noms, Mesure *m) {
+    Regle R;
+    regle_init(&R);
+    for (size_t k = 0; k < 4; k++) regle_ajouter_premisse(&R, noms[k % n]);
+    regle_definir_conclusion(&R, noms[0]);
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+    mesure_debut();
+    for (size_t i = 0; i < n; i++) bc_ajouter_regle_en_queue(&BC, &R);
+    mesure_fin(m, n);
+
+    bc_vider(&BC);
+    regle_detruire(&R);
+}
+
+static void cas_bc_supprimer_index(size_t n, char **noms, Mesure *m) {
+    BaseConnaissances BC;
+    bc_init(&BC);
+    remplir_bc(&BC, n, noms, NULL);
+
+    // Suppressions au milieu de la BC (pire cas moyen du parcours)
+    size_t ops = n < OPS_LINEAIRES ? n : OPS_LINEAIRES;
+    mesure_debut();
+    for (size_t k = 0; k < ops; k++) bc_supprimer_regle_index(&BC, BC.size / 2);
+    mesure_fin(m, ops);
+    bc_vider(&BC);
+}
+
+static void cas_bc_supprimer_id(size_t n, char **noms, Mesure *m) {
+    BaseConnaissances BC;
+    bc_init(&BC);
+    RegleId *ids = (RegleId *)malloc(n * sizeof(RegleId));
+    if (!ids) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    remplir_bc(&BC, n, noms, ids);
+
+    // Mêmes suppressions que cas_bc_supprimer_index, par identifiant
+    size_t ops = n < OPS_LINEAIRES ? n : OPS_LINEAIRES;
+    mesure_debut();
+    for (size_t k = 0; k < ops; k++) bc_supprimer_regle(&BC, ids[(n - ops) / 2 + k]);
+    mesure_fin(m, ops);
+
+    free(ids);
+    bc_vider(&BC);
+}
+
+static const CasBench CAS[] = {
+    {"liste_ajouter_en_queue", NULL, 0, cas_liste_ajout},
+    {"bf_ajouter", NULL, 0, cas_bf_ajout},
+    {"bf_affirmer_lot", NULL, 0, cas_bf_lot},
+    {"hash_table_insert", "charge", 0, cas_hash_insert},
+    {"liste_contient_rec", "trouves", TAILLE_MAX_RECURSIVE, cas_liste_contient},
+    {"hash_table_contains", "charge", 0, cas_hash_contient},
+    {"hash_table_contains(absent)", "charge", 0, cas_hash_absent},
+    {"bf_contient", NULL, 0, cas_bf_contient},
+    {"session_copie_bf", "octets/session", 0, cas_session_copie},
+    {"session_couche_bf", "octets/session", 0, cas_session_couche},
+    {"symboles_chercher", NULL, 0, cas_symboles_chercher},
+    {"ensemble_ajouter", "octets/fait", 0, cas_ensemble_ajout},
+    {"ensemble_contient_tous(4)", NULL, 0, cas_ensemble_contient_tous},
+    {"session_hypothese(128)", NULL, 0, cas_session_hypothese},
+    {"veille_hypothese(128)", "deplacements/op", 0, cas_veille_hypothese},
+    {"session_classification", "conclusions/op", 10000, cas_session_classification},
+    {"diagramme_classification", "conclusions/op", 10000, cas_diagramme_classification},
+    {"lot_classification", "conclusions/op", 10000, cas_lot_classification},
+    {"bc_ajouter_regle_en_queue", NULL, 0, cas_bc_ajout},
+    {"bc_supprimer_regle_index", NULL, 0, cas_bc_supprimer_index},
+    {"bc_supprimer_regle(id)", NULL, 0, cas_bc_supprimer_id},
+};
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : comparer_doubles
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Comparaison pour qsort (calcul de la médiane).
+ *
+ * Paramètres :
+ *  - a, b : pointeurs vers deux doubles
+ *
+ * Valeur de retour :
+ *  - -1, 0 ou 1
+ */
+static int comparer_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : executer_cas
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Mesure un cas pour une taille : échauffement, répétitions,
+ *  puis affichage des statistiques en ns/op et allocations/op.
+ *
+ * Paramètres :
+ *  - c            : cas à mesurer
+ *  - n            : taille
+ *  - noms         : n noms de propositions
+ *  - repetitions  : nombre de mesures retenues
+ *  - echauffement : nombre de mesures ignorées
+ *  - csv          : sortie au format CSV
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - ns_op : durée par opération de chaque répétition
+ */
+static void executer_cas(const CasBench *c, size_t n, char **noms,
+                         int repetitions, int echauffement, bool csv) {
+    Mesure m = {0};
+    for (int i = 0; i < echauffement; i++) c->executer(n, noms, &m);
+
+    double *ns_op = (double *)malloc((size_t)repetitions * sizeof(double));
+    if (!ns_op) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+
+    double somme = 0.0, allocs = 0.0, extra = 0.0;
+    for (int i = 0; i < repetitions; i++) {
+        memset(&m, 0, sizeof(m));
+        c->executer(n, noms, &m);
+        ns_op[i] = m.ns / (double)(m.ops ? m.ops : 1);
+        somme += ns_op[i];
+        allocs += (double)m.allocs / (double)(m.ops ? m.ops : 1);
+        extra += m.extra;
+    }
+
+    double moyenne = somme / repetitions;
+    double variance = 0.0;
+    for (int i = 0; i < repetitions; i++) variance += (ns_op[i] - moyenne) * (ns_op[i] - moyenne);
+    double ecart = repetitions > 1 ? sqrt(variance / (repetitions - 1)) : 0.0;
+
+    qsort(ns_op, (size_t)repetitions, sizeof(double), comparer_doubles);
+    double mediane = (repetitions % 2) ? ns_op[repetitions / 2]
+                                       : (ns_op[repetitions / 2 - 1] + ns_op[repetitions / 2]) / 2.0;
+
+#ifdef BENCH_COMPTER_ALLOCS
+    double allocs_op = allocs / repetitions;
+#else
+    double allocs_op = NAN;
+    (void)allocs;
+#endif
+
+    if (csv) {
+        printf("%s,%zu,%.2f,%.2f,%.2f,%.2f,%.3f,%s,%.3f\n", c->nom, n, mediane, ns_op[0],
+               moyenne, ecart, allocs_op, c->extra ? c->extra : "", extra / repetitions);
+    } else {
+        printf("%-30s %9zu %10.2f %10.2f %10.2f %9.2f %10.3f", c->nom, n, mediane, ns_op[0],
+               moyenne, ecart, allocs_op);
+        if (c->extra) printf("   %s=%.3f", c->extra, extra / repetitions);
+        printf("\n");
+    }
+    free(ns_op);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lire_tailles
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Analyse une liste de tailles séparées par des virgules.
+ *
+ * Paramètres :
+ *  - s      : texte à analyser
+ *  - tailles: tableau de sortie
+ *  - max    : capacité du tableau
+ *
+ * Valeur de retour :
+ *  - nombre de tailles lues (0 si le texte est invalide)
+ */
+static size_t lire_tailles(const char *s, size_t *tailles, size_t max) {
+    size_t nb = 0;
+    while (*s && nb < max) {
+        char *fin;
+        unsigned long long v = strtoull(s, &fin, 10);
+        if (fin == s || v == 0) return 0;
+        tailles[nb++] = (size_t)v;
+        s = (*fin == ',') ? fin + 1 : fin;
+        if (*fin != ',' && *fin != '\0') return 0;
+    }
+    return nb;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : main
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Analyse les options puis exécute tous les cas retenus pour
+ *  chaque taille de la série.
+ *
+ * Paramètres :
+ *  - argc, argv : options (voir en-tête du fichier)
+ *
+ * Valeur de retour :
+ *  - 0 en cas de succès, 1 si les options sont invalides
+ */
+int main(int argc, char **argv) {
+    size_t tailles[32] = {100, 1000, 10000, 100000};
+    size_t nb_tailles = 4;
+    int repetitions = 10, echauffement = 2;
+    const char *filtre = NULL;
+    bool csv = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tailles") == 0 && i + 1 < argc) {
+            nb_tailles = lire_tailles(argv[++i], tailles, 32);
+        } else if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+            repetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--echauffement") == 0 && i + 1 < argc) {
+            echauffement = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filtre") == 0 && i + 1 < argc) {
+            filtre = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            nb_tailles = 0;
+            break;
+        }
+    }
+    if (nb_tailles == 0 || repetitions < 1 || echauffement < 0) {
+        fprintf(stderr, "Usage : %s [--tailles 100,1000,...] [--repetitions N] "
+                        "[--echauffement N] [--filtre texte] [--csv]\n", argv[0]);
+        return 1;
+    }
+
+    if (csv) printf("cas,taille,mediane_ns_op,min_ns_op,moyenne_ns_op,ecart_ns_op,allocs_op,extra,valeur_extra\n");
+    else printf("%-30s %9s %10s %10s %10s %9s %10s\n", "cas", "taille", "med ns/op",
+                "min ns/op", "moy ns/op", "ecart", "allocs/op");
+
+    for (size_t t = 0; t < nb_tailles; t++) {
+        size_t n = tailles[t];
+
+        // Noms de propositions partagés par tous les cas
+        char **noms = (char **)malloc(n * sizeof(char *));
+        if (!noms) {
+            perror("malloc");
+            return 1;
+        }
+        for (size_t i = 0; i < n; i++) {
+            noms[i] = (char *)malloc(32);
+            if (!noms[i]) {
+                perror("malloc");
+                return 1;
+            }
+            snprintf(noms[i], 32, "proposition_%zu", i);
+        }
+
+        for (size_t c = 0; c < sizeof(CAS) / sizeof(CAS[0]); c++) {
+            if (filtre && !strstr(CAS[c].nom, filtre)) continue;
+            if (CAS[c].taille_max && n > CAS[c].taille_max) continue;
+            executer_cas(&CAS[c], n, noms, repetitions, echauffement, csv);
+        }
+
+        for (size_t i = 0; i < n; i++) free(noms[i]);
+        free(noms);
+    }
+    return 0;
+}
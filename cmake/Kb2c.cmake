@@ -0,0 +1,29 @@
+# kb2c_generer(<cible> <fichier.kb> <nom> [PROFIL <fichier>])
+#
+# Compile la base de connaissances <fichier.kb> en C avec l'outil kb2c
+# au moment de la construction et ajoute le fichier généré aux sources
+# de <cible>. La BC est ensuite accessible par
+#   BC_GENEREE_DECLARER(<nom>);  /* const BCGeneree <nom>_bc */
+# Avec PROFIL (fichier écrit par LO21 --profil), les prémisses sont
+# testées de la plus sélective à la moins sélective.
+function(kb2c_generer cible fichier_kb nom)
+    cmake_parse_arguments(KB2C "" "PROFIL" "" ${ARGN})
+    get_filename_component(entree ${fichier_kb} ABSOLUTE)
+    set(sortie ${CMAKE_CURRENT_BINARY_DIR}/${nom}_kb.c)
+    set(options_kb2c)
+    set(dependances kb2c ${entree})
+    if(KB2C_PROFIL)
+        get_filename_component(profil ${KB2C_PROFIL} ABSOLUTE)
+        set(options_kb2c --profil ${profil})
+        list(APPEND dependances ${profil})
+    endif()
+
+    add_custom_command(
+            OUTPUT ${sortie}
+            COMMAND kb2c ${options_kb2c} ${entree} ${sortie} ${nom}
+            DEPENDS ${dependances}
+            COMMENT "kb2c : ${fichier_kb} -> ${nom}_kb.c"
+            VERBATIM)
+
+    target_sources(${cible} PRIVATE ${sortie})
+endfunction()
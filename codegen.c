@@ -0,0 +1,91 @@
+#include "codegen.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcg_chercher
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retrouve l’identifiant d’une proposition dans une BC générée
+ *  par recherche dichotomique sur l’index trié par nom.
+ *
+ * Paramètres :
+ *  - G   : BC générée
+ *  - nom : texte de la proposition
+ *
+ * Valeur de retour :
+ *  - identifiant de la proposition
+ *  - UINT32_MAX si la BC ne la connaît pas
+ *
+ * Variables locales :
+ *  - bas, haut : bornes de la recherche
+ */
+uint32_t bcg_chercher(const BCGeneree *G, const char *nom) {
+    size_t bas = 0, haut = G->nb_propositions;
+
+    while (bas < haut) {
+        size_t milieu = bas + (haut - bas) / 2;
+        uint32_t id = G->index_tries[milieu];
+        int cmp = strcmp(G->noms[id], nom);
+
+        if (cmp == 0) return id;
+        if (cmp < 0) bas = milieu + 1;
+        else haut = milieu;
+    }
+    return UINT32_MAX;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : moteur_inference_generee
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Équivalent de moteur_inference pour une BC générée par kb2c :
+ *  les faits connus sont traduits en bits, le code généré calcule
+ *  la fermeture, puis les nouveaux faits sont ajoutés à la base
+ *  de faits.
+ *
+ * Paramètres :
+ *  - G  : BC générée
+ *  - BF : base de faits à enrichir
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - nb_mots : nombre de mots de 64 bits du tableau de faits
+ *  - faits   : bits des faits vrais
+ *  - avant   : bits des faits vrais avant l’inférence
+ */
+void moteur_inference_generee(const BCGeneree *G, BaseFaits *BF) {
+    size_t nb_mots = (G->nb_propositions + 63) / 64;
+    uint64_t *faits = (uint64_t *)mem_allouer_zero(BF->index.alloc, 2 * nb_mots * sizeof(uint64_t));
+    uint64_t *avant = faits + nb_mots;
+
+    // Traduction des faits connus en bits
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *s = bf_emplacement(BF, i);
+        if (!s) continue;
+
+        uint32_t id = bcg_chercher(G, s);
+        if (id != UINT32_MAX) faits[id / 64] |= UINT64_C(1) << (id % 64);
+    }
+    memcpy(avant, faits, nb_mots * sizeof(uint64_t));
+
+    // Fermeture calculée par le code généré
+    G->executer(faits);
+
+    // Report des nouveaux faits (kb2c numérote les conclusions dans l’ordre de déduction)
+    for (size_t id = 0; id < G->nb_propositions; id++) {
+        uint64_t bit = UINT64_C(1) << (id % 64);
+        if (!(faits[id / 64] & bit) || (avant[id / 64] & bit)) continue;
+
+        const char *c = G->noms[id];
+        if (bf_deduire(BF, c, BF_ORIGINE_INCONNUE)) printf(">> Nouvelle déduction : %s\n", c);
+    }
+
+    mem_liberer(BF->index.alloc, faits);
+    printf("Inférence terminée.\n");
+}
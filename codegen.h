@@ -0,0 +1,26 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "inference.h"
+
+/*
+ * BC compilée en C par kb2c : chaque règle devient un test de bits
+ * sur un tableau de mots de 64 bits (un bit par proposition).
+ */
+typedef struct {
+    const char *nom;
+    size_t nb_propositions;
+    const char *const *noms;       // identifiant -> nom
+    const uint32_t *index_tries;   // identifiants triés par nom (recherche dichotomique)
+    void (*executer)(uint64_t *faits);
+} BCGeneree;
+
+/* Déclare la BC générée par kb2c_generer(<cible> <fichier> nom) */
+#define BC_GENEREE_DECLARER(nom) extern const BCGeneree nom##_bc
+
+uint32_t bcg_chercher(const BCGeneree *G, const char *nom);
+void moteur_inference_generee(const BCGeneree *G, BaseFaits *BF);
+
+#endif
@@ -0,0 +1,730 @@
+#include "compile.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : construire_index
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Construit l’index proposition -> règles qui l’ont en prémisse
+ *  et l’index proposition -> règles qui la concluent (comptage
+ *  puis remplissage, les règles restent dans l’ordre de la BC).
+ *
+ * Paramètres :
+ *  - C   : BC compilée (règles et prémisses déjà rangées)
+ *  - pos : nombre total de prémisses
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void construire_index(BCCompilee *C, uint32_t pos) {
+    const Allocateur *A = C->symboles.alloc;
+    size_t np = symboles_taille(&C->symboles);
+    C->index_debut = (uint32_t *)mem_allouer_zero(A, (np + 1) * sizeof(uint32_t));
+    C->index_regles = (uint32_t *)mem_allouer(A, pos * sizeof(uint32_t));
+
+    for (uint32_t k = 0; k < pos; k++) C->index_debut[C->premisses[k] + 1]++;
+    for (size_t i = 0; i < np; i++) C->index_debut[i + 1] += C->index_debut[i];
+
+    uint32_t *remplis = (uint32_t *)mem_allouer_zero(A, (np + 1) * sizeof(uint32_t));
+    for (size_t ri = 0; ri < C->nb_regles; ri++) {
+        const RegleCompilee *r = &C->regles[ri];
+        for (uint32_t k = r->debut; k < r->debut + r->nb; k++) {
+            PropId p = C->premisses[k];
+            C->index_regles[C->index_debut[p] + remplis[p]++] = (uint32_t)ri;
+        }
+    }
+
+    C->prod_debut = (uint32_t *)mem_allouer_zero(A, (np + 1) * sizeof(uint32_t));
+    C->prod_regles = (uint32_t *)mem_allouer(A, (C->nb_regles ? C->nb_regles : 1) * sizeof(uint32_t));
+    for (size_t ri = 0; ri < C->nb_regles; ri++) C->prod_debut[C->regles[ri].conclusion + 1]++;
+    for (size_t i = 0; i < np; i++) C->prod_debut[i + 1] += C->prod_debut[i];
+    memset(remplis, 0, (np + 1) * sizeof(uint32_t));
+    for (size_t ri = 0; ri < C->nb_regles; ri++) {
+        PropId c = C->regles[ri].conclusion;
+        C->prod_regles[C->prod_debut[c] + remplis[c]++] = (uint32_t)ri;
+    }
+    mem_liberer(A, remplis);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_compiler
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Traduit la base de connaissances en une forme adaptée au
+ *  chaînage avant incrémental :
+ *   - chaque proposition reçoit un identifiant entier
+ *   - les prémisses de chaque règle sont dédoublonnées et
+ *     rangées dans un tableau unique
+ *   - un index associe à chaque proposition les règles qui
+ *     l’utilisent en prémisse, un autre celles qui la concluent
+ *   - chaque règle garde l’emplacement de sa règle source
+ *  Les règles sans conclusion sont ignorées. La mémoire est
+ *  fournie par l’allocateur de la BC source.
+ *
+ * Paramètres :
+ *  - C  : BC compilée à remplir (non initialisée)
+ *  - BC : base de connaissances source
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - total : nombre total de prémisses (borne supérieure)
+ *  - r     : règle compilée en cours de construction
+ *  - np    : nombre de propositions internées
+ */
+void bcc_compiler(BCCompilee *C, const BaseConnaissances *BC) {
+    TRACE_DEBUT("compilation");
+    const Allocateur *A = BC->alloc;
+    symboles_init_avec(&C->symboles, A);
+
+    // Dimensionnement des tableaux
+    size_t total = 0;
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        total += bc_regle(BC, id)->premisses.size;
+    }
+
+    C->regles = (RegleCompilee *)mem_allouer(A, BC->size * sizeof(RegleCompilee));
+    C->premisses = (PropId *)mem_allouer(A, total * sizeof(PropId));
+    C->emplacements = (uint32_t *)mem_allouer(A, BC->size * sizeof(uint32_t));
+    C->nb_regles = 0;
+
+    // Internement et copie des prémisses distinctes
+    uint32_t pos = 0;
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        const Regle *R = bc_regle(BC, id);
+        if (!R->conclusion) continue;
+
+        C->emplacements[C->nb_regles] = (uint32_t)id;
+        RegleCompilee *r = &C->regles[C->nb_regles++];
+        r->debut = pos;
+        r->nb = 0;
+        for (size_t i = 0; i < R->premisses.size; i++) {
+            PropId id = symboles_interner(&C->symboles, liste_element(&R->premisses, i));
+
+            bool doublon = false;
+            for (uint32_t k = r->debut; k < pos; k++) {
+                if (C->premisses[k] == id) doublon = true;
+            }
+            if (doublon) continue;
+
+            C->premisses[pos++] = id;
+            r->nb++;
+        }
+        r->conclusion = symboles_interner(&C->symboles, R->conclusion);
+    }
+
+    construire_index(C, pos);
+    TRACE_FIN("compilation");
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_nb_propositions
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique le nombre de propositions connues de la BC compilée.
+ *
+ * Paramètres :
+ *  - C : BC compilée
+ *
+ * Valeur de retour :
+ *  - nombre de propositions (identifiants 0 .. n-1)
+ */
+size_t bcc_nb_propositions(const BCCompilee *C) {
+    return symboles_taille(&C->symboles);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_atteignables
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Parcourt le graphe prémisses -> conclusions depuis les
+ *  propositions de base qui peuvent être affirmées : une règle
+ *  est atteignable quand toutes ses prémisses le sont (même
+ *  propagation par compteurs que session_saturer). Une règle non
+ *  atteignable ne peut se déclencher pour aucun sous-ensemble de
+ *  ces propositions.
+ *
+ * Paramètres :
+ *  - C      : BC compilée
+ *  - base   : propositions pouvant être affirmées
+ *  - n      : nombre de propositions de base
+ *  - regles : reçoit 1 / 0 par règle (nb_regles octets)
+ *
+ * Valeur de retour :
+ *  - nombre de règles atteignables
+ *
+ * Variables locales :
+ *  - atteinte : par proposition, déjà dans la file
+ *  - file     : propositions atteintes à propager
+ *  - manque   : par règle, prémisses non encore atteintes
+ */
+size_t bcc_atteignables(const BCCompilee *C, const PropId *base, size_t n, uint8_t *regles) {
+    const Allocateur *A = C->symboles.alloc;
+    size_t np = bcc_nb_propositions(C);
+    uint8_t *atteinte = (uint8_t *)mem_allouer_zero(A, np);
+    PropId *file = (PropId *)mem_allouer(A, np * sizeof(PropId));
+    uint32_t *manque = (uint32_t *)mem_allouer(A, C->nb_regles * sizeof(uint32_t));
+    size_t nb = 0, nb_regles = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (base[i] < np && !atteinte[base[i]]) {
+            atteinte[base[i]] = 1;
+            file[nb++] = base[i];
+        }
+    }
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        manque[r] = C->regles[r].nb;
+        regles[r] = 0;
+        if (manque[r] == 0) {
+            regles[r] = 1;
+            nb_regles++;
+            PropId c = C->regles[r].conclusion;
+            if (!atteinte[c]) {
+                atteinte[c] = 1;
+                file[nb++] = c;
+            }
+        }
+    }
+
+    for (size_t t = 0; t < nb; t++) {
+        PropId p = file[t];
+        for (uint32_t k = C->index_debut[p]; k < C->index_debut[p + 1]; k++) {
+            uint32_t r = C->index_regles[k];
+            if (--manque[r] > 0) continue;
+            regles[r] = 1;
+            nb_regles++;
+            PropId c = C->regles[r].conclusion;
+            if (!atteinte[c]) {
+                atteinte[c] = 1;
+                file[nb++] = c;
+            }
+        }
+    }
+
+    mem_liberer(A, manque);
+    mem_liberer(A, file);
+    mem_liberer(A, atteinte);
+    return nb_regles;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_elaguer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire de la BC compilée les règles qui ne peuvent pas se
+ *  déclencher à partir des propositions de base données (voir
+ *  bcc_atteignables), puis reconstruit les prémisses et l’index.
+ *  Les identifiants de propositions ne changent pas. Les sessions
+ *  sur cette BC doivent être créées après l’élagage.
+ *
+ * Paramètres :
+ *  - C    : BC compilée
+ *  - base : propositions pouvant être affirmées
+ *  - n    : nombre de propositions de base
+ *
+ * Valeur de retour :
+ *  - nombre de règles retirées
+ *
+ * Variables locales :
+ *  - garder : par règle, 1 si elle est atteignable
+ *  - pos    : prémisses conservées
+ */
+size_t bcc_elaguer(BCCompilee *C, const PropId *base, size_t n) {
+    TRACE_DEBUT("elagage");
+    const Allocateur *A = C->symboles.alloc;
+    uint8_t *garder = (uint8_t *)mem_allouer(A, C->nb_regles);
+    size_t gardees = bcc_atteignables(C, base, n, garder);
+    size_t retirees = C->nb_regles - gardees;
+
+    if (retirees > 0) {
+        // Compactage en place : règles et prémisses ne font que reculer
+        uint32_t pos = 0;
+        size_t nb = 0;
+        for (size_t r = 0; r < C->nb_regles; r++) {
+            if (!garder[r]) continue;
+            RegleCompilee R = C->regles[r];
+            memmove(C->premisses + pos, C->premisses + R.debut, R.nb * sizeof(PropId));
+            R.debut = pos;
+            pos += R.nb;
+            C->emplacements[nb] = C->emplacements[r];
+            C->regles[nb++] = R;
+        }
+        C->nb_regles = nb;
+
+        mem_liberer(A, C->index_debut);
+        mem_liberer(A, C->index_regles);
+        mem_liberer(A, C->prod_debut);
+        mem_liberer(A, C->prod_regles);
+        construire_index(C, pos);
+    }
+    mem_liberer(A, garder);
+    TRACE_FIN("elagage");
+    return retirees;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_producteurs
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne les règles qui concluent une proposition, dans l’ordre
+ *  de la BC.
+ *
+ * Paramètres :
+ *  - C      : BC compilée
+ *  - p      : proposition
+ *  - regles : reçoit le début des règles dans C->prod_regles
+ *
+ * Valeur de retour :
+ *  - nombre de règles (0 : proposition jamais conclue)
+ */
+uint32_t bcc_producteurs(const BCCompilee *C, PropId p, const uint32_t **regles) {
+    if (p >= bcc_nb_propositions(C)) {
+        *regles = C->prod_regles;
+        return 0;
+    }
+    *regles = C->prod_regles + C->prod_debut[p];
+    return C->prod_debut[p + 1] - C->prod_debut[p];
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_ordre_dependances
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Range les règles dans l’ordre des dépendances (algorithme de
+ *  Kahn sur les conclusions) : les règles d’une conclusion sont
+ *  groupées, dans l’ordre de la BC, et viennent après celles de
+ *  toutes les conclusions dont elles ont besoin en prémisse. Sans
+ *  cycle, un seul passage dans cet ordre atteint la fermeture.
+ *  Les règles prises dans un cycle (ou en aval d’un cycle) sont
+ *  ajoutées à la fin, dans l’ordre de la BC.
+ *
+ * Paramètres :
+ *  - C     : BC compilée
+ *  - ordre : reçoit les C->nb_regles règles ordonnées
+ *
+ * Valeur de retour :
+ *  - true si la BC est sans cycle
+ *
+ * Variables locales :
+ *  - attente : par proposition, prémisses conclues non rangées
+ *              (une par occurrence dans les règles qui la concluent)
+ *  - props   : conclusions rangées
+ */
+bool bcc_ordre_dependances(const BCCompilee *C, uint32_t *ordre) {
+    const Allocateur *A = C->symboles.alloc;
+    size_t np = bcc_nb_propositions(C);
+    const uint32_t *debut = C->prod_debut;
+
+    uint32_t *attente = (uint32_t *)mem_allouer_zero(A, (np ? np : 1) * sizeof(uint32_t));
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        const RegleCompilee *R = &C->regles[r];
+        for (uint32_t k = 0; k < R->nb; k++) {
+            PropId q = C->premisses[R->debut + k];
+            if (debut[q] != debut[q + 1]) attente[R->conclusion]++;
+        }
+    }
+
+    PropId *props = (PropId *)mem_allouer(A, (np ? np : 1) * sizeof(PropId));
+    size_t nb_props = 0, nb = 0;
+    for (PropId p = 0; p < np; p++)
+        if (debut[p] != debut[p + 1] && attente[p] == 0) props[nb_props++] = p;
+
+    // Chaque conclusion rangée libère les règles où elle est prémisse
+    for (size_t i = 0; i < nb_props; i++) {
+        PropId p = props[i];
+        for (uint32_t j = debut[p]; j < debut[p + 1]; j++) ordre[nb++] = C->prod_regles[j];
+        for (uint32_t k = C->index_debut[p]; k < C->index_debut[p + 1]; k++) {
+            PropId c = C->regles[C->index_regles[k]].conclusion;
+            if (--attente[c] == 0) props[nb_props++] = c;
+        }
+    }
+
+    bool sans_cycle = nb == C->nb_regles;
+    for (size_t r = 0; r < C->nb_regles && !sans_cycle; r++) {
+        if (attente[C->regles[r].conclusion] != 0) ordre[nb++] = (uint32_t)r;
+    }
+
+    mem_liberer(A, props);
+    mem_liberer(A, attente);
+    return sans_cycle;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bcc_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère toutes les ressources d’une BC compilée.
+ *
+ * Paramètres :
+ *  - C : BC compilée à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bcc_detruire(BCCompilee *C) {
+    const Allocateur *A = C->symboles.alloc;
+    mem_liberer(A, C->regles);
+    mem_liberer(A, C->premisses);
+    mem_liberer(A, C->index_debut);
+    mem_liberer(A, C->index_regles);
+    mem_liberer(A, C->prod_debut);
+    mem_liberer(A, C->prod_regles);
+    mem_liberer(A, C->emplacements);
+    symboles_detruire(&C->symboles);
+    C->regles = NULL;
+    C->premisses = NULL;
+    C->emplacements = NULL;
+    C->index_debut = C->index_regles = NULL;
+    C->prod_debut = C->prod_regles = NULL;
+    C->nb_regles = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Prépare une session de chaînage avant sur une BC compilée :
+ *  tous les tableaux sont alloués une fois pour toutes, aucune
+ *  allocation n’a lieu pendant l’inférence. La session utilise
+ *  l’allocateur de la BC compilée.
+ *
+ * Paramètres :
+ *  - S : session à initialiser
+ *  - C : BC compilée (doit survivre à la session)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void session_init(Session *S, const BCCompilee *C) {
+    session_init_avec(S, C, C->symboles.alloc);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Comme session_init, avec un allocateur propre à la session
+ *  (par exemple un compteur par client sur une BC partagée).
+ *
+ * Paramètres :
+ *  - S : session à initialiser
+ *  - C : BC compilée (doit survivre à la session)
+ *  - A : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - np : nombre de propositions
+ */
+void session_init_avec(Session *S, const BCCompilee *C, const Allocateur *A) {
+    size_t np = bcc_nb_propositions(C);
+
+    S->bc = C;
+    S->alloc = A ? A : &allocateur_systeme;
+    S->vrai = (uint8_t *)mem_allouer(S->alloc, np);
+    S->manquantes = (uint32_t *)mem_allouer(S->alloc, C->nb_regles * sizeof(uint32_t));
+    S->faits = (PropId *)mem_allouer(S->alloc, np * sizeof(PropId));
+    S->regle = NULL;
+
+    session_reinitialiser(S);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_affirmer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Rend une proposition vraie et la place dans l’agenda.
+ *  La propagation n’a lieu qu’à l’appel de session_saturer.
+ *
+ * Paramètres :
+ *  - S : session
+ *  - p : proposition affirmée
+ *
+ * Valeur de retour :
+ *  - true  : le fait est nouveau
+ *  - false : il était déjà vrai (ou l’identifiant est inconnu)
+ */
+bool session_affirmer(Session *S, PropId p) {
+    if (p >= bcc_nb_propositions(S->bc) || S->vrai[p]) return false;
+
+    S->vrai[p] = 1;
+    if (S->regle) S->regle[S->nb_faits] = SESSION_SANS_REGLE;
+    S->faits[S->nb_faits++] = p;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : deduire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Comme session_affirmer, pour la conclusion d’une règle : la
+ *  règle est notée si la provenance est activée.
+ *
+ * Paramètres :
+ *  - S : session
+ *  - r : règle compilée satisfaite
+ *
+ * Valeur de retour :
+ *  - true si la conclusion est nouvelle
+ */
+static bool deduire(Session *S, uint32_t r) {
+    if (!session_affirmer(S, S->bc->regles[r].conclusion)) return false;
+    if (S->regle) S->regle[S->nb_faits - 1] = r;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_affirmer_lot
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Affirme un tableau de propositions en une passe : les
+ *  doublons et identifiants inconnus sont écartés par le tableau
+ *  "vrai", les autres sont placés directement dans l’agenda.
+ *  La propagation n’a lieu qu’à l’appel de session_saturer.
+ *
+ * Paramètres :
+ *  - S   : session
+ *  - ids : propositions affirmées
+ *  - n   : nombre de propositions
+ *
+ * Valeur de retour :
+ *  - nombre de faits nouveaux
+ *
+ * Variables locales :
+ *  - np    : nombre de propositions de la BC
+ *  - vrai  : vérité par proposition
+ *  - faits : agenda
+ *  - nb    : taille de l’agenda
+ */
+size_t session_affirmer_lot(Session *S, const PropId *ids, size_t n) {
+    size_t np = bcc_nb_propositions(S->bc);
+    uint8_t *vrai = S->vrai;
+    PropId *faits = S->faits;
+    size_t nb = S->nb_faits;
+
+    for (size_t i = 0; i < n; i++) {
+        PropId p = ids[i];
+        if (p >= np || vrai[p]) continue;
+        vrai[p] = 1;
+        if (S->regle) S->regle[nb] = SESSION_SANS_REGLE;
+        faits[nb++] = p;
+    }
+
+    size_t nouveaux = nb - S->nb_faits;
+    S->nb_faits = nb;
+    return nouveaux;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_saturer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Propage les faits en attente dans l’agenda : chaque nouveau
+ *  fait décrémente le compteur des règles qui l’utilisent, et une
+ *  règle dont le compteur tombe à zéro affirme sa conclusion (et
+ *  se note comme sa règle si la provenance est activée).
+ *  Chaque règle est donc examinée une fois par prémisse devenue
+ *  vraie, au lieu d’un parcours complet de la BC par tour.
+ *
+ * Paramètres :
+ *  - S : session
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits pendant l’appel
+ *
+ * Variables locales :
+ *  - C      : BC compilée de la session
+ *  - deduits: compteur de nouveaux faits déduits
+ *  - p      : fait en cours de propagation
+ */
+size_t session_saturer(Session *S) {
+    const BCCompilee *C = S->bc;
+    size_t deduits = 0;
+
+    while (S->curseur < S->nb_faits) {
+        PropId p = S->faits[S->curseur++];
+
+        // Règles ayant p en prémisse
+        for (uint32_t k = C->index_debut[p]; k < C->index_debut[p + 1]; k++) {
+            uint32_t r = C->index_regles[k];
+            if (--S->manquantes[r] == 0 && deduire(S, r)) {
+                deduits++;
+            }
+        }
+    }
+    return deduits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_est_vrai
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si une proposition est vraie dans la session.
+ *
+ * Paramètres :
+ *  - S : session
+ *  - p : proposition testée
+ *
+ * Valeur de retour :
+ *  - true si le fait est connu (affirmé ou déduit)
+ */
+bool session_est_vrai(const Session *S, PropId p) {
+    return p < bcc_nb_propositions(S->bc) && S->vrai[p];
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_reinitialiser
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Remet la session dans son état initial : aucun fait vrai,
+ *  compteurs au nombre de prémisses. Les conclusions des règles
+ *  sans prémisse sont placées dans l’agenda.
+ *
+ * Paramètres :
+ *  - S : session
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void session_reinitialiser(Session *S) {
+    const BCCompilee *C = S->bc;
+
+    memset(S->vrai, 0, bcc_nb_propositions(C));
+    S->nb_faits = 0;
+    S->curseur = 0;
+
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        S->manquantes[r] = C->regles[r].nb;
+        if (C->regles[r].nb == 0) deduire(S, (uint32_t)r);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_restaurer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Remet la session dans l’état d’une saturation déjà faite :
+ *  les faits donnés sont vrais et considérés comme propagés, les
+ *  compteurs sont recalculés d’après eux seuls (une passe sur les
+ *  prémisses, sans propagation). Une seconde passe place dans
+ *  l’agenda la conclusion manquante de chaque règle satisfaite, si
+ *  bien qu’un état incomplet est achevé par session_saturer.
+ *
+ * Paramètres :
+ *  - S     : session
+ *  - faits : faits vrais (identifiants inconnus ignorés)
+ *  - n     : nombre de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - m : prémisses encore fausses de la règle courante (comptées
+ *        avant d’affirmer la moindre conclusion : une conclusion
+ *        placée dans l’agenda sera décomptée par session_saturer)
+ */
+void session_restaurer(Session *S, const PropId *faits, size_t n) {
+    const BCCompilee *C = S->bc;
+
+    memset(S->vrai, 0, bcc_nb_propositions(C));
+    S->nb_faits = 0;
+    session_affirmer_lot(S, faits, n);
+    S->curseur = S->nb_faits;
+
+    // Compteurs d’après les seuls faits donnés, avant tout ajout
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        const RegleCompilee *R = &C->regles[r];
+        uint32_t m = 0;
+        for (uint32_t k = 0; k < R->nb; k++) {
+            if (!S->vrai[C->premisses[R->debut + k]]) m++;
+        }
+        S->manquantes[r] = m;
+    }
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        if (S->manquantes[r] == 0) deduire(S, (uint32_t)r);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_activer_provenance
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Active l’enregistrement de la règle qui déduit chaque fait (un
+ *  tableau de 4 octets par fait, parallèle à l’agenda). Les faits
+ *  déjà présents sont sans règle, sauf les conclusions des règles
+ *  sans prémisse.
+ *
+ * Paramètres :
+ *  - S : session
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - np : nombre de propositions (taille maximale de l’agenda)
+ */
+void session_activer_provenance(Session *S) {
+    const BCCompilee *C = S->bc;
+    size_t np = bcc_nb_propositions(C);
+    if (S->regle) return;
+
+    S->regle = (uint32_t *)mem_allouer(S->alloc, (np ? np : 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < S->nb_faits; i++) S->regle[i] = SESSION_SANS_REGLE;
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        if (C->regles[r].nb != 0) continue;
+        for (size_t i = 0; i < S->nb_faits; i++) {
+            if (S->faits[i] != C->regles[r].conclusion) continue;
+            if (S->regle[i] == SESSION_SANS_REGLE) S->regle[i] = (uint32_t)r;
+            break;
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : session_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère les tableaux de la session (la BC compilée n’est pas
+ *  touchée).
+ *
+ * Paramètres :
+ *  - S : session à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void session_detruire(Session *S) {
+    mem_liberer(S->alloc, S->vrai);
+    mem_liberer(S->alloc, S->manquantes);
+    mem_liberer(S->alloc, S->faits);
+    mem_liberer(S->alloc, S->regle);
+    S->regle = NULL;
+    S->vrai = NULL;
+    S->manquantes = NULL;
+    S->faits = NULL;
+    S->nb_faits = S->curseur = 0;
+}
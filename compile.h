@@ -0,0 +1,64 @@
+#ifndef COMPILE_H
+#define COMPILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "kb.h"
+#include "symbols.h"
+
+/* Règle compilée : prémisses distinctes stockées de façon contiguë */
+typedef struct {
+    uint32_t debut;       // indice de la première prémisse dans BCCompilee.premisses
+    uint32_t nb;          // nombre de prémisses
+    PropId conclusion;
+} RegleCompilee;
+
+/* Toute la mémoire provient de l’allocateur de la BC source (symboles.alloc) */
+typedef struct {
+    TableSymboles symboles;
+    RegleCompilee *regles;
+    size_t nb_regles;
+    PropId *premisses;
+    uint32_t *index_debut;   // par proposition (+1) : début de ses règles dans index_regles
+    uint32_t *index_regles;  // règles ayant la proposition en prémisse
+    uint32_t *prod_debut;    // par proposition (+1) : début de ses règles dans prod_regles
+    uint32_t *prod_regles;   // règles qui concluent la proposition
+    uint32_t *emplacements;  // par règle : emplacement de la règle source dans la BC
+} BCCompilee;
+
+void bcc_compiler(BCCompilee *C, const BaseConnaissances *BC);
+size_t bcc_nb_propositions(const BCCompilee *C);
+size_t bcc_atteignables(const BCCompilee *C, const PropId *base, size_t n, uint8_t *regles);
+size_t bcc_elaguer(BCCompilee *C, const PropId *base, size_t n);
+uint32_t bcc_producteurs(const BCCompilee *C, PropId p, const uint32_t **regles);
+bool bcc_ordre_dependances(const BCCompilee *C, uint32_t *ordre);
+void bcc_detruire(BCCompilee *C);
+
+/* Règle d’un fait affirmé (ou d’un fait sans provenance enregistrée) */
+#define SESSION_SANS_REGLE UINT32_MAX
+
+/* Session : état de chaînage avant incrémental sur une BC compilée */
+typedef struct {
+    const BCCompilee *bc;
+    uint8_t *vrai;          // par proposition
+    uint32_t *manquantes;   // par règle : prémisses encore fausses
+    PropId *faits;          // faits vrais dans l’ordre d’arrivée (sert d’agenda)
+    size_t nb_faits;
+    size_t curseur;         // prochain fait de l’agenda à propager
+    uint32_t *regle;        // NULL, ou parallèle à faits : règle qui l’a déduit
+    const Allocateur *alloc;
+} Session;
+
+void session_init(Session *S, const BCCompilee *C);
+void session_init_avec(Session *S, const BCCompilee *C, const Allocateur *A);
+bool session_affirmer(Session *S, PropId p);
+size_t session_affirmer_lot(Session *S, const PropId *ids, size_t n);
+size_t session_saturer(Session *S);
+bool session_est_vrai(const Session *S, PropId p);
+void session_reinitialiser(Session *S);
+void session_restaurer(Session *S, const PropId *faits, size_t n);
+void session_activer_provenance(Session *S);
+void session_detruire(Session *S);
+
+#endif
@@ -0,0 +1,882 @@
+#include "datalog.h"
+#include "trace.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Variables d’une règle en cours de compilation (noms copiés) */
+typedef struct {
+    char *noms[DATALOG_MAX_VARIABLES];
+    uint32_t nb;
+} VariablesDL;
+
+/* État d’une jointure : règle, plan et liaisons courantes */
+typedef struct {
+    ProgrammeDatalog *P;
+    const RegleDL *R;
+    const PasDL *plan;
+    uint32_t delta;
+    uint32_t valeurs[DATALOG_MAX_VARIABLES];
+} Jointure;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : agrandir_tableau
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Garantit qu’un tableau dynamique peut contenir "besoin"
+ *  éléments (capacité doublée).
+ *
+ * Paramètres :
+ *  - A      : allocateur
+ *  - t      : tableau actuel (peut être NULL)
+ *  - cap    : capacité en éléments (mise à jour)
+ *  - besoin : nombre d’éléments requis
+ *  - taille : taille d’un élément en octets
+ *
+ * Valeur de retour :
+ *  - tableau (éventuellement déplacé)
+ */
+static void *agrandir_tableau(const Allocateur *A, void *t, size_t *cap, size_t besoin, size_t taille) {
+    if (besoin <= *cap && t) return t;
+
+    size_t n = *cap ? *cap : 16;
+    while (n < besoin) n *= 2;
+    t = mem_reallouer(A, t, n * taille);
+    *cap = n;
+    return t;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : melanger
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute une valeur à une empreinte de n-uplet.
+ *
+ * Paramètres :
+ *  - h : empreinte courante
+ *  - v : valeur ajoutée
+ *
+ * Valeur de retour :
+ *  - nouvelle empreinte
+ */
+static uint32_t melanger(uint32_t h, uint32_t v) {
+    h ^= v;
+    h *= 0x9E3779B1u;
+    return h ^ (h >> 15);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hacher_colonnes
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Empreinte des colonnes d’un n-uplet désignées par un masque.
+ *
+ * Paramètres :
+ *  - t      : n-uplet
+ *  - arite  : nombre de colonnes
+ *  - masque : colonnes prises en compte
+ *
+ * Valeur de retour :
+ *  - empreinte
+ */
+static uint32_t hacher_colonnes(const uint32_t *t, uint32_t arite, uint32_t masque) {
+    uint32_t h = 2166136261u;
+    for (uint32_t c = 0; c < arite; c++) {
+        if (masque & (1u << c)) h = melanger(h, t[c]);
+    }
+    return h;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tous_les_bits
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Masque couvrant toutes les colonnes d’une arité.
+ *
+ * Paramètres :
+ *  - arite : nombre de colonnes (<= DATALOG_MAX_ARITE)
+ *
+ * Valeur de retour :
+ *  - masque
+ */
+static uint32_t tous_les_bits(uint32_t arite) {
+    return arite >= 32 ? UINT32_MAX : (1u << arite) - 1;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : relation_ajouter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un n-uplet à une relation s’il est absent (table de
+ *  dédoublonnage à adressage ouvert, charge maximale 1/2).
+ *
+ * Paramètres :
+ *  - P : programme
+ *  - R : relation
+ *  - t : n-uplet (R->arite constantes)
+ *
+ * Valeur de retour :
+ *  - true  : le n-uplet est nouveau
+ *  - false : il était déjà présent
+ *
+ * Variables locales :
+ *  - taille : taille d’un n-uplet en octets
+ *  - i      : alvéole sondée
+ */
+static bool relation_ajouter(ProgrammeDatalog *P, RelationDL *R, const uint32_t *t) {
+    size_t taille = R->arite * sizeof(uint32_t);
+    size_t masque = R->nb_alveoles - 1;
+    size_t i = hacher_colonnes(t, R->arite, tous_les_bits(R->arite)) & masque;
+
+    while (R->ensemble[i] != 0) {
+        if (memcmp(R->tuples + (size_t)(R->ensemble[i] - 1) * R->arite, t, taille) == 0) return false;
+        i = (i + 1) & masque;
+    }
+
+    R->tuples = (uint32_t *)agrandir_tableau(P->alloc, R->tuples, &R->cap, R->nb + 1, taille);
+    memcpy(R->tuples + R->nb * R->arite, t, taille);
+    R->ensemble[i] = (uint32_t)++R->nb;
+
+    // Facteur de charge maximal : 1/2
+    if (2 * R->nb > R->nb_alveoles) {
+        mem_liberer(P->alloc, R->ensemble);
+        R->nb_alveoles *= 2;
+        R->ensemble = (uint32_t *)mem_allouer_zero(P->alloc, R->nb_alveoles * sizeof(uint32_t));
+        masque = R->nb_alveoles - 1;
+        for (size_t k = 0; k < R->nb; k++) {
+            size_t j = hacher_colonnes(R->tuples + k * R->arite, R->arite, tous_les_bits(R->arite)) & masque;
+            while (R->ensemble[j] != 0) j = (j + 1) & masque;
+            R->ensemble[j] = (uint32_t)k + 1;
+        }
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : index_mettre_a_jour
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute à un index les n-uplets [nb_indexes, R->courant). Les
+ *  alvéoles sont doublées (et l’index reconstruit) dès que leur
+ *  nombre devient inférieur au nombre de n-uplets.
+ *
+ * Paramètres :
+ *  - P : programme
+ *  - R : relation indexée
+ *  - I : index
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void index_mettre_a_jour(ProgrammeDatalog *P, RelationDL *R, IndexDL *I) {
+    if (R->courant > I->nb_alveoles) {
+        size_t n = I->nb_alveoles ? I->nb_alveoles : 16;
+        while (n < R->courant) n *= 2;
+        mem_liberer(P->alloc, I->tetes);
+        I->tetes = (uint32_t *)mem_allouer_zero(P->alloc, n * sizeof(uint32_t));
+        I->nb_alveoles = n;
+        I->nb_indexes = 0;
+    }
+    I->suivants = (uint32_t *)agrandir_tableau(P->alloc, I->suivants, &I->cap, R->courant, sizeof(uint32_t));
+
+    size_t masque = I->nb_alveoles - 1;
+    for (size_t t = I->nb_indexes; t < R->courant; t++) {
+        size_t a = hacher_colonnes(R->tuples + t * R->arite, R->arite, I->masque) & masque;
+        I->suivants[t] = I->tetes[a];
+        I->tetes[a] = (uint32_t)t + 1;
+    }
+    I->nb_indexes = R->courant;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : index_obtenir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne l’index d’une relation sur un ensemble de colonnes,
+ *  en le créant au besoin (à la compilation).
+ *
+ * Paramètres :
+ *  - P      : programme
+ *  - r      : relation
+ *  - masque : colonnes de la clé
+ *
+ * Valeur de retour :
+ *  - position de l’index dans la relation
+ */
+static uint32_t index_obtenir(ProgrammeDatalog *P, uint32_t r, uint32_t masque) {
+    RelationDL *R = &P->relations[r];
+
+    for (size_t k = 0; k < R->nb_index; k++) {
+        if (R->index[k].masque == masque) return (uint32_t)k;
+    }
+
+    R->index = (IndexDL *)mem_reallouer(P->alloc, R->index, (R->nb_index + 1) * sizeof(IndexDL));
+    IndexDL *I = &R->index[R->nb_index];
+    memset(I, 0, sizeof(*I));
+    I->masque = masque;
+    return (uint32_t)R->nb_index++;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : relation_obtenir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne la relation d’un prédicat (nom et arité), en la
+ *  créant si elle est nouvelle.
+ *
+ * Paramètres :
+ *  - P     : programme
+ *  - nom   : nom du prédicat
+ *  - arite : nombre d’arguments
+ *  - creer : false pour une simple recherche
+ *
+ * Valeur de retour :
+ *  - identifiant de la relation
+ *  - UINT32_MAX si elle est absente et creer vaut false
+ *
+ * Variables locales :
+ *  - cle : "nom/arite"
+ */
+static uint32_t relation_obtenir(ProgrammeDatalog *P, const char *nom, uint32_t arite, bool creer) {
+    size_t n = strlen(nom) + 16;
+    char *cle = (char *)mem_allouer(P->alloc, n);
+    snprintf(cle, n, "%s/%u", nom, arite);
+
+    PropId r = creer ? symboles_interner(&P->cles, cle) : symboles_chercher(&P->cles, cle);
+    mem_liberer(P->alloc, cle);
+    if (r == PROP_AUCUNE) return UINT32_MAX;
+
+    if (r == P->nb_relations) {
+        P->relations = (RelationDL *)agrandir_tableau(P->alloc, P->relations, &P->cap_relations,
+                                                      P->nb_relations + 1, sizeof(RelationDL));
+        RelationDL *R = &P->relations[P->nb_relations++];
+        memset(R, 0, sizeof(*R));
+        R->nom = symboles_interner(&P->predicats, nom);
+        R->arite = arite;
+        R->nb_alveoles = 16;
+        R->ensemble = (uint32_t *)mem_allouer_zero(P->alloc, R->nb_alveoles * sizeof(uint32_t));
+    }
+    return r;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : nettoyer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire les espaces de bord d’une chaîne modifiable.
+ *
+ * Paramètres :
+ *  - s : chaîne (modifiée sur place)
+ *
+ * Valeur de retour :
+ *  - début de la chaîne nettoyée
+ */
+static char *nettoyer(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    size_t n = strlen(s);
+    while (n > 0 && isspace((unsigned char)s[n - 1])) s[--n] = '\0';
+    return s;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : decouper_atome
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Découpe sur place un atome "nom(a, b)" ou "nom" en son nom et
+ *  ses arguments.
+ *
+ * Paramètres :
+ *  - texte : atome (modifié)
+ *  - nom   : reçoit le nom
+ *  - args  : reçoit les arguments (DATALOG_MAX_ARITE au plus)
+ *  - arite : reçoit le nombre d’arguments
+ *
+ * Valeur de retour :
+ *  - true  : atome bien formé
+ *  - false : parenthèses, arguments vides ou arité invalides
+ */
+static bool decouper_atome(char *texte, char **nom, char **args, uint32_t *arite) {
+    texte = nettoyer(texte);
+    *arite = 0;
+
+    char *ouvrante = strchr(texte, '(');
+    if (!ouvrante) {
+        *nom = texte;
+        return *texte != '\0' && !strchr(texte, ')') && !strchr(texte, ',');
+    }
+
+    size_t n = strlen(texte);
+    if (texte[n - 1] != ')') return false;
+    texte[n - 1] = '\0';
+    *ouvrante = '\0';
+    *nom = nettoyer(texte);
+    if (**nom == '\0') return false;
+
+    char *contenu = nettoyer(ouvrante + 1);
+    if (*contenu == '\0') return true;
+
+    for (char *arg = contenu; arg;) {
+        char *virgule = strchr(arg, ',');
+        if (virgule) *virgule = '\0';
+
+        char *a = nettoyer(arg);
+        if (*a == '\0' || strpbrk(a, "()") || *arite == DATALOG_MAX_ARITE) return false;
+        args[(*arite)++] = a;
+        arg = virgule ? virgule + 1 : NULL;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : est_variable
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si un argument est une variable (majuscule ou '_'
+ *  en tête, comme en Prolog).
+ *
+ * Paramètres :
+ *  - arg : argument
+ *
+ * Valeur de retour :
+ *  - true pour une variable
+ */
+static bool est_variable(const char *arg) {
+    return (*arg >= 'A' && *arg <= 'Z') || *arg == '_';
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compiler_atome
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Traduit un atome texte en relation + termes, en numérotant
+ *  les variables de la règle.
+ *
+ * Paramètres :
+ *  - P     : programme
+ *  - texte : atome
+ *  - V     : variables de la règle (complétées)
+ *  - out   : atome compilé
+ *  - vars  : reçoit les variables de l’atome (bit v)
+ *
+ * Valeur de retour :
+ *  - true  : atome valide
+ *  - false : atome mal formé ou trop de variables
+ *
+ * Variables locales :
+ *  - copie : copie modifiable de l’atome
+ */
+static bool compiler_atome(ProgrammeDatalog *P, const char *texte, VariablesDL *V, AtomeDL *out, uint64_t *vars) {
+    char *copie = mem_dupliquer(P->alloc, texte);
+    char *nom, *args[DATALOG_MAX_ARITE];
+    uint32_t arite;
+    bool ok = decouper_atome(copie, &nom, args, &arite);
+
+    *vars = 0;
+    if (ok) {
+        out->relation = relation_obtenir(P, nom, arite, true);
+        out->premier = (uint32_t)P->nb_termes;
+        P->termes = (int32_t *)agrandir_tableau(P->alloc, P->termes, &P->cap_termes,
+                                                P->nb_termes + arite, sizeof(int32_t));
+
+        for (uint32_t c = 0; c < arite && ok; c++) {
+            if (!est_variable(args[c])) {
+                P->termes[P->nb_termes++] = (int32_t)symboles_interner(&P->constantes, args[c]);
+                continue;
+            }
+
+            uint32_t v = 0;
+            while (v < V->nb && strcmp(V->noms[v], args[c]) != 0) v++;
+            if (v == V->nb) {
+                if (V->nb == DATALOG_MAX_VARIABLES) {
+                    ok = false;
+                    break;
+                }
+                V->noms[V->nb++] = mem_dupliquer(P->alloc, args[c]);
+            }
+            P->termes[P->nb_termes++] = -(int32_t)v - 1;
+            *vars |= UINT64_C(1) << v;
+        }
+    }
+
+    mem_liberer(P->alloc, copie);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : planifier
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Construit les plans de jointure d’une règle : pour chaque
+ *  atome delta i, l’atome i est parcouru en premier, puis les
+ *  autres dans l’ordre du corps ; chaque étape utilise l’index
+ *  des colonnes déjà liées (constantes ou variables liées).
+ *
+ * Paramètres :
+ *  - P : programme
+ *  - R : règle (corps déjà compilé)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void planifier(ProgrammeDatalog *P, RegleDL *R) {
+    uint32_t k = R->nb_corps;
+    R->premier_pas = (uint32_t)P->nb_pas;
+    P->pas = (PasDL *)agrandir_tableau(P->alloc, P->pas, &P->cap_pas, P->nb_pas + (size_t)k * k, sizeof(PasDL));
+
+    for (uint32_t i = 0; i < k; i++) {
+        uint64_t lies = 0;
+        for (uint32_t s = 0; s < k; s++) {
+            uint32_t j = s == 0 ? i : (s <= i ? s - 1 : s);
+            const AtomeDL *A = &P->atomes[R->premier_atome + j];
+            const int32_t *termes = P->termes + A->premier;
+            uint32_t arite = P->relations[A->relation].arite;
+
+            uint32_t masque = 0;
+            for (uint32_t c = 0; c < arite; c++) {
+                if (termes[c] >= 0 || (lies & (UINT64_C(1) << (-termes[c] - 1)))) masque |= 1u << c;
+            }
+            for (uint32_t c = 0; c < arite; c++) {
+                if (termes[c] < 0) lies |= UINT64_C(1) << (-termes[c] - 1);
+            }
+
+            PasDL *pas = &P->pas[P->nb_pas++];
+            pas->atome = j;
+            pas->index = masque ? index_obtenir(P, A->relation, masque) : UINT32_MAX;
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : datalog_compiler
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Traduit les règles d’une BC (prémisses et conclusion lues
+ *  comme des atomes) en programme Datalog. Chaque variable de la
+ *  conclusion doit apparaître dans une prémisse. Les règles sans
+ *  conclusion sont ignorées. La mémoire provient de l’allocateur
+ *  de la BC.
+ *
+ * Paramètres :
+ *  - P  : programme à remplir (non initialisé)
+ *  - BC : base de connaissances source
+ *
+ * Valeur de retour :
+ *  - true  : programme prêt
+ *  - false : règle invalide (message sur stderr, P est libéré)
+ *
+ * Variables locales :
+ *  - V      : variables de la règle courante
+ *  - numero : position de la règle (pour les messages)
+ *  - corps  : variables liées par les prémisses
+ */
+bool datalog_compiler(ProgrammeDatalog *P, const BaseConnaissances *BC) {
+    memset(P, 0, sizeof(*P));
+    P->alloc = BC->alloc;
+    symboles_init_avec(&P->constantes, P->alloc);
+    symboles_init_avec(&P->predicats, P->alloc);
+    symboles_init_avec(&P->cles, P->alloc);
+
+    size_t numero = 0;
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        const Regle *src = bc_regle(BC, id);
+        numero++;
+        if (!src->conclusion) continue;
+
+        VariablesDL V = {{NULL}, 0};
+        P->regles = (RegleDL *)agrandir_tableau(P->alloc, P->regles, &P->cap_regles,
+                                                P->nb_regles + 1, sizeof(RegleDL));
+        RegleDL *R = &P->regles[P->nb_regles];
+        R->premier_atome = (uint32_t)P->nb_atomes;
+        R->nb_corps = (uint32_t)src->premisses.size;
+
+        // Corps puis tête (les variables de la tête doivent être liées)
+        bool ok = true;
+        uint64_t corps = 0, vars;
+        P->atomes = (AtomeDL *)agrandir_tableau(P->alloc, P->atomes, &P->cap_atomes,
+                                                P->nb_atomes + R->nb_corps, sizeof(AtomeDL));
+        for (size_t i = 0; i < src->premisses.size && ok; i++) {
+            ok = compiler_atome(P, liste_element(&src->premisses, i), &V, &P->atomes[P->nb_atomes++], &vars);
+            corps |= vars;
+        }
+        if (ok) ok = compiler_atome(P, src->conclusion, &V, &R->tete, &vars);
+
+        R->nb_variables = V.nb;
+        for (uint32_t v = 0; v < V.nb; v++) mem_liberer(P->alloc, V.noms[v]);
+
+        if (!ok) {
+            fprintf(stderr, "Règle %zu : atome invalide (attendu : nom ou nom(a, X, ...)).\n", numero);
+            datalog_detruire(P);
+            return false;
+        }
+        if (vars & ~corps) {
+            fprintf(stderr, "Règle %zu : variable de la conclusion absente des prémisses.\n", numero);
+            datalog_detruire(P);
+            return false;
+        }
+
+        planifier(P, R);
+        P->nb_regles++;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : produire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Instancie la conclusion d’une règle avec les liaisons
+ *  courantes et l’ajoute à sa relation ; un n-uplet nouveau est
+ *  inscrit au journal des déductions.
+ *
+ * Paramètres :
+ *  - P       : programme
+ *  - tete    : conclusion
+ *  - valeurs : liaisons des variables
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void produire(ProgrammeDatalog *P, const AtomeDL *tete, const uint32_t *valeurs) {
+    RelationDL *R = &P->relations[tete->relation];
+    const int32_t *termes = P->termes + tete->premier;
+    uint32_t t[DATALOG_MAX_ARITE];
+
+    for (uint32_t c = 0; c < R->arite; c++) {
+        t[c] = termes[c] >= 0 ? (uint32_t)termes[c] : valeurs[-termes[c] - 1];
+    }
+    if (!relation_ajouter(P, R, t)) return;
+
+    P->journal = (uint64_t *)agrandir_tableau(P->alloc, P->journal, &P->cap_journal,
+                                              P->nb_journal + 1, sizeof(uint64_t));
+    P->journal[P->nb_journal++] = ((uint64_t)tete->relation << 32) | (uint32_t)(R->nb - 1);
+}
+
+static void joindre(Jointure *J, uint32_t s, uint64_t lies);
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : essayer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Confronte un n-uplet à l’atome de l’étape s : constantes et
+ *  variables liées doivent correspondre, les autres variables
+ *  sont liées ; la jointure continue à l’étape suivante.
+ *
+ * Paramètres :
+ *  - J      : jointure
+ *  - s      : étape
+ *  - lies   : variables liées avant l’étape
+ *  - R      : relation de l’atome
+ *  - termes : termes de l’atome
+ *  - t      : n-uplet candidat
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void essayer(Jointure *J, uint32_t s, uint64_t lies, const RelationDL *R, const int32_t *termes, size_t t) {
+    const uint32_t *u = R->tuples + t * R->arite;
+
+    for (uint32_t c = 0; c < R->arite; c++) {
+        if (termes[c] >= 0) {
+            if (u[c] != (uint32_t)termes[c]) return;
+            continue;
+        }
+        uint32_t v = (uint32_t)(-termes[c] - 1);
+        if (lies & (UINT64_C(1) << v)) {
+            if (J->valeurs[v] != u[c]) return;
+        } else {
+            J->valeurs[v] = u[c];
+            lies |= UINT64_C(1) << v;
+        }
+    }
+    joindre(J, s + 1, lies);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : joindre
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Étape s de la jointure semi-naïve. Pour l’atome delta, seuls
+ *  les n-uplets de l’itération précédente sont parcourus ; les
+ *  atomes situés avant lui dans le corps ne voient que les
+ *  n-uplets plus anciens, ceux situés après voient tout (chaque
+ *  déduction n’est ainsi produite qu’une fois par itération).
+ *  Les colonnes liées sont cherchées dans l’index haché.
+ *
+ * Paramètres :
+ *  - J    : jointure
+ *  - s    : étape du plan
+ *  - lies : variables liées
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - debut, fin : n-uplets visibles [debut, fin)
+ */
+static void joindre(Jointure *J, uint32_t s, uint64_t lies) {
+    ProgrammeDatalog *P = J->P;
+    if (s == J->R->nb_corps) {
+        produire(P, &J->R->tete, J->valeurs);
+        return;
+    }
+
+    const PasDL *pas = &J->plan[s];
+    const AtomeDL *A = &P->atomes[J->R->premier_atome + pas->atome];
+    const RelationDL *R = &P->relations[A->relation];
+    const int32_t *termes = P->termes + A->premier;
+
+    size_t debut = pas->atome == J->delta ? R->ancien : 0;
+    size_t fin = pas->atome < J->delta ? R->ancien : R->courant;
+    if (debut >= fin) return;
+
+    if (pas->index == UINT32_MAX) {
+        for (size_t t = debut; t < fin; t++) essayer(J, s, lies, R, termes, t);
+        return;
+    }
+
+    // Clé : valeurs des colonnes liées
+    const IndexDL *I = &R->index[pas->index];
+    uint32_t cle[DATALOG_MAX_ARITE];
+    for (uint32_t c = 0; c < R->arite; c++) {
+        if (!(I->masque & (1u << c))) continue;
+        cle[c] = termes[c] >= 0 ? (uint32_t)termes[c] : J->valeurs[-termes[c] - 1];
+    }
+    size_t a = hacher_colonnes(cle, R->arite, I->masque) & (I->nb_alveoles - 1);
+
+    // Chaîne du plus récent au plus ancien n-uplet
+    for (uint32_t e = I->tetes[a]; e != 0; e = I->suivants[e - 1]) {
+        size_t t = e - 1;
+        if (t >= fin) continue;
+        if (t < debut) break;
+        essayer(J, s, lies, R, termes, t);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : charger_fait
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un fait de la base de faits à sa relation s’il a la
+ *  forme d’un atome clos d’un prédicat du programme.
+ *
+ * Paramètres :
+ *  - P      : programme
+ *  - fait   : texte du fait
+ *  - tampon : tampon de travail (agrandi au besoin)
+ *  - cap    : capacité du tampon
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void charger_fait(ProgrammeDatalog *P, const char *fait, char **tampon, size_t *cap) {
+    size_t n = strlen(fait) + 1;
+    *tampon = (char *)agrandir_tableau(P->alloc, *tampon, cap, n, 1);
+    memcpy(*tampon, fait, n);
+
+    char *nom, *args[DATALOG_MAX_ARITE];
+    uint32_t arite;
+    if (!decouper_atome(*tampon, &nom, args, &arite)) return;
+
+    uint32_t r = relation_obtenir(P, nom, arite, false);
+    if (r == UINT32_MAX) return;
+
+    uint32_t t[DATALOG_MAX_ARITE];
+    for (uint32_t c = 0; c < arite; c++) t[c] = symboles_interner(&P->constantes, args[c]);
+    relation_ajouter(P, &P->relations[r], t);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : formater
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit un n-uplet sous la forme "nom(a,b)" (ou "nom").
+ *
+ * Paramètres :
+ *  - P      : programme
+ *  - r      : relation
+ *  - t      : position du n-uplet
+ *  - tampon : tampon de sortie (agrandi au besoin)
+ *  - cap    : capacité du tampon
+ *
+ * Valeur de retour :
+ *  - texte du fait (dans le tampon)
+ */
+static const char *formater(ProgrammeDatalog *P, uint32_t r, size_t t, char **tampon, size_t *cap) {
+    const RelationDL *R = &P->relations[r];
+    const uint32_t *u = R->tuples + t * R->arite;
+    const char *nom = symboles_nom(&P->predicats, R->nom);
+
+    size_t n = strlen(nom) + 3;
+    for (uint32_t c = 0; c < R->arite; c++) n += strlen(symboles_nom(&P->constantes, u[c])) + 1;
+    *tampon = (char *)agrandir_tableau(P->alloc, *tampon, cap, n, 1);
+
+    char *p = *tampon;
+    p += sprintf(p, "%s", nom);
+    for (uint32_t c = 0; c < R->arite; c++) {
+        p += sprintf(p, "%c%s", c == 0 ? '(' : ',', symboles_nom(&P->constantes, u[c]));
+    }
+    if (R->arite) strcpy(p, ")");
+    return *tampon;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : datalog_evaluer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule la fermeture du programme sur les faits de BF par
+ *  évaluation semi-naïve, puis ajoute à BF les faits déduits
+ *  dans leur ordre de déduction. Les faits de BF qui ne sont pas
+ *  des atomes d’un prédicat du programme sont ignorés.
+ *
+ * Paramètres :
+ *  - P  : programme compilé
+ *  - BF : base de faits enrichie
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits
+ *
+ * Variables locales :
+ *  - tampon  : texte de travail (lecture et écriture des faits)
+ *  - nouveau : une relation a reçu des n-uplets à l’itération
+ */
+size_t datalog_evaluer(ProgrammeDatalog *P, BaseFaits *BF) {
+    TRACE_DEBUT("datalog");
+    char *tampon = NULL;
+    size_t cap = 0;
+
+    // Remise à zéro des relations
+    for (size_t r = 0; r < P->nb_relations; r++) {
+        RelationDL *R = &P->relations[r];
+        R->nb = 0;
+        memset(R->ensemble, 0, R->nb_alveoles * sizeof(uint32_t));
+        for (size_t k = 0; k < R->nb_index; k++) {
+            IndexDL *I = &R->index[k];
+            if (I->tetes) memset(I->tetes, 0, I->nb_alveoles * sizeof(uint32_t));
+            I->nb_indexes = 0;
+        }
+    }
+    P->nb_journal = 0;
+    P->iterations = 0;
+
+    // Faits initiaux et règles sans prémisse
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *fait = bf_emplacement(BF, i);
+        if (fait) charger_fait(P, fait, &tampon, &cap);
+    }
+    for (size_t k = 0; k < P->nb_regles; k++) {
+        if (P->regles[k].nb_corps == 0) produire(P, &P->regles[k].tete, NULL);
+    }
+    for (size_t r = 0; r < P->nb_relations; r++) {
+        P->relations[r].ancien = 0;
+        P->relations[r].courant = P->relations[r].nb;
+    }
+
+    // Itérations semi-naïves jusqu’à ce qu’aucun delta ne soit produit
+    bool nouveau = true;
+    while (nouveau) {
+        P->iterations++;
+        TRACE_DEBUT("iteration_datalog");
+
+        for (size_t r = 0; r < P->nb_relations; r++) {
+            RelationDL *R = &P->relations[r];
+            for (size_t k = 0; k < R->nb_index; k++) index_mettre_a_jour(P, R, &R->index[k]);
+        }
+
+        for (size_t k = 0; k < P->nb_regles; k++) {
+            const RegleDL *regle = &P->regles[k];
+            for (uint32_t i = 0; i < regle->nb_corps; i++) {
+                const RelationDL *D = &P->relations[P->atomes[regle->premier_atome + i].relation];
+                if (D->ancien == D->courant) continue;
+
+                Jointure J;
+                J.P = P;
+                J.R = regle;
+                J.plan = &P->pas[regle->premier_pas + (size_t)i * regle->nb_corps];
+                J.delta = i;
+                joindre(&J, 0, 0);
+            }
+        }
+
+        nouveau = false;
+        for (size_t r = 0; r < P->nb_relations; r++) {
+            RelationDL *R = &P->relations[r];
+            R->ancien = R->courant;
+            R->courant = R->nb;
+            if (R->ancien != R->courant) nouveau = true;
+        }
+        TRACE_FIN("iteration_datalog");
+    }
+
+    // Report des déductions dans la base de faits
+    size_t deduits = 0;
+    bf_reserver(BF, P->nb_journal);
+    for (size_t k = 0; k < P->nb_journal; k++) {
+        uint32_t r = (uint32_t)(P->journal[k] >> 32);
+        size_t t = (size_t)(P->journal[k] & 0xffffffffu);
+        if (bf_deduire(BF, formater(P, r, t, &tampon, &cap), BF_ORIGINE_INCONNUE)) deduits++;
+    }
+
+    mem_liberer(P->alloc, tampon);
+    TRACE_FIN("datalog");
+    return deduits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : datalog_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère toutes les ressources d’un programme Datalog.
+ *
+ * Paramètres :
+ *  - P : programme
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void datalog_detruire(ProgrammeDatalog *P) {
+    const Allocateur *A = P->alloc;
+
+    for (size_t r = 0; r < P->nb_relations; r++) {
+        RelationDL *R = &P->relations[r];
+        for (size_t k = 0; k < R->nb_index; k++) {
+            mem_liberer(A, R->index[k].tetes);
+            mem_liberer(A, R->index[k].suivants);
+        }
+        mem_liberer(A, R->index);
+        mem_liberer(A, R->tuples);
+        mem_liberer(A, R->ensemble);
+    }
+    mem_liberer(A, P->relations);
+    mem_liberer(A, P->termes);
+    mem_liberer(A, P->atomes);
+    mem_liberer(A, P->regles);
+    mem_liberer(A, P->pas);
+    mem_liberer(A, P->journal);
+    symboles_detruire(&P->constantes);
+    symboles_detruire(&P->predicats);
+    symboles_detruire(&P->cles);
+    memset(P, 0, sizeof(*P));
+    P->alloc = A;
+}
@@ -0,0 +1,93 @@
+#ifndef DATALOG_H
+#define DATALOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "alloc.h"
+#include "facts.h"
+#include "kb.h"
+#include "symbols.h"
+
+/*
+ * Règles à variables sur des faits n-uplets, par exemple
+ *   panne(V) AND phares(V) => starter(V)
+ * Un argument commençant par une majuscule (ou '_') est une variable,
+ * les autres sont des constantes ; un atome sans parenthèses est un
+ * prédicat d’arité 0 (les BC propositionnelles restent valides).
+ * Évaluation semi-naïve : à chaque itération, chaque règle n’est
+ * jointe qu’avec les n-uplets nouveaux (delta) d’un de ses atomes,
+ * via des index hachés sur les colonnes déjà liées.
+ */
+
+/* Nombre maximal de variables par règle et d’arguments par atome */
+#define DATALOG_MAX_VARIABLES 64
+#define DATALOG_MAX_ARITE 32
+
+typedef struct {
+    uint32_t masque;        // colonnes de la clé (bit c : colonne c)
+    uint32_t *tetes;        // alvéole -> dernier n-uplet indexé + 1 (0 : vide)
+    size_t nb_alveoles;     // puissance de 2
+    uint32_t *suivants;     // n-uplet -> n-uplet précédent de la même alvéole + 1
+    size_t cap;
+    size_t nb_indexes;      // n-uplets [0, nb_indexes) présents dans l’index
+} IndexDL;
+
+typedef struct {
+    PropId nom;             // dans ProgrammeDatalog.predicats
+    uint32_t arite;
+    uint32_t *tuples;       // nb * arite constantes
+    size_t nb;
+    size_t cap;
+    uint32_t *ensemble;     // dédoublonnage : adressage ouvert, n-uplet + 1
+    size_t nb_alveoles;
+    size_t ancien;          // [0, ancien) : n-uplets des itérations précédentes
+    size_t courant;         // [ancien, courant) : delta de l’itération
+    IndexDL *index;
+    size_t nb_index;
+} RelationDL;
+
+typedef struct {
+    uint32_t relation;
+    uint32_t premier;       // premier terme dans ProgrammeDatalog.termes
+} AtomeDL;
+
+/* Étape d’un plan de jointure : atome du corps et index utilisé */
+typedef struct {
+    uint32_t atome;         // position dans le corps
+    uint32_t index;         // UINT32_MAX : parcours sans clé
+} PasDL;
+
+typedef struct {
+    AtomeDL tete;
+    uint32_t premier_atome; // corps dans ProgrammeDatalog.atomes
+    uint32_t nb_corps;
+    uint32_t nb_variables;
+    uint32_t premier_pas;   // nb_corps plans de nb_corps étapes (un par atome delta)
+} RegleDL;
+
+typedef struct {
+    TableSymboles constantes;
+    TableSymboles predicats;
+    TableSymboles cles;     // "nom/arite" -> relation
+    RelationDL *relations;
+    size_t nb_relations, cap_relations;
+    int32_t *termes;        // >= 0 : constante ; < 0 : variable -(v + 1)
+    size_t nb_termes, cap_termes;
+    AtomeDL *atomes;
+    size_t nb_atomes, cap_atomes;
+    RegleDL *regles;
+    size_t nb_regles, cap_regles;
+    PasDL *pas;
+    size_t nb_pas, cap_pas;
+    uint64_t *journal;      // (relation << 32) | n-uplet, dans l’ordre de déduction
+    size_t nb_journal, cap_journal;
+    size_t iterations;      // itérations de la dernière évaluation
+    const Allocateur *alloc;
+} ProgrammeDatalog;
+
+bool datalog_compiler(ProgrammeDatalog *P, const BaseConnaissances *BC);
+size_t datalog_evaluer(ProgrammeDatalog *P, BaseFaits *BF);
+void datalog_detruire(ProgrammeDatalog *P);
+
+#endif
@@ -0,0 +1,621 @@
+#include "diagramme.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Fonctions constantes (la feuille ∅ sert aussi de « faux ») */
+#define DIAG_FAUX 0u
+#define DIAG_VRAI 1u
+
+/* Absence de nœud (table unique, renumérotation) */
+#define DIAG_AUCUN UINT32_MAX
+
+/* Entrées du cache d’opérations (correspondance directe, écrasées) */
+#define DIAG_CACHE (1u << 16)
+
+/* Opérations du cache : ET, OU, puis ajout de la conclusion c (2 + c) */
+enum { DIAG_ET, DIAG_OU, DIAG_AJOUT };
+
+typedef struct {
+    uint32_t op, a, b, res;
+} EntreeCache;
+
+/* État de la construction (libéré à la fin de diagramme_compiler) */
+typedef struct {
+    const Allocateur *A;
+    NoeudDiagramme *noeuds;
+    size_t nb_noeuds, cap_noeuds, max_noeuds;
+    bool trop_grand;
+    uint32_t *unique;        // table unique (adressage ouvert) : indices de nœuds
+    size_t masque_unique;
+    EntreeCache *cache;
+    uint32_t *ens_parent;    // ensembles de conclusions en arbre : parent + dernière conclusion
+    PropId *ens_dernier;
+    uint32_t *ens_feuille;   // nœud feuille de l’ensemble
+    uint32_t *ext;           // ensemble étendu par la conclusion en cours
+    uint32_t *ext_marque;    // conclusion (2 + c) pour laquelle ext est valide
+    size_t nb_ens, cap_ens;
+} Construction;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hacher_noeud
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Mélange les trois champs d’un nœud (table unique, cache).
+ *
+ * Paramètres :
+ *  - a, b, c : champs du nœud ou de l’opération
+ *
+ * Valeur de retour :
+ *  - valeur de hachage
+ */
+static uint64_t hacher_noeud(uint32_t a, uint32_t b, uint32_t c) {
+    uint64_t h = (uint64_t)a * 0x9E3779B97F4A7C15ull;
+    h ^= (uint64_t)b + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2);
+    h ^= (uint64_t)c * 0xC2B2AE3D27D4EB4Full;
+    return h ^ (h >> 29);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : empiler_noeud
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un nœud au tableau de construction, dans la limite de
+ *  max_noeuds.
+ *
+ * Paramètres :
+ *  - K              : construction
+ *  - var, bas, haut : champs du nœud
+ *
+ * Valeur de retour :
+ *  - indice du nœud (DIAG_FAUX si la limite est atteinte)
+ */
+static uint32_t empiler_noeud(Construction *K, uint32_t var, uint32_t bas, uint32_t haut) {
+    if (K->nb_noeuds >= K->max_noeuds) {
+        K->trop_grand = true;
+        return DIAG_FAUX;
+    }
+    if (K->nb_noeuds == K->cap_noeuds) {
+        K->cap_noeuds *= 2;
+        K->noeuds = (NoeudDiagramme *)mem_reallouer(K->A, K->noeuds, K->cap_noeuds * sizeof(NoeudDiagramme));
+    }
+    NoeudDiagramme *n = &K->noeuds[K->nb_noeuds];
+    n->var = var;
+    n->bas = bas;
+    n->haut = haut;
+    return (uint32_t)K->nb_noeuds++;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : agrandir_unique
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Double la table unique et y replace les nœuds internes.
+ *
+ * Paramètres :
+ *  - K : construction
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void agrandir_unique(Construction *K) {
+    size_t cap = (K->masque_unique + 1) * 2;
+    mem_liberer(K->A, K->unique);
+    K->unique = (uint32_t *)mem_allouer(K->A, cap * sizeof(uint32_t));
+    memset(K->unique, 0xFF, cap * sizeof(uint32_t));
+    K->masque_unique = cap - 1;
+
+    for (size_t i = 0; i < K->nb_noeuds; i++) {
+        const NoeudDiagramme *n = &K->noeuds[i];
+        if (n->var == DIAG_FEUILLE) continue;
+        size_t h = (size_t)hacher_noeud(n->var, n->bas, n->haut) & K->masque_unique;
+        while (K->unique[h] != DIAG_AUCUN) h = (h + 1) & K->masque_unique;
+        K->unique[h] = (uint32_t)i;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : noeud
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne le nœud (var, bas, haut) réduit : un test inutile
+ *  (bas == haut) disparaît et deux nœuds identiques sont partagés.
+ *
+ * Paramètres :
+ *  - K              : construction
+ *  - var            : rang de l’entrée testée
+ *  - bas, haut      : fils (entrée fausse, vraie)
+ *
+ * Valeur de retour :
+ *  - indice du nœud
+ */
+static uint32_t noeud(Construction *K, uint32_t var, uint32_t bas, uint32_t haut) {
+    if (bas == haut) return bas;
+
+    size_t h = (size_t)hacher_noeud(var, bas, haut) & K->masque_unique;
+    for (; K->unique[h] != DIAG_AUCUN; h = (h + 1) & K->masque_unique) {
+        const NoeudDiagramme *n = &K->noeuds[K->unique[h]];
+        if (n->var == var && n->bas == bas && n->haut == haut) return K->unique[h];
+    }
+
+    uint32_t id = empiler_noeud(K, var, bas, haut);
+    if (K->trop_grand) return DIAG_FAUX;
+    K->unique[h] = id;
+    if (K->nb_noeuds * 2 > K->masque_unique) agrandir_unique(K);
+    return id;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : cache_chercher
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Cherche le résultat d’une opération déjà calculée.
+ *
+ * Paramètres :
+ *  - K       : construction
+ *  - op, a, b: opération et opérandes
+ *  - res     : reçoit le résultat s’il est connu
+ *
+ * Valeur de retour :
+ *  - true si le résultat était en cache
+ */
+static bool cache_chercher(const Construction *K, uint32_t op, uint32_t a, uint32_t b, uint32_t *res) {
+    const EntreeCache *e = &K->cache[hacher_noeud(op, a, b) & (DIAG_CACHE - 1)];
+    if (e->op != op || e->a != a || e->b != b) return false;
+    *res = e->res;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : cache_noter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Mémorise le résultat d’une opération (écrase l’entrée).
+ *
+ * Paramètres :
+ *  - K            : construction
+ *  - op, a, b, res: opération, opérandes, résultat
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void cache_noter(Construction *K, uint32_t op, uint32_t a, uint32_t b, uint32_t res) {
+    EntreeCache *e = &K->cache[hacher_noeud(op, a, b) & (DIAG_CACHE - 1)];
+    e->op = op;
+    e->a = a;
+    e->b = b;
+    e->res = res;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : appliquer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  ET ou OU de deux fonctions booléennes (décomposition de
+ *  Shannon sur la plus petite variable des deux nœuds).
+ *
+ * Paramètres :
+ *  - K  : construction
+ *  - op : DIAG_ET ou DIAG_OU
+ *  - a  : première fonction
+ *  - b  : seconde fonction
+ *
+ * Valeur de retour :
+ *  - nœud du résultat
+ */
+static uint32_t appliquer(Construction *K, uint32_t op, uint32_t a, uint32_t b) {
+    if (a == b) return a;
+    if (op == DIAG_ET) {
+        if (a == DIAG_FAUX || b == DIAG_FAUX) return DIAG_FAUX;
+        if (a == DIAG_VRAI) return b;
+        if (b == DIAG_VRAI) return a;
+    } else {
+        if (a == DIAG_VRAI || b == DIAG_VRAI) return DIAG_VRAI;
+        if (a == DIAG_FAUX) return b;
+        if (b == DIAG_FAUX) return a;
+    }
+    if (a > b) {
+        uint32_t t = a;
+        a = b;
+        b = t;
+    }
+
+    uint32_t res;
+    if (cache_chercher(K, op, a, b, &res)) return res;
+
+    NoeudDiagramme na = K->noeuds[a], nb = K->noeuds[b];
+    uint32_t v = na.var < nb.var ? na.var : nb.var;
+    uint32_t bas = appliquer(K, op, na.var == v ? na.bas : a, nb.var == v ? nb.bas : b);
+    uint32_t haut = appliquer(K, op, na.var == v ? na.haut : a, nb.var == v ? nb.haut : b);
+    if (K->trop_grand) return DIAG_FAUX;
+
+    res = noeud(K, v, bas, haut);
+    cache_noter(K, op, a, b, res);
+    return res;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : etendre
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne la feuille de l’ensemble s augmenté de la conclusion en
+ *  cours (créée une fois par ensemble et par conclusion).
+ *
+ * Paramètres :
+ *  - K      : construction
+ *  - s      : ensemble de départ
+ *  - c      : conclusion ajoutée
+ *  - marque : DIAG_AJOUT + c
+ *
+ * Valeur de retour :
+ *  - nœud feuille de l’ensemble étendu
+ */
+static uint32_t etendre(Construction *K, uint32_t s, PropId c, uint32_t marque) {
+    if (K->ext_marque[s] == marque) return K->ens_feuille[K->ext[s]];
+
+    if (K->nb_ens == K->cap_ens) {
+        K->cap_ens *= 2;
+        K->ens_parent = (uint32_t *)mem_reallouer(K->A, K->ens_parent, K->cap_ens * sizeof(uint32_t));
+        K->ens_dernier = (PropId *)mem_reallouer(K->A, K->ens_dernier, K->cap_ens * sizeof(PropId));
+        K->ens_feuille = (uint32_t *)mem_reallouer(K->A, K->ens_feuille, K->cap_ens * sizeof(uint32_t));
+        K->ext = (uint32_t *)mem_reallouer(K->A, K->ext, K->cap_ens * sizeof(uint32_t));
+        K->ext_marque = (uint32_t *)mem_reallouer(K->A, K->ext_marque, K->cap_ens * sizeof(uint32_t));
+    }
+    uint32_t t = (uint32_t)K->nb_ens;
+    uint32_t f = empiler_noeud(K, DIAG_FEUILLE, t, 0);
+    if (K->trop_grand) return DIAG_FAUX;
+
+    K->nb_ens++;
+    K->ens_parent[t] = s;
+    K->ens_dernier[t] = c;
+    K->ens_feuille[t] = f;
+    K->ext_marque[t] = 0;
+    K->ext[s] = t;
+    K->ext_marque[s] = marque;
+    return f;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ajouter_conclusion
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute la conclusion c aux feuilles du diagramme m partout où
+ *  sa fonction f est vraie.
+ *
+ * Paramètres :
+ *  - K : construction
+ *  - m : diagramme à feuilles-ensembles
+ *  - f : fonction booléenne de c
+ *  - c : conclusion
+ *
+ * Valeur de retour :
+ *  - nœud du diagramme obtenu
+ */
+static uint32_t ajouter_conclusion(Construction *K, uint32_t m, uint32_t f, PropId c) {
+    if (f == DIAG_FAUX) return m;
+
+    uint32_t op = DIAG_AJOUT + c;
+    NoeudDiagramme nm = K->noeuds[m], nf = K->noeuds[f];
+    if (nm.var == DIAG_FEUILLE && f == DIAG_VRAI) return etendre(K, nm.bas, c, op);
+
+    uint32_t res;
+    if (cache_chercher(K, op, m, f, &res)) return res;
+
+    uint32_t v = nm.var < nf.var ? nm.var : nf.var;
+    uint32_t bas = ajouter_conclusion(K, nm.var == v ? nm.bas : m, nf.var == v ? nf.bas : f, c);
+    uint32_t haut = ajouter_conclusion(K, nm.var == v ? nm.haut : m, nf.var == v ? nf.haut : f, c);
+    if (K->trop_grand) return DIAG_FAUX;
+
+    res = noeud(K, v, bas, haut);
+    cache_noter(K, op, m, f, res);
+    return res;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : copier_atteignables
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Recopie dans le diagramme final les nœuds atteignables depuis
+ *  n (les fonctions intermédiaires sont abandonnées) et numérote
+ *  les feuilles rencontrées.
+ *
+ * Paramètres :
+ *  - K       : construction
+ *  - D       : diagramme final (noeuds alloués, nb_noeuds courant)
+ *  - n       : nœud de construction
+ *  - nouveau : par nœud de construction, indice final (DIAG_AUCUN)
+ *  - ens     : par feuille finale, ensemble de construction
+ *
+ * Valeur de retour :
+ *  - indice final du nœud
+ */
+static uint32_t copier_atteignables(const Construction *K, Diagramme *D, uint32_t n, uint32_t *nouveau,
+                                    uint32_t *ens) {
+    if (nouveau[n] != DIAG_AUCUN) return nouveau[n];
+
+    const NoeudDiagramme *src = &K->noeuds[n];
+    NoeudDiagramme copie = *src;
+    if (src->var == DIAG_FEUILLE) {
+        ens[D->nb_feuilles] = src->bas;
+        copie.bas = (uint32_t)D->nb_feuilles++;
+    } else {
+        copie.bas = copier_atteignables(K, D, src->bas, nouveau, ens);
+        copie.haut = copier_atteignables(K, D, src->haut, nouveau, ens);
+    }
+    D->noeuds[D->nb_noeuds] = copie;
+    nouveau[n] = (uint32_t)D->nb_noeuds;
+    return (uint32_t)D->nb_noeuds++;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : comparer_ids
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ordre croissant des identifiants (pour qsort).
+ *
+ * Paramètres :
+ *  - a, b : pointeurs vers deux PropId
+ *
+ * Valeur de retour :
+ *  - négatif, nul ou positif
+ */
+static int comparer_ids(const void *a, const void *b) {
+    PropId x = *(const PropId *)a, y = *(const PropId *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : diagramme_compiler
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Construit le diagramme de décision d’une BC compilée : la
+ *  fonction de chaque conclusion (OU des règles, ET des
+ *  prémisses) est calculée dans l’ordre des dépendances, puis
+ *  ajoutée aux feuilles du diagramme commun. Seuls les nœuds
+ *  atteignables depuis la racine sont conservés ; les conclusions
+ *  d’une feuille sont rangées par identifiant croissant.
+ *
+ * Paramètres :
+ *  - D          : diagramme à construire (à détruire dans tous les cas)
+ *  - C          : BC compilée (doit survivre au diagramme)
+ *  - max_noeuds : nœuds créés au plus pendant la construction
+ *                 (fonctions intermédiaires comprises), et
+ *                 conclusions rangées au plus dans les feuilles
+ *
+ * Valeur de retour :
+ *  - true  : BC éligible, diagramme prêt
+ *  - false : D->motif indique la cause (cycle, taille)
+ *
+ * Variables locales :
+ *  - K      : état de la construction
+ *  - debut  : par proposition (+1), début de ses règles (C->prod_debut)
+ *  - ordre  : règles dans l’ordre des dépendances, groupées par conclusion
+ *  - f      : par proposition, nœud de sa fonction booléenne
+ */
+bool diagramme_compiler(Diagramme *D, const BCCompilee *C, size_t max_noeuds) {
+    const Allocateur *A = C->symboles.alloc;
+    size_t np = bcc_nb_propositions(C);
+
+    memset(D, 0, sizeof(*D));
+    D->bc = C;
+    D->alloc = A;
+    D->motif = DIAG_ELIGIBLE;
+    D->conclue = (uint8_t *)mem_allouer_zero(A, np ? np : 1);
+    D->entrees = (PropId *)mem_allouer(A, (np ? np : 1) * sizeof(PropId));
+
+    TRACE_DEBUT("diagramme_compiler");
+
+    // Entrées : prémisses non conclues, dans l’ordre de première apparition
+    const uint32_t *debut = C->prod_debut;
+    uint32_t *f = (uint32_t *)mem_allouer(A, (np ? np : 1) * sizeof(uint32_t));
+    memset(f, 0xFF, np * sizeof(uint32_t));
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        for (uint32_t k = 0; k < C->regles[r].nb; k++) {
+            PropId q = C->premisses[C->regles[r].debut + k];
+            if (debut[q] == debut[q + 1] && f[q] == DIAG_AUCUN) {
+                f[q] = DIAG_AUCUN - 1;
+                D->entrees[D->nb_entrees++] = q;
+            }
+        }
+    }
+
+    uint32_t *ordre = (uint32_t *)mem_allouer(A, (C->nb_regles ? C->nb_regles : 1) * sizeof(uint32_t));
+    if (!bcc_ordre_dependances(C, ordre)) D->motif = DIAG_CYCLE;
+
+    Construction K;
+    memset(&K, 0, sizeof(K));
+    K.A = A;
+    if (D->motif == DIAG_ELIGIBLE) {
+        K.max_noeuds = max_noeuds < 2 ? 2 : max_noeuds;
+        K.cap_noeuds = 64;
+        K.noeuds = (NoeudDiagramme *)mem_allouer(A, K.cap_noeuds * sizeof(NoeudDiagramme));
+        K.masque_unique = 127;
+        K.unique = (uint32_t *)mem_allouer(A, (K.masque_unique + 1) * sizeof(uint32_t));
+        memset(K.unique, 0xFF, (K.masque_unique + 1) * sizeof(uint32_t));
+        K.cache = (EntreeCache *)mem_allouer(A, DIAG_CACHE * sizeof(EntreeCache));
+        memset(K.cache, 0xFF, DIAG_CACHE * sizeof(EntreeCache));
+        K.cap_ens = 16;
+        K.ens_parent = (uint32_t *)mem_allouer(A, K.cap_ens * sizeof(uint32_t));
+        K.ens_dernier = (PropId *)mem_allouer(A, K.cap_ens * sizeof(PropId));
+        K.ens_feuille = (uint32_t *)mem_allouer(A, K.cap_ens * sizeof(uint32_t));
+        K.ext = (uint32_t *)mem_allouer(A, K.cap_ens * sizeof(uint32_t));
+        K.ext_marque = (uint32_t *)mem_allouer(A, K.cap_ens * sizeof(uint32_t));
+
+        // Feuille ∅ (= faux), vrai, puis une variable par entrée
+        empiler_noeud(&K, DIAG_FEUILLE, 0, 0);
+        empiler_noeud(&K, DIAG_FEUILLE, DIAG_AUCUN, DIAG_AUCUN);
+        K.nb_ens = 1;
+        K.ens_parent[0] = 0;
+        K.ens_feuille[0] = DIAG_FAUX;
+        K.ext_marque[0] = 0;
+        for (uint32_t i = 0; i < D->nb_entrees && !K.trop_grand; i++)
+            f[D->entrees[i]] = noeud(&K, i, DIAG_FAUX, DIAG_VRAI);
+
+        // Fonctions des conclusions, ajoutées aussitôt aux feuilles
+        uint32_t m = DIAG_FAUX;
+        for (size_t i = 0; i < C->nb_regles && !K.trop_grand; i++) {
+            PropId c = C->regles[ordre[i]].conclusion;
+            if (i > 0 && C->regles[ordre[i - 1]].conclusion == c) continue;
+            uint32_t fc = DIAG_FAUX;
+            for (uint32_t j = debut[c]; j < debut[c + 1] && !K.trop_grand; j++) {
+                const RegleCompilee *R = &C->regles[C->prod_regles[j]];
+                uint32_t et = DIAG_VRAI;
+                for (uint32_t k = 0; k < R->nb && et != DIAG_FAUX; k++)
+                    et = appliquer(&K, DIAG_ET, et, f[C->premisses[R->debut + k]]);
+                fc = appliquer(&K, DIAG_OU, fc, et);
+            }
+            f[c] = fc;
+            D->conclue[c] = fc == DIAG_VRAI ? 2 : 1;
+            m = ajouter_conclusion(&K, m, fc, c);
+        }
+        if (K.trop_grand) D->motif = DIAG_TROP_GRAND;
+
+        // Diagramme final : nœuds atteignables, puis ensembles à plat (dans la limite)
+        uint32_t *nouveau = (uint32_t *)mem_allouer(A, K.nb_noeuds * sizeof(uint32_t));
+        uint32_t *ens = (uint32_t *)mem_allouer(A, K.nb_noeuds * sizeof(uint32_t));
+        size_t total = 0;
+        if (D->motif == DIAG_ELIGIBLE) {
+            memset(nouveau, 0xFF, K.nb_noeuds * sizeof(uint32_t));
+            D->noeuds = (NoeudDiagramme *)mem_allouer(A, K.nb_noeuds * sizeof(NoeudDiagramme));
+            D->racine = copier_atteignables(&K, D, m, nouveau, ens);
+            for (size_t i = 0; i < D->nb_feuilles; i++)
+                for (uint32_t s = ens[i]; s != 0; s = K.ens_parent[s]) total++;
+            if (total > K.max_noeuds) D->motif = DIAG_TROP_GRAND;
+        }
+        if (D->motif == DIAG_ELIGIBLE) {
+            D->feuille_debut = (uint32_t *)mem_allouer(A, (D->nb_feuilles + 1) * sizeof(uint32_t));
+            D->conclusions = (PropId *)mem_allouer(A, (total ? total : 1) * sizeof(PropId));
+            size_t n = 0;
+            for (size_t i = 0; i < D->nb_feuilles; i++) {
+                D->feuille_debut[i] = (uint32_t)n;
+                for (uint32_t s = ens[i]; s != 0; s = K.ens_parent[s]) n++;
+                size_t j = n;
+                for (uint32_t s = ens[i]; s != 0; s = K.ens_parent[s]) D->conclusions[--j] = K.ens_dernier[s];
+                qsort(D->conclusions + j, n - j, sizeof(PropId), comparer_ids);
+            }
+            D->feuille_debut[D->nb_feuilles] = (uint32_t)n;
+        } else {
+            mem_liberer(A, D->noeuds);
+            D->noeuds = NULL;
+            D->nb_noeuds = D->nb_feuilles = 0;
+        }
+        mem_liberer(A, ens);
+        mem_liberer(A, nouveau);
+
+        mem_liberer(A, K.noeuds);
+        mem_liberer(A, K.unique);
+        mem_liberer(A, K.cache);
+        mem_liberer(A, K.ens_parent);
+        mem_liberer(A, K.ens_dernier);
+        mem_liberer(A, K.ens_feuille);
+        mem_liberer(A, K.ext);
+        mem_liberer(A, K.ext_marque);
+    }
+
+    mem_liberer(A, ordre);
+    mem_liberer(A, f);
+
+    TRACE_FIN("diagramme_compiler");
+    return D->motif == DIAG_ELIGIBLE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : diagramme_evaluer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Suit le chemin des entrées vraies de la racine à une feuille.
+ *  Seules les entrées sont lues : une conclusion affirmée dans
+ *  "vrai" est ignorée (voir diagramme_deduire).
+ *
+ * Paramètres :
+ *  - D           : diagramme éligible
+ *  - vrai        : par proposition, valeur de vérité
+ *  - conclusions : reçoit les conclusions vraies, par identifiant
+ *                  croissant (dans le diagramme)
+ *
+ * Valeur de retour :
+ *  - nombre de conclusions vraies
+ */
+size_t diagramme_evaluer(const Diagramme *D, const uint8_t *vrai, const PropId **conclusions) {
+    const NoeudDiagramme *N = D->noeuds;
+    uint32_t n = D->racine;
+
+    while (N[n].var != DIAG_FEUILLE) n = vrai[D->entrees[N[n].var]] ? N[n].haut : N[n].bas;
+
+    uint32_t s = N[n].bas;
+    *conclusions = D->conclusions + D->feuille_debut[s];
+    return D->feuille_debut[s + 1] - D->feuille_debut[s];
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : diagramme_deduire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Sature une session : par le diagramme si la BC est éligible et
+ *  que la session n’affirme aucune conclusion (hors conclusions
+ *  toujours vraies), sinon par session_saturer. Les conclusions
+ *  du diagramme sont affirmées sans être propagées : elles restent
+ *  dans l’agenda, si bien qu’un session_saturer ultérieur (après
+ *  de nouveaux faits) garde des compteurs exacts.
+ *
+ * Paramètres :
+ *  - D : diagramme (éligible ou non)
+ *  - S : session sur la même BC compilée
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits pendant l’appel
+ */
+size_t diagramme_deduire(const Diagramme *D, Session *S) {
+    if (D->motif != DIAG_ELIGIBLE || S->bc != D->bc) return session_saturer(S);
+    for (size_t i = 0; i < S->nb_faits; i++)
+        if (D->conclue[S->faits[i]] == 1) return session_saturer(S);
+
+    const PropId *c;
+    size_t n = diagramme_evaluer(D, S->vrai, &c);
+    size_t deduits = 0;
+    for (size_t i = 0; i < n; i++)
+        if (session_affirmer(S, c[i])) deduits++;
+    return deduits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : diagramme_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère le diagramme (la BC compilée n’est pas touchée).
+ *
+ * Paramètres :
+ *  - D : diagramme à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void diagramme_detruire(Diagramme *D) {
+    mem_liberer(D->alloc, D->entrees);
+    mem_liberer(D->alloc, D->conclue);
+    mem_liberer(D->alloc, D->noeuds);
+    mem_liberer(D->alloc, D->feuille_debut);
+    mem_liberer(D->alloc, D->conclusions);
+    D->entrees = NULL;
+    D->conclue = NULL;
+    D->noeuds = NULL;
+    D->feuille_debut = NULL;
+    D->conclusions = NULL;
+    D->nb_noeuds = D->nb_feuilles = 0;
+    D->nb_entrees = 0;
+}
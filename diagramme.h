@@ -0,0 +1,61 @@
+#ifndef DIAGRAMME_H
+#define DIAGRAMME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+
+/*
+ * Diagramme de décision pour les BC de classification : un jeu fixe
+ * de propositions d’entrée (qu’aucune règle ne conclut) mène à des
+ * diagnostics par des règles sans cycle. Chaque conclusion est alors
+ * une fonction booléenne des entrées ; le diagramme ordonné et réduit
+ * (les entrées dans l’ordre de leur première apparition en prémisse)
+ * a pour feuilles les ensembles de conclusions. Une requête est un
+ * seul chemin de la racine à une feuille, qui donne toutes les
+ * conclusions d’un coup, quel que soit le nombre de règles.
+ *
+ * Une BC avec un cycle n’est pas éligible ; le nombre de nœuds
+ * construits est borné. Dans ces deux cas, comme pour une requête
+ * qui affirme une conclusion, diagramme_deduire revient au chaînage
+ * avant de la Session.
+ */
+
+/* Variable des feuilles (au-delà de toute entrée) */
+#define DIAG_FEUILLE UINT32_MAX
+
+typedef enum {
+    DIAG_ELIGIBLE,
+    DIAG_CYCLE,          // une conclusion dépend d’elle-même
+    DIAG_TROP_GRAND      // max_noeuds dépassé (nœuds ou conclusions des feuilles)
+} MotifDiagramme;
+
+/* Nœud : var est le rang de l’entrée testée ; une feuille porte son ensemble dans bas */
+typedef struct {
+    uint32_t var;
+    uint32_t bas;        // entrée fausse
+    uint32_t haut;       // entrée vraie
+} NoeudDiagramme;
+
+typedef struct {
+    const BCCompilee *bc;
+    MotifDiagramme motif;
+    PropId *entrees;         // par rang : proposition testée
+    uint32_t nb_entrees;
+    uint8_t *conclue;        // par proposition : 1 conclue, 2 toujours vraie
+    NoeudDiagramme *noeuds;  // nœuds atteignables depuis la racine
+    size_t nb_noeuds;
+    uint32_t racine;
+    uint32_t *feuille_debut; // par ensemble (+1) : début de ses conclusions
+    PropId *conclusions;
+    size_t nb_feuilles;
+    const Allocateur *alloc;
+} Diagramme;
+
+bool diagramme_compiler(Diagramme *D, const BCCompilee *C, size_t max_noeuds);
+size_t diagramme_evaluer(const Diagramme *D, const uint8_t *vrai, const PropId **conclusions);
+size_t diagramme_deduire(const Diagramme *D, Session *S);
+void diagramme_detruire(Diagramme *D);
+
+#endif
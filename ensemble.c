@@ -0,0 +1,968 @@
+#include "ensemble.h"
+#include <string.h>
+
+/* Nombre de mots de 64 bits d’un conteneur bitmap */
+#define MOTS_BITMAP 1024
+
+/* Parcours des valeurs d’un conteneur, dans l’ordre croissant */
+typedef struct {
+    const Conteneur *c;
+    uint32_t i;       // position (tableau, séquence) ou mot courant (bitmap)
+    uint32_t j;       // décalage dans la séquence courante
+    uint64_t mot;     // bits restants du mot courant (bitmap)
+} Curseur;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : nb_bits
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Nombre de bits à 1 d’un mot.
+ *
+ * Paramètres :
+ *  - x : mot
+ *
+ * Valeur de retour :
+ *  - nombre de bits à 1
+ */
+static uint32_t nb_bits(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    uint32_t n = 0;
+    for (; x; x &= x - 1) n++;
+    return n;
+#endif
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bit_bas
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Position du bit à 1 de plus faible poids d’un mot non nul.
+ *
+ * Paramètres :
+ *  - x : mot (non nul)
+ *
+ * Valeur de retour :
+ *  - position (0 .. 63)
+ */
+static uint32_t bit_bas(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(x);
+#else
+    uint32_t n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : curseur_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Place un curseur sur la première valeur d’un conteneur.
+ *
+ * Paramètres :
+ *  - k : curseur
+ *  - c : conteneur parcouru
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void curseur_init(Curseur *k, const Conteneur *c) {
+    k->c = c;
+    k->i = 0;
+    k->j = 0;
+    k->mot = c->type == CONTENEUR_BITMAP ? ((const uint64_t *)c->donnees)[0] : 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : curseur_suivant
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne la valeur suivante d’un conteneur.
+ *
+ * Paramètres :
+ *  - k : curseur
+ *  - v : reçoit la valeur (16 bits de poids faible)
+ *
+ * Valeur de retour :
+ *  - false quand le conteneur est épuisé
+ */
+static bool curseur_suivant(Curseur *k, uint16_t *v) {
+    const Conteneur *c = k->c;
+
+    switch (c->type) {
+        case CONTENEUR_TABLEAU:
+            if (k->i >= c->taille) return false;
+            *v = ((const uint16_t *)c->donnees)[k->i++];
+            return true;
+
+        case CONTENEUR_BITMAP:
+            while (k->mot == 0) {
+                if (++k->i >= MOTS_BITMAP) return false;
+                k->mot = ((const uint64_t *)c->donnees)[k->i];
+            }
+            *v = (uint16_t)(k->i * 64 + bit_bas(k->mot));
+            k->mot &= k->mot - 1;
+            return true;
+
+        default: {
+            if (k->i >= c->taille) return false;
+            const uint16_t *s = (const uint16_t *)c->donnees;
+            *v = (uint16_t)(s[2 * k->i] + k->j);
+            if (k->j == s[2 * k->i + 1]) {
+                k->i++;
+                k->j = 0;
+            } else {
+                k->j++;
+            }
+            return true;
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : chercher_tableau
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Recherche dichotomique dans un tableau trié de uint16_t.
+ *
+ * Paramètres :
+ *  - t : tableau
+ *  - n : nombre d’éléments
+ *  - v : valeur cherchée
+ *
+ * Valeur de retour :
+ *  - position de v, ou position d’insertion si v est absente
+ */
+static uint32_t chercher_tableau(const uint16_t *t, uint32_t n, uint16_t v) {
+    uint32_t bas = 0, haut = n;
+    while (bas < haut) {
+        uint32_t m = (bas + haut) / 2;
+        if (t[m] < v) bas = m + 1;
+        else haut = m;
+    }
+    return bas;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : conteneur_contient
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste l’appartenance d’une valeur à un conteneur.
+ *
+ * Paramètres :
+ *  - c : conteneur
+ *  - v : valeur (16 bits de poids faible)
+ *
+ * Valeur de retour :
+ *  - true si v est présente
+ */
+static bool conteneur_contient(const Conteneur *c, uint16_t v) {
+    switch (c->type) {
+        case CONTENEUR_TABLEAU: {
+            const uint16_t *t = (const uint16_t *)c->donnees;
+            uint32_t i = chercher_tableau(t, c->taille, v);
+            return i < c->taille && t[i] == v;
+        }
+
+        case CONTENEUR_BITMAP:
+            return (((const uint64_t *)c->donnees)[v >> 6] >> (v & 63)) & 1;
+
+        default: {
+            // Dernière séquence commençant au plus à v
+            const uint16_t *s = (const uint16_t *)c->donnees;
+            uint32_t bas = 0, haut = c->taille;
+            while (bas < haut) {
+                uint32_t m = (bas + haut) / 2;
+                if (s[2 * m] <= v) bas = m + 1;
+                else haut = m;
+            }
+            return bas > 0 && v - s[2 * (bas - 1)] <= s[2 * (bas - 1) + 1];
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : vers_bitmap
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Convertit un conteneur en bitmap.
+ *
+ * Paramètres :
+ *  - A : allocateur
+ *  - c : conteneur (tableau ou séquences)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void vers_bitmap(const Allocateur *A, Conteneur *c) {
+    uint64_t *mots = (uint64_t *)mem_allouer_zero(A, MOTS_BITMAP * sizeof(uint64_t));
+    Curseur k;
+    uint16_t v;
+
+    curseur_init(&k, c);
+    while (curseur_suivant(&k, &v)) mots[v >> 6] |= UINT64_C(1) << (v & 63);
+
+    mem_liberer(A, c->donnees);
+    c->donnees = mots;
+    c->type = CONTENEUR_BITMAP;
+    c->taille = 0;
+    c->cap = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : vers_tableau
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Convertit un conteneur d’au plus ENSEMBLE_TABLEAU_MAX valeurs
+ *  en tableau trié.
+ *
+ * Paramètres :
+ *  - A : allocateur
+ *  - c : conteneur (bitmap ou séquences)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void vers_tableau(const Allocateur *A, Conteneur *c) {
+    uint16_t *t = (uint16_t *)mem_allouer(A, c->nb * sizeof(uint16_t));
+    uint32_t n = 0;
+    Curseur k;
+    uint16_t v;
+
+    curseur_init(&k, c);
+    while (curseur_suivant(&k, &v)) t[n++] = v;
+
+    mem_liberer(A, c->donnees);
+    c->donnees = t;
+    c->type = CONTENEUR_TABLEAU;
+    c->taille = n;
+    c->cap = n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : vers_sequences
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Convertit un conteneur en séquences (début, longueur - 1).
+ *
+ * Paramètres :
+ *  - A        : allocateur
+ *  - c        : conteneur (tableau ou bitmap)
+ *  - nb_seq   : nombre de séquences (déjà compté)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void vers_sequences(const Allocateur *A, Conteneur *c, uint32_t nb_seq) {
+    uint16_t *s = (uint16_t *)mem_allouer(A, 2 * nb_seq * sizeof(uint16_t));
+    uint32_t n = 0;
+    Curseur k;
+    uint16_t v;
+
+    curseur_init(&k, c);
+    while (curseur_suivant(&k, &v)) {
+        if (n > 0 && v == (uint16_t)(s[2 * (n - 1)] + s[2 * (n - 1) + 1] + 1)) {
+            s[2 * (n - 1) + 1]++;
+        } else {
+            s[2 * n] = v;
+            s[2 * n + 1] = 0;
+            n++;
+        }
+    }
+
+    mem_liberer(A, c->donnees);
+    c->donnees = s;
+    c->type = CONTENEUR_SEQUENCES;
+    c->taille = n;
+    c->cap = 2 * n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : decompresser
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ramène un conteneur de séquences à sa forme modifiable
+ *  (tableau ou bitmap selon son cardinal).
+ *
+ * Paramètres :
+ *  - A : allocateur
+ *  - c : conteneur
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void decompresser(const Allocateur *A, Conteneur *c) {
+    if (c->type != CONTENEUR_SEQUENCES) return;
+    if (c->nb > ENSEMBLE_TABLEAU_MAX) vers_bitmap(A, c);
+    else vers_tableau(A, c);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : chercher_conteneur
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Recherche dichotomique du conteneur d’une clé.
+ *
+ * Paramètres :
+ *  - E       : ensemble
+ *  - cle     : 16 bits de poids fort
+ *  - present : reçoit true si le conteneur existe
+ *
+ * Valeur de retour :
+ *  - position du conteneur, ou position d’insertion
+ */
+static uint32_t chercher_conteneur(const EnsembleFaits *E, uint16_t cle, bool *present) {
+    uint32_t bas = 0, haut = E->nb;
+    while (bas < haut) {
+        uint32_t m = (bas + haut) / 2;
+        if (E->conteneurs[m].cle < cle) bas = m + 1;
+        else haut = m;
+    }
+    *present = bas < E->nb && E->conteneurs[bas].cle == cle;
+    return bas;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise un ensemble vide (allocateur système).
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void ensemble_init(EnsembleFaits *E) {
+    ensemble_init_avec(E, NULL);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise un ensemble vide dont toute la mémoire provient de
+ *  l’allocateur donné. Aucune allocation n’a lieu avant le
+ *  premier ajout.
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *  - A : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void ensemble_init_avec(EnsembleFaits *E, const Allocateur *A) {
+    E->conteneurs = NULL;
+    E->nb = 0;
+    E->cap = 0;
+    E->alloc = A ? A : &allocateur_systeme;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_ajouter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un identifiant. Un tableau plein devient un bitmap ; un
+ *  conteneur de séquences est d’abord décompressé.
+ *
+ * Paramètres :
+ *  - E  : ensemble
+ *  - id : identifiant
+ *
+ * Valeur de retour :
+ *  - true  : l’identifiant est nouveau
+ *  - false : il était déjà présent
+ *
+ * Variables locales :
+ *  - cle, v : 16 bits de poids fort et de poids faible
+ */
+bool ensemble_ajouter(EnsembleFaits *E, PropId id) {
+    uint16_t cle = (uint16_t)(id >> 16), v = (uint16_t)id;
+    bool present;
+    uint32_t pos = chercher_conteneur(E, cle, &present);
+
+    if (!present) {
+        if (E->nb == E->cap) {
+            uint32_t cap = E->cap ? 2 * E->cap : 4;
+            E->conteneurs = (Conteneur *)mem_reallouer(E->alloc, E->conteneurs, cap * sizeof(Conteneur));
+            E->cap = cap;
+        }
+        uint16_t *t = (uint16_t *)mem_allouer(E->alloc, 4 * sizeof(uint16_t));
+        memmove(&E->conteneurs[pos + 1], &E->conteneurs[pos], (E->nb - pos) * sizeof(Conteneur));
+        E->nb++;
+
+        Conteneur *c = &E->conteneurs[pos];
+        c->cle = cle;
+        c->type = CONTENEUR_TABLEAU;
+        c->nb = 1;
+        c->taille = 1;
+        c->cap = 4;
+        c->donnees = t;
+        t[0] = v;
+        return true;
+    }
+
+    Conteneur *c = &E->conteneurs[pos];
+    if (c->type == CONTENEUR_SEQUENCES) {
+        if (conteneur_contient(c, v)) return false;
+        decompresser(E->alloc, c);
+    }
+
+    if (c->type == CONTENEUR_TABLEAU) {
+        uint16_t *t = (uint16_t *)c->donnees;
+        uint32_t i = chercher_tableau(t, c->taille, v);
+        if (i < c->taille && t[i] == v) return false;
+
+        if (c->taille == ENSEMBLE_TABLEAU_MAX) {
+            vers_bitmap(E->alloc, c);
+        } else {
+            if (c->taille == c->cap) {
+                c->cap = c->cap * 2 > ENSEMBLE_TABLEAU_MAX ? ENSEMBLE_TABLEAU_MAX : c->cap * 2;
+                t = (uint16_t *)mem_reallouer(E->alloc, t, c->cap * sizeof(uint16_t));
+                c->donnees = t;
+            }
+            memmove(t + i + 1, t + i, (c->taille - i) * sizeof(uint16_t));
+            t[i] = v;
+            c->taille++;
+            c->nb++;
+            return true;
+        }
+    }
+
+    uint64_t *mots = (uint64_t *)c->donnees;
+    uint64_t bit = UINT64_C(1) << (v & 63);
+    if (mots[v >> 6] & bit) return false;
+    mots[v >> 6] |= bit;
+    c->nb++;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_retirer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire un identifiant. Un bitmap redescendu à
+ *  ENSEMBLE_TABLEAU_MAX valeurs redevient un tableau, un
+ *  conteneur vide est supprimé.
+ *
+ * Paramètres :
+ *  - E  : ensemble
+ *  - id : identifiant
+ *
+ * Valeur de retour :
+ *  - true si l’identifiant était présent
+ */
+bool ensemble_retirer(EnsembleFaits *E, PropId id) {
+    uint16_t cle = (uint16_t)(id >> 16), v = (uint16_t)id;
+    bool present;
+    uint32_t pos = chercher_conteneur(E, cle, &present);
+    if (!present || !conteneur_contient(&E->conteneurs[pos], v)) return false;
+
+    Conteneur *c = &E->conteneurs[pos];
+    decompresser(E->alloc, c);
+
+    if (c->type == CONTENEUR_TABLEAU) {
+        uint16_t *t = (uint16_t *)c->donnees;
+        uint32_t i = chercher_tableau(t, c->taille, v);
+        memmove(t + i, t + i + 1, (c->taille - i - 1) * sizeof(uint16_t));
+        c->taille--;
+    } else {
+        ((uint64_t *)c->donnees)[v >> 6] &= ~(UINT64_C(1) << (v & 63));
+    }
+    c->nb--;
+
+    if (c->nb == 0) {
+        mem_liberer(E->alloc, c->donnees);
+        memmove(&E->conteneurs[pos], &E->conteneurs[pos + 1], (E->nb - pos - 1) * sizeof(Conteneur));
+        E->nb--;
+    } else if (c->type == CONTENEUR_BITMAP && c->nb <= ENSEMBLE_TABLEAU_MAX) {
+        vers_tableau(E->alloc, c);
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_contient
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste l’appartenance d’un identifiant.
+ *
+ * Paramètres :
+ *  - E  : ensemble
+ *  - id : identifiant
+ *
+ * Valeur de retour :
+ *  - true si l’identifiant est présent
+ */
+bool ensemble_contient(const EnsembleFaits *E, PropId id) {
+    bool present;
+    uint32_t pos = chercher_conteneur(E, (uint16_t)(id >> 16), &present);
+    return present && conteneur_contient(&E->conteneurs[pos], (uint16_t)id);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_contient_tous
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste si tous les identifiants d’un tableau sont présents
+ *  (prémisses d’une règle). Le conteneur trouvé est conservé
+ *  tant que la clé ne change pas : des identifiants voisins ne
+ *  coûtent qu’un test dans le conteneur.
+ *
+ * Paramètres :
+ *  - E   : ensemble
+ *  - ids : identifiants testés
+ *  - n   : nombre d’identifiants
+ *
+ * Valeur de retour :
+ *  - true si tous sont présents (vrai pour n = 0)
+ *
+ * Variables locales :
+ *  - c        : conteneur de la dernière clé (NULL si absent)
+ *  - derniere : dernière clé cherchée (> UINT16_MAX : aucune)
+ */
+bool ensemble_contient_tous(const EnsembleFaits *E, const PropId *ids, size_t n) {
+    const Conteneur *c = NULL;
+    uint32_t derniere = UINT32_MAX;
+
+    for (size_t i = 0; i < n; i++) {
+        uint32_t cle = ids[i] >> 16;
+        if (cle != derniere) {
+            bool present;
+            uint32_t pos = chercher_conteneur(E, (uint16_t)cle, &present);
+            c = present ? &E->conteneurs[pos] : NULL;
+            derniere = cle;
+        }
+        if (!c || !conteneur_contient(c, (uint16_t)ids[i])) return false;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_cardinal
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Nombre d’identifiants de l’ensemble.
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *
+ * Valeur de retour :
+ *  - cardinal
+ */
+size_t ensemble_cardinal(const EnsembleFaits *E) {
+    size_t n = 0;
+    for (uint32_t i = 0; i < E->nb; i++) n += E->conteneurs[i].nb;
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_extraire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit les identifiants de l’ensemble dans l’ordre croissant.
+ *
+ * Paramètres :
+ *  - E      : ensemble
+ *  - sortie : tableau d’au moins ensemble_cardinal(E) éléments
+ *
+ * Valeur de retour :
+ *  - nombre d’identifiants écrits
+ */
+size_t ensemble_extraire(const EnsembleFaits *E, PropId *sortie) {
+    size_t n = 0;
+    for (uint32_t i = 0; i < E->nb; i++) {
+        const Conteneur *c = &E->conteneurs[i];
+        Curseur k;
+        uint16_t v;
+        curseur_init(&k, c);
+        while (curseur_suivant(&k, &v)) sortie[n++] = ((PropId)c->cle << 16) | v;
+    }
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : conteneur_et
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Intersection de deux conteneurs de même clé. Deux bitmaps sont
+ *  combinés mot à mot (boucle sans branchement, vectorisable) ;
+ *  sinon le plus petit conteneur est parcouru et chaque valeur
+ *  est testée dans l’autre.
+ *
+ * Paramètres :
+ *  - a, b : conteneurs
+ *  - mots : reçoit l’intersection en bitmap (MOTS_BITMAP mots,
+ *           déjà à zéro), ou NULL pour le seul cardinal
+ *
+ * Valeur de retour :
+ *  - cardinal de l’intersection
+ */
+static uint32_t conteneur_et(const Conteneur *a, const Conteneur *b, uint64_t *mots) {
+    uint32_t n = 0;
+
+    if (a->type == CONTENEUR_BITMAP && b->type == CONTENEUR_BITMAP) {
+        const uint64_t *x = (const uint64_t *)a->donnees, *y = (const uint64_t *)b->donnees;
+        if (mots) {
+            for (uint32_t i = 0; i < MOTS_BITMAP; i++) mots[i] = x[i] & y[i];
+            for (uint32_t i = 0; i < MOTS_BITMAP; i++) n += nb_bits(mots[i]);
+        } else {
+            for (uint32_t i = 0; i < MOTS_BITMAP; i++) n += nb_bits(x[i] & y[i]);
+        }
+        return n;
+    }
+
+    if (a->nb > b->nb) {
+        const Conteneur *t = a;
+        a = b;
+        b = t;
+    }
+
+    Curseur k;
+    uint16_t v;
+    curseur_init(&k, a);
+    while (curseur_suivant(&k, &v)) {
+        if (!conteneur_contient(b, v)) continue;
+        n++;
+        if (mots) mots[v >> 6] |= UINT64_C(1) << (v & 63);
+    }
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_cardinal_intersection
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Cardinal de l’intersection de deux ensembles, sans la
+ *  construire.
+ *
+ * Paramètres :
+ *  - a, b : ensembles
+ *
+ * Valeur de retour :
+ *  - cardinal de a ∩ b
+ */
+size_t ensemble_cardinal_intersection(const EnsembleFaits *a, const EnsembleFaits *b) {
+    size_t n = 0;
+    uint32_t i = 0, j = 0;
+
+    while (i < a->nb && j < b->nb) {
+        uint16_t x = a->conteneurs[i].cle, y = b->conteneurs[j].cle;
+        if (x < y) i++;
+        else if (y < x) j++;
+        else n += conteneur_et(&a->conteneurs[i++], &b->conteneurs[j++], NULL);
+    }
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_intersection
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Remplace le contenu de dest par a ∩ b. Chaque conteneur
+ *  résultat prend la forme la plus compacte entre tableau et
+ *  bitmap.
+ *
+ * Paramètres :
+ *  - dest : ensemble résultat (initialisé, distinct de a et b)
+ *  - a, b : ensembles
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - mots : bitmap de travail
+ */
+void ensemble_intersection(EnsembleFaits *dest, const EnsembleFaits *a, const EnsembleFaits *b) {
+    ensemble_vider(dest);
+    uint64_t *mots = (uint64_t *)mem_allouer(dest->alloc, MOTS_BITMAP * sizeof(uint64_t));
+    uint32_t i = 0, j = 0;
+
+    while (i < a->nb && j < b->nb) {
+        uint16_t x = a->conteneurs[i].cle, y = b->conteneurs[j].cle;
+        if (x < y) {
+            i++;
+            continue;
+        }
+        if (y < x) {
+            j++;
+            continue;
+        }
+
+        memset(mots, 0, MOTS_BITMAP * sizeof(uint64_t));
+        uint32_t n = conteneur_et(&a->conteneurs[i++], &b->conteneurs[j++], mots);
+        if (n == 0) continue;
+
+        if (dest->nb == dest->cap) {
+            uint32_t cap = dest->cap ? 2 * dest->cap : 4;
+            dest->conteneurs = (Conteneur *)mem_reallouer(dest->alloc, dest->conteneurs, cap * sizeof(Conteneur));
+            dest->cap = cap;
+        }
+        Conteneur *c = &dest->conteneurs[dest->nb++];
+        c->cle = x;
+        c->nb = n;
+        if (n > ENSEMBLE_TABLEAU_MAX) {
+            c->type = CONTENEUR_BITMAP;
+            c->taille = 0;
+            c->cap = 0;
+            c->donnees = mem_allouer(dest->alloc, MOTS_BITMAP * sizeof(uint64_t));
+            memcpy(c->donnees, mots, MOTS_BITMAP * sizeof(uint64_t));
+            continue;
+        }
+
+        uint16_t *t = (uint16_t *)mem_allouer(dest->alloc, n * sizeof(uint16_t));
+        uint32_t k = 0;
+        for (uint32_t m = 0; m < MOTS_BITMAP; m++) {
+            for (uint64_t w = mots[m]; w; w &= w - 1) t[k++] = (uint16_t)(m * 64 + bit_bas(w));
+        }
+        c->type = CONTENEUR_TABLEAU;
+        c->taille = n;
+        c->cap = n;
+        c->donnees = t;
+    }
+
+    mem_liberer(dest->alloc, mots);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_inclus
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste l’inclusion a ⊆ b, conteneur par conteneur (mot à mot
+ *  entre deux bitmaps).
+ *
+ * Paramètres :
+ *  - a, b : ensembles
+ *
+ * Valeur de retour :
+ *  - true si chaque identifiant de a est dans b
+ */
+bool ensemble_inclus(const EnsembleFaits *a, const EnsembleFaits *b) {
+    uint32_t j = 0;
+
+    for (uint32_t i = 0; i < a->nb; i++) {
+        const Conteneur *x = &a->conteneurs[i];
+        while (j < b->nb && b->conteneurs[j].cle < x->cle) j++;
+        if (j == b->nb || b->conteneurs[j].cle != x->cle) return false;
+
+        const Conteneur *y = &b->conteneurs[j];
+        if (x->nb > y->nb) return false;
+
+        if (x->type == CONTENEUR_BITMAP && y->type == CONTENEUR_BITMAP) {
+            const uint64_t *u = (const uint64_t *)x->donnees, *w = (const uint64_t *)y->donnees;
+            uint64_t hors = 0;
+            for (uint32_t k = 0; k < MOTS_BITMAP; k++) hors |= u[k] & ~w[k];
+            if (hors) return false;
+            continue;
+        }
+
+        Curseur k;
+        uint16_t v;
+        curseur_init(&k, x);
+        while (curseur_suivant(&k, &v)) {
+            if (!conteneur_contient(y, v)) return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_optimiser
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne à chaque conteneur sa forme la plus compacte : séquences
+ *  (4 octets par séquence), tableau (2 octets par valeur) ou
+ *  bitmap (8 Kio). Utile avant de conserver longtemps un ensemble
+ *  d’identifiants consécutifs.
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - nb_seq : nombre de séquences du conteneur
+ */
+void ensemble_optimiser(EnsembleFaits *E) {
+    for (uint32_t i = 0; i < E->nb; i++) {
+        Conteneur *c = &E->conteneurs[i];
+
+        uint32_t nb_seq = 0;
+        int32_t precedent = -2;
+        Curseur k;
+        uint16_t v;
+        curseur_init(&k, c);
+        while (curseur_suivant(&k, &v)) {
+            if ((int32_t)v != precedent + 1) nb_seq++;
+            precedent = v;
+        }
+
+        size_t seq = 4 * (size_t)nb_seq;
+        size_t tab = c->nb <= ENSEMBLE_TABLEAU_MAX ? 2 * (size_t)c->nb : SIZE_MAX;
+        size_t bit = MOTS_BITMAP * sizeof(uint64_t);
+
+        if (seq < tab && seq < bit) {
+            if (c->type != CONTENEUR_SEQUENCES) vers_sequences(E->alloc, c, nb_seq);
+        } else if (tab <= bit) {
+            if (c->type != CONTENEUR_TABLEAU) vers_tableau(E->alloc, c);
+            else if (c->cap > c->taille) {
+                c->donnees = mem_reallouer(E->alloc, c->donnees, c->taille * sizeof(uint16_t));
+                c->cap = c->taille;
+            }
+        } else if (c->type != CONTENEUR_BITMAP) {
+            vers_bitmap(E->alloc, c);
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_octets
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Mémoire occupée par l’ensemble (structure, répertoire des
+ *  conteneurs et données).
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *
+ * Valeur de retour :
+ *  - nombre d’octets
+ */
+size_t ensemble_octets(const EnsembleFaits *E) {
+    size_t n = sizeof(*E) + E->cap * sizeof(Conteneur);
+    for (uint32_t i = 0; i < E->nb; i++) {
+        const Conteneur *c = &E->conteneurs[i];
+        n += c->type == CONTENEUR_BITMAP ? MOTS_BITMAP * sizeof(uint64_t) : c->cap * sizeof(uint16_t);
+    }
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_vider
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire tous les identifiants (le répertoire est conservé).
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void ensemble_vider(EnsembleFaits *E) {
+    for (uint32_t i = 0; i < E->nb; i++) mem_liberer(E->alloc, E->conteneurs[i].donnees);
+    E->nb = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère toute la mémoire de l’ensemble.
+ *
+ * Paramètres :
+ *  - E : ensemble
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void ensemble_detruire(EnsembleFaits *E) {
+    ensemble_vider(E);
+    mem_liberer(E->alloc, E->conteneurs);
+    E->conteneurs = NULL;
+    E->cap = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ensemble_saturer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Chaînage avant sur un ensemble compressé : l’état propre à la
+ *  session se réduit à l’ensemble lui-même (pas de tableaux
+ *  denses par proposition ou par règle). Chaque fait nouveau
+ *  réveille les règles qui l’utilisent, dont les prémisses sont
+ *  testées en bloc par ensemble_contient_tous. Seul l’agenda
+ *  est alloué, le temps de l’appel.
+ *
+ * Paramètres :
+ *  - E : faits vrais (identifiants de C), enrichi
+ *  - C : BC compilée
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits
+ *
+ * Variables locales :
+ *  - agenda : faits à propager (initialement tout l’ensemble)
+ */
+size_t ensemble_saturer(EnsembleFaits *E, const BCCompilee *C) {
+    size_t cap = ensemble_cardinal(E) + 16;
+    PropId *agenda = (PropId *)mem_allouer(E->alloc, cap * sizeof(PropId));
+    size_t nb = ensemble_extraire(E, agenda);
+    size_t deduits = 0;
+
+    // Règles sans prémisse, puis propagation
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        if (C->regles[r].nb == 0 && ensemble_ajouter(E, C->regles[r].conclusion)) {
+            if (nb == cap) agenda = (PropId *)mem_reallouer(E->alloc, agenda, (cap *= 2) * sizeof(PropId));
+            agenda[nb++] = C->regles[r].conclusion;
+            deduits++;
+        }
+    }
+
+    size_t np = bcc_nb_propositions(C);
+    for (size_t curseur = 0; curseur < nb; curseur++) {
+        PropId p = agenda[curseur];
+        if (p >= np) continue;
+
+        for (uint32_t k = C->index_debut[p]; k < C->index_debut[p + 1]; k++) {
+            const RegleCompilee *R = &C->regles[C->index_regles[k]];
+            if (ensemble_contient(E, R->conclusion)) continue;
+            if (!ensemble_contient_tous(E, C->premisses + R->debut, R->nb)) continue;
+
+            ensemble_ajouter(E, R->conclusion);
+            if (nb == cap) agenda = (PropId *)mem_reallouer(E->alloc, agenda, (cap *= 2) * sizeof(PropId));
+            agenda[nb++] = R->conclusion;
+            deduits++;
+        }
+    }
+
+    mem_liberer(E->alloc, agenda);
+    return deduits;
+}
@@ -0,0 +1,68 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "alloc.h"
+#include "compile.h"
+
+/*
+ * Ensemble compressé d’identifiants de propositions (bitmap de type
+ * « roaring »). Les 16 bits de poids fort d’un identifiant choisissent
+ * un conteneur, les 16 bits de poids faible y sont rangés sous l’une
+ * de trois formes :
+ *  - tableau trié de uint16_t (au plus ENSEMBLE_TABLEAU_MAX valeurs) ;
+ *  - bitmap de 65536 bits (au-delà) ;
+ *  - séquences (début, longueur - 1), produites par ensemble_optimiser
+ *    quand elles sont plus compactes.
+ * Quelques milliers de faits épars coûtent ainsi quelques kilo-octets,
+ * quelle que soit la taille du vocabulaire.
+ */
+
+/* Cardinal maximal d’un conteneur tableau (4096 * 2 octets = un bitmap) */
+#define ENSEMBLE_TABLEAU_MAX 4096
+
+typedef enum {
+    CONTENEUR_TABLEAU,
+    CONTENEUR_BITMAP,
+    CONTENEUR_SEQUENCES
+} TypeConteneur;
+
+typedef struct {
+    uint16_t cle;       // 16 bits de poids fort
+    uint8_t type;       // TypeConteneur
+    uint32_t nb;        // cardinal (1 .. 65536)
+    uint32_t taille;    // tableau : nb ; séquences : nombre de séquences
+    uint32_t cap;       // capacité de "donnees" en uint16_t (tableau, séquences)
+    void *donnees;
+} Conteneur;
+
+typedef struct {
+    Conteneur *conteneurs;  // triés par clé
+    uint32_t nb;
+    uint32_t cap;
+    const Allocateur *alloc;
+} EnsembleFaits;
+
+void ensemble_init(EnsembleFaits *E);
+void ensemble_init_avec(EnsembleFaits *E, const Allocateur *A);
+bool ensemble_ajouter(EnsembleFaits *E, PropId id);
+bool ensemble_retirer(EnsembleFaits *E, PropId id);
+bool ensemble_contient(const EnsembleFaits *E, PropId id);
+bool ensemble_contient_tous(const EnsembleFaits *E, const PropId *ids, size_t n);
+size_t ensemble_cardinal(const EnsembleFaits *E);
+size_t ensemble_extraire(const EnsembleFaits *E, PropId *sortie);
+
+size_t ensemble_cardinal_intersection(const EnsembleFaits *a, const EnsembleFaits *b);
+void ensemble_intersection(EnsembleFaits *dest, const EnsembleFaits *a, const EnsembleFaits *b);
+bool ensemble_inclus(const EnsembleFaits *a, const EnsembleFaits *b);
+
+void ensemble_optimiser(EnsembleFaits *E);
+size_t ensemble_octets(const EnsembleFaits *E);
+void ensemble_vider(EnsembleFaits *E);
+void ensemble_detruire(EnsembleFaits *E);
+
+size_t ensemble_saturer(EnsembleFaits *E, const BCCompilee *C);
+
+#endif
@@ -0,0 +1,779 @@
+#include "facts.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compacter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Supprime les emplacements libérés du tableau d’ordre en
+ *  conservant l’ordre d’insertion, et met à jour l’emplacement
+ *  mémorisé dans l’index.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - n : nombre d’emplacements conservés
+ */
+static void compacter(BaseFaits *BF) {
+    size_t n = 0;
+
+    for (size_t i = 0; i < BF->nb_emplacements; i++) {
+        if (!BF->ordre[i]) continue;
+        BF->ordre[n] = BF->ordre[i];
+        if (BF->origine) BF->origine[n] = BF->origine[i];
+        hash_table_chercher(&BF->index, BF->ordre[n])->valeur = n;
+        n++;
+    }
+    BF->nb_emplacements = n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : noter_retour
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Empile une modification si un point de retour est posé.
+ *
+ * Paramètres :
+ *  - BF          : base de faits
+ *  - emplacement : emplacement ajouté ou libéré
+ *  - nom         : fait retiré (copié) ; NULL pour un ajout
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - e : entrée empilée
+ */
+static void noter_retour(BaseFaits *BF, size_t emplacement, const char *nom) {
+    if (!BF->retour_actif) return;
+
+    if (BF->nb_retour == BF->cap_retour) {
+        size_t cap = BF->cap_retour ? BF->cap_retour * 2 : 64;
+        BF->retour = (BFRetour *)mem_reallouer(BF->index.alloc, BF->retour, cap * sizeof(BFRetour));
+        BF->cap_retour = cap;
+    }
+    // Copie faite avant d’empiler : un échec d’allocation laisse la pile cohérente
+    char *copie = nom ? mem_dupliquer(BF->index.alloc, nom) : NULL;
+    BFRetour *e = &BF->retour[BF->nb_retour++];
+    e->emplacement = emplacement;
+    e->nom = copie;
+    e->origine = nom && BF->origine ? BF->origine[emplacement] : BF_ORIGINE_AUCUNE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : liberer_retour
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère la pile de retour (copies des faits retirés comprises)
+ *  et lève tous les points de retour.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void liberer_retour(BaseFaits *BF) {
+    for (size_t i = 0; i < BF->nb_retour; i++) mem_liberer(BF->index.alloc, BF->retour[i].nom);
+    mem_liberer(BF->index.alloc, BF->retour);
+    BF->retour = NULL;
+    BF->nb_retour = BF->cap_retour = 0;
+    BF->retour_actif = false;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une base de faits vide.
+ *
+ * Paramètres :
+ *  - BF : base de faits à initialiser
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_init(BaseFaits *BF) {
+    bf_init_avec(BF, NULL);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une base de faits vide dont l’index et le tableau
+ *  d’ordre sont alloués par l’allocateur donné.
+ *
+ * Paramètres :
+ *  - BF : base de faits à initialiser
+ *  - A  : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_init_avec(BaseFaits *BF, const Allocateur *A) {
+    hash_table_init_avec(&BF->index, A);
+    BF->ordre = NULL;
+    BF->origine = NULL;
+    BF->nb_emplacements = 0;
+    BF->cap = 0;
+    BF->size = 0;
+    BF->retour = NULL;
+    BF->nb_retour = BF->cap_retour = 0;
+    BF->retour_actif = false;
+    BF->base = NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_init_sur
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une couche vide au-dessus d’une base partagée.
+ *  Le coût (mémoire et temps) ne dépend pas de la taille de la
+ *  base : seule une table de HASH_TAILLE_INITIALE alvéoles est
+ *  allouée.
+ *
+ * Paramètres :
+ *  - BF   : couche à initialiser
+ *  - base : base partagée, inchangée tant que la couche existe
+ *  - A    : allocateur de la couche (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_init_sur(BaseFaits *BF, const BaseFaits *base, const Allocateur *A) {
+    bf_init_avec(BF, A);
+    BF->base = base;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_est_vide
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si la base de faits est vide.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - true si aucun fait n’est présent (couche et base)
+ */
+bool bf_est_vide(const BaseFaits *BF) {
+    return bf_taille(BF) == 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_taille
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne le nombre de faits présents.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - nombre de faits (couche et base)
+ */
+size_t bf_taille(const BaseFaits *BF) {
+    return BF->base ? BF->size + bf_taille(BF->base) : BF->size;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_contient
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste la présence d’un fait en O(1) via l’index haché (celui
+ *  de la couche, puis celui de la base).
+ *
+ * Paramètres :
+ *  - BF   : base de faits
+ *  - fait : proposition recherchée
+ *
+ * Valeur de retour :
+ *  - true  : le fait est présent
+ *  - false : il est absent
+ */
+bool bf_contient(const BaseFaits *BF, const char *fait) {
+    return hash_table_contains(&BF->index, fait) || (BF->base && bf_contient(BF->base, fait));
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_ajouter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un fait en fin d’ordre d’insertion s’il est absent.
+ *  La chaîne est stockée une seule fois (dans le nœud d’index).
+ *
+ * Paramètres :
+ *  - BF   : base de faits
+ *  - fait : proposition à ajouter
+ *
+ * Valeur de retour :
+ *  - true  : le fait a été ajouté
+ *  - false : il était déjà présent (dans la couche ou la base)
+ *
+ * Variables locales :
+ *  - nouveau : le fait était absent
+ *  - n       : nœud d’index du fait
+ */
+bool bf_ajouter(BaseFaits *BF, const char *fait) {
+    if (BF->base && bf_contient(BF->base, fait)) return false;
+    if (BF->nb_emplacements == BF->cap) bf_reserver(BF, 1);
+
+    bool nouveau;
+    HashNode *n = hash_table_inserer_unique(&BF->index, fait, BF->nb_emplacements, &nouveau);
+    if (!nouveau) return false;
+
+    noter_retour(BF, BF->nb_emplacements, NULL);
+    if (BF->origine) BF->origine[BF->nb_emplacements] = BF_ORIGINE_AUCUNE;
+    BF->ordre[BF->nb_emplacements++] = n->proposition;
+    BF->size++;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_reserver
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Prépare l’ajout de n faits supplémentaires : le tableau
+ *  d’ordre et l’index sont dimensionnés en une fois.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *  - n  : nombre de faits qui vont être ajoutés
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - cap : nouvelle capacité du tableau d’ordre
+ */
+void bf_reserver(BaseFaits *BF, size_t n) {
+    if (BF->nb_emplacements + n > BF->cap) {
+        size_t cap = BF->cap ? BF->cap : 16;
+        while (cap < BF->nb_emplacements + n) cap *= 2;
+        BF->ordre = (const char **)mem_reallouer(BF->index.alloc, (void *)BF->ordre, cap * sizeof(char *));
+        if (BF->origine) BF->origine = (uint64_t *)mem_reallouer(BF->index.alloc, BF->origine, cap * sizeof(uint64_t));
+        BF->cap = cap;
+    }
+    hash_table_reserver(&BF->index, BF->index.nb_elements + n);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_affirmer_lot
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un tableau de faits en une passe : capacité réservée
+ *  une seule fois, puis une recherche-insertion par fait (les
+ *  doublons, dans le lot ou avec la base, sont ignorés).
+ *
+ * Paramètres :
+ *  - BF    : base de faits
+ *  - faits : faits à ajouter, dans l’ordre d’insertion voulu
+ *  - n     : nombre de faits
+ *
+ * Valeur de retour :
+ *  - nombre de faits effectivement ajoutés
+ *
+ * Variables locales :
+ *  - ajoutes : nombre de faits nouveaux
+ *  - nouveau : le fait courant était absent
+ *  - noeud   : nœud d’index du fait courant
+ */
+size_t bf_affirmer_lot(BaseFaits *BF, const char *const *faits, size_t n) {
+    bf_reserver(BF, n);
+
+    size_t ajoutes = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (BF->base && bf_contient(BF->base, faits[i])) continue;
+        bool nouveau;
+        HashNode *noeud = hash_table_inserer_unique(&BF->index, faits[i], BF->nb_emplacements, &nouveau);
+        if (!nouveau) continue;
+
+        noter_retour(BF, BF->nb_emplacements, NULL);
+        if (BF->origine) BF->origine[BF->nb_emplacements] = BF_ORIGINE_AUCUNE;
+        BF->ordre[BF->nb_emplacements++] = noeud->proposition;
+        ajoutes++;
+    }
+    BF->size += ajoutes;
+    return ajoutes;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_supprimer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire un fait en O(1) amorti : son emplacement est libéré
+ *  et le tableau d’ordre n’est compacté que lorsque les
+ *  emplacements libres dépassent les faits présents (jamais sous
+ *  un point de retour).
+ *
+ * Paramètres :
+ *  - BF   : base de faits
+ *  - fait : proposition à retirer
+ *
+ * Valeur de retour :
+ *  - true  : le fait a été retiré
+ *  - false : il était absent de la couche (éventuellement présent
+ *            dans la base, qui n’est pas modifiée)
+ *
+ * Variables locales :
+ *  - n : nœud d’index du fait
+ */
+bool bf_supprimer(BaseFaits *BF, const char *fait) {
+    HashNode *n = hash_table_chercher(&BF->index, fait);
+    if (!n) return false;
+
+    noter_retour(BF, n->valeur, n->proposition);
+    BF->ordre[n->valeur] = NULL;
+    hash_table_supprimer(&BF->index, fait);
+    BF->size--;
+
+    if (!BF->retour_actif && BF->nb_emplacements - BF->size > BF->size) compacter(BF);
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_union
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute à la base tous les faits d’une autre base, dans leur
+ *  ordre d’insertion.
+ *
+ * Paramètres :
+ *  - BF    : base de faits enrichie
+ *  - autre : base de faits source
+ *
+ * Valeur de retour :
+ *  - nombre de faits effectivement ajoutés
+ */
+size_t bf_union(BaseFaits *BF, const BaseFaits *autre) {
+    size_t ajoutes = 0;
+    bf_reserver(BF, bf_taille(autre));
+
+    for (size_t i = 0; i < bf_nb_emplacements(autre); i++) {
+        const char *f = bf_emplacement(autre, i);
+        if (f && bf_ajouter(BF, f)) ajoutes++;
+    }
+    return ajoutes;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_vider
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire tous les faits (de la couche seulement) ; la base reste
+ *  utilisable. Sous un point de retour, les faits sont retirés un
+ *  à un (et empilés).
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_vider(BaseFaits *BF) {
+    if (BF->retour_actif) {
+        for (size_t i = 0; i < BF->nb_emplacements; i++) {
+            if (BF->ordre[i]) bf_supprimer(BF, BF->ordre[i]);
+        }
+        return;
+    }
+    hash_table_clear(&BF->index);
+    BF->nb_emplacements = 0;
+    BF->size = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère toute la mémoire de la base de faits.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_detruire(BaseFaits *BF) {
+    liberer_retour(BF);
+    hash_table_detruire(&BF->index);
+    mem_liberer(BF->index.alloc, (void *)BF->ordre);
+    mem_liberer(BF->index.alloc, BF->origine);
+    BF->ordre = NULL;
+    BF->origine = NULL;
+    BF->nb_emplacements = BF->cap = BF->size = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_activer_provenance
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Active l’enregistrement de la provenance : un tableau de
+ *  8 octets par emplacement, parallèle à l’ordre d’insertion.
+ *  Les faits déjà présents sont sans origine.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_activer_provenance(BaseFaits *BF) {
+    if (BF->origine) return;
+    BF->origine = (uint64_t *)mem_allouer(BF->index.alloc, (BF->cap ? BF->cap : 1) * sizeof(uint64_t));
+    for (size_t i = 0; i < BF->nb_emplacements; i++) BF->origine[i] = BF_ORIGINE_AUCUNE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_deduire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un fait déduit et, si la provenance est activée, note
+ *  la règle qui l’a produit (une écriture de 8 octets).
+ *
+ * Paramètres :
+ *  - BF    : base de faits
+ *  - fait  : proposition déduite
+ *  - regle : version de la règle dans la BC (bc_version), ou
+ *            BF_ORIGINE_INCONNUE
+ *
+ * Valeur de retour :
+ *  - true  : le fait a été ajouté
+ *  - false : il était déjà présent (provenance inchangée)
+ */
+bool bf_deduire(BaseFaits *BF, const char *fait, uint64_t regle) {
+    if (!bf_ajouter(BF, fait)) return false;
+    if (BF->origine) BF->origine[BF->nb_emplacements - 1] = regle;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_origine
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne la règle qui a déduit un fait.
+ *
+ * Paramètres :
+ *  - BF   : base de faits
+ *  - fait : proposition
+ *
+ * Valeur de retour :
+ *  - version de la règle dans la BC, au moment de la déduction
+ *  - BF_ORIGINE_INCONNUE : fait déduit par une règle non connue
+ *  - BF_ORIGINE_AUCUNE : fait absent, affirmé ou sans provenance
+ */
+uint64_t bf_origine(const BaseFaits *BF, const char *fait) {
+    const HashNode *n = hash_table_chercher(&BF->index, fait);
+    if (n) return BF->origine ? BF->origine[n->valeur] : BF_ORIGINE_AUCUNE;
+    return BF->base ? bf_origine(BF->base, fait) : BF_ORIGINE_AUCUNE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_point
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Pose un point de retour : les modifications suivantes
+ *  pourront être défaites par bf_revenir. Plusieurs points
+ *  peuvent être posés successivement (hypothèses imbriquées).
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - point à transmettre à bf_revenir (hauteur de la pile)
+ */
+size_t bf_point(BaseFaits *BF) {
+    BF->retour_actif = true;
+    return BF->nb_retour;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_revenir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Rétablit la base telle qu’elle était au point donné en
+ *  défaisant les modifications empilées depuis, de la plus
+ *  récente à la plus ancienne : un ajout est retiré (c’est alors
+ *  le dernier emplacement), un retrait est réinséré à son
+ *  emplacement avec sa provenance. Le coût ne dépend que du
+ *  nombre de modifications défaites. Le point reste utilisable
+ *  (les points posés après lui sont abandonnés).
+ *
+ * Paramètres :
+ *  - BF    : base de faits
+ *  - point : valeur retournée par bf_point
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - e : modification défaite
+ */
+void bf_revenir(BaseFaits *BF, size_t point) {
+    if (point >= BF->nb_retour) return;
+
+    TRACE_DEBUT("bf_revenir");
+    while (BF->nb_retour > point) {
+        BFRetour *e = &BF->retour[--BF->nb_retour];
+        if (!e->nom) {
+            hash_table_supprimer(&BF->index, BF->ordre[e->emplacement]);
+            BF->ordre[e->emplacement] = NULL;
+            BF->nb_emplacements = e->emplacement;
+            BF->size--;
+        } else {
+            HashNode *n = hash_table_inserer_valeur(&BF->index, e->nom, e->emplacement);
+            BF->ordre[e->emplacement] = n->proposition;
+            if (BF->origine) BF->origine[e->emplacement] = e->origine;
+            BF->size++;
+            mem_liberer(BF->index.alloc, e->nom);
+        }
+    }
+    TRACE_FIN("bf_revenir");
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_valider
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Abandonne tous les points de retour en gardant l’état
+ *  courant : la pile est libérée et le compactage reprend.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_valider(BaseFaits *BF) {
+    liberer_retour(BF);
+    if (BF->nb_emplacements - BF->size > BF->size) compacter(BF);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_nb_emplacements
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Borne du parcours dans l’ordre d’insertion. Les emplacements
+ *  de la base précèdent ceux de la couche.
+ *
+ * Paramètres :
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - nombre d’emplacements (faits présents et libérés)
+ */
+size_t bf_nb_emplacements(const BaseFaits *BF) {
+    return BF->base ? bf_nb_emplacements(BF->base) + BF->nb_emplacements : BF->nb_emplacements;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_emplacement
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne le fait rangé à un emplacement donné.
+ *
+ * Paramètres :
+ *  - BF  : base de faits
+ *  - pos : emplacement (< bf_nb_emplacements)
+ *
+ * Valeur de retour :
+ *  - le fait
+ *  - NULL si l’emplacement a été libéré
+ *
+ * Variables locales :
+ *  - nb_base : emplacements de la base
+ */
+const char *bf_emplacement(const BaseFaits *BF, size_t pos) {
+    if (BF->base) {
+        size_t nb_base = bf_nb_emplacements(BF->base);
+        if (pos < nb_base) return bf_emplacement(BF->base, pos);
+        pos -= nb_base;
+    }
+    return BF->ordre[pos];
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_afficher
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Affiche les faits dans l’ordre d’insertion (ceux de la base
+ *  d’abord), chacun précédé
+ *  d’un préfixe.
+ *
+ * Paramètres :
+ *  - BF     : base de faits
+ *  - prefix : chaîne affichée avant chaque fait
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_afficher(const BaseFaits *BF, const char *prefix) {
+    if (BF->base) bf_afficher(BF->base, prefix);
+    for (size_t i = 0; i < BF->nb_emplacements; i++) {
+        if (BF->ordre[i]) printf("%s%s\n", prefix, BF->ordre[i]);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_charger_flux
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit un fait par ligne (espaces de bord ignorés, lignes vides
+ *  et commentaires '#' sautés) et les ajoute en un seul lot. Le
+ *  flux est lu en entier dans un tampon découpé sur place : aucune
+ *  copie par fait hors de l’index.
+ *
+ * Paramètres :
+ *  - BF      : base de faits
+ *  - f       : flux ouvert en lecture
+ *  - ajoutes : reçoit le nombre de faits nouveaux (NULL accepté)
+ *
+ * Valeur de retour :
+ *  - true  : flux lu en entier
+ *  - false : erreur de lecture (rien n’est ajouté)
+ *
+ * Variables locales :
+ *  - tampon : contenu du flux
+ *  - faits  : début de chaque fait dans le tampon
+ *  - ligne  : ligne en cours de découpage
+ */
+bool bf_charger_flux(BaseFaits *BF, FILE *f, size_t *ajoutes) {
+    const Allocateur *A = BF->index.alloc;
+    size_t taille = 0, cap = 4096;
+    char *tampon = (char *)mem_allouer(A, cap);
+
+    // Lecture complète du flux
+    for (;;) {
+        if (taille + 1 == cap) {
+            cap *= 2;
+            tampon = (char *)mem_reallouer(A, tampon, cap);
+        }
+        size_t lus = fread(tampon + taille, 1, cap - 1 - taille, f);
+        taille += lus;
+        if (lus == 0) break;
+    }
+    tampon[taille] = '\0';
+    if (ferror(f)) {
+        mem_liberer(A, tampon);
+        return false;
+    }
+
+    // Découpage en lignes
+    size_t nb = 0, cap_faits = 64;
+    const char **faits = (const char **)mem_allouer(A, cap_faits * sizeof(char *));
+    for (char *ligne = tampon; ligne < tampon + taille;) {
+        char *fin = strchr(ligne, '\n');
+        char *suite = fin ? fin + 1 : tampon + taille;
+        if (!fin) fin = tampon + taille;
+
+        while (ligne < fin && isspace((unsigned char)*ligne)) ligne++;
+        while (fin > ligne && isspace((unsigned char)fin[-1])) fin--;
+        *fin = '\0';
+
+        if (*ligne != '\0' && *ligne != '#') {
+            if (nb == cap_faits) {
+                cap_faits *= 2;
+                faits = (const char **)mem_reallouer(A, (void *)faits, cap_faits * sizeof(char *));
+            }
+            faits[nb++] = ligne;
+        }
+        ligne = suite;
+    }
+
+    size_t n = bf_affirmer_lot(BF, faits, nb);
+    if (ajoutes) *ajoutes = n;
+
+    mem_liberer(A, (void *)faits);
+    mem_liberer(A, tampon);
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_charger_fichier
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Charge les faits d’un fichier texte (voir bf_charger_flux).
+ *
+ * Paramètres :
+ *  - BF      : base de faits
+ *  - chemin  : chemin du fichier de faits
+ *  - ajoutes : reçoit le nombre de faits nouveaux (NULL accepté)
+ *
+ * Valeur de retour :
+ *  - true  : fichier lu
+ *  - false : fichier introuvable ou illisible
+ */
+bool bf_charger_fichier(BaseFaits *BF, const char *chemin, size_t *ajoutes) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) {
+        perror(chemin);
+        return false;
+    }
+
+    TRACE_DEBUT("chargement_faits");
+    bool ok = bf_charger_flux(BF, f, ajoutes);
+    TRACE_FIN("chargement_faits");
+    fclose(f);
+    if (!ok) fprintf(stderr, "%s : erreur de lecture\n", chemin);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bf_stats
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Relève la taille de la base de faits, la mémoire de ses
+ *  tableaux et l’état de son index haché.
+ *
+ * Paramètres :
+ *  - BF : pointeur constant vers la base de faits
+ *  - s  : statistiques à remplir
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bf_stats(const BaseFaits *BF, StatsFaits *s) {
+    s->nb_faits = BF->size;
+    s->nb_emplacements = BF->nb_emplacements;
+    s->cap = BF->cap;
+    s->octets_ordre = BF->cap * sizeof(char *) + (BF->origine ? BF->cap * sizeof(uint64_t) : 0);
+    hash_table_stats(&BF->index, &s->index);
+}
@@ -0,0 +1,109 @@
+#ifndef FACTS_H
+#define FACTS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "hash.h"
+
+/*
+ * Base de faits : ordre d’insertion + index haché, toujours
+ * cohérents. Chaque nœud de l’index donne (valeur) l’emplacement
+ * du fait dans "ordre" ; un emplacement libéré vaut NULL jusqu’au
+ * prochain compactage.
+ * Provenance (facultative) : "origine", parallèle à "ordre", donne
+ * pour chaque fait déduit la version (bc_version : emplacement et
+ * contenu) de la règle qui l’a produit en premier (8 octets par
+ * fait).
+ * Points de retour (facultatifs) : tant qu’un point est posé, chaque
+ * ajout et chaque retrait est empilé dans "retour" et le compactage
+ * est suspendu, si bien que bf_revenir rétablit exactement la base
+ * (faits, emplacements, provenance) en défaisant les seules
+ * modifications postérieures au point, de la plus récente à la plus
+ * ancienne. Les points s’imbriquent : un point est une hauteur de
+ * pile.
+ * Couches (facultatives) : une base initialisée par bf_init_sur est
+ * une couche privée au-dessus d’une base partagée, jamais modifiée
+ * tant que des couches la référencent (typiquement saturée une fois
+ * puis lue par de nombreuses sessions, y compris en parallèle). La
+ * couche ne contient que ses propres faits ; les recherches
+ * consultent la couche puis la base, et le parcours donne les faits
+ * de la base puis ceux de la couche. Les faits de la base ne peuvent
+ * pas être retirés depuis la couche.
+ */
+typedef struct {
+    size_t emplacement;
+    char *nom;               // copie du fait retiré ; NULL : ajout
+    uint64_t origine;        // provenance du fait retiré
+} BFRetour;
+
+typedef struct BaseFaits {
+    HashTable index;
+    const char **ordre;      // chaînes possédées par les nœuds de l’index (allocateur de l’index)
+    uint64_t *origine;       // NULL : provenance non enregistrée
+    size_t nb_emplacements;
+    size_t cap;
+    size_t size;             // nombre de faits
+    BFRetour *retour;        // modifications depuis le premier point de retour
+    size_t nb_retour;
+    size_t cap_retour;
+    bool retour_actif;       // au moins un point de retour posé
+    const struct BaseFaits *base;   // couche inférieure partagée (NULL : aucune)
+} BaseFaits;
+
+/* Origine d’un fait affirmé (ou d’un fait sans provenance enregistrée) */
+#define BF_ORIGINE_AUCUNE UINT64_MAX
+/* Fait déduit dont la règle n’est pas connue (fermeture relue, Datalog, ...) */
+#define BF_ORIGINE_INCONNUE (UINT64_MAX - 1)
+
+void bf_init(BaseFaits *BF);
+void bf_init_avec(BaseFaits *BF, const Allocateur *A);
+void bf_init_sur(BaseFaits *BF, const BaseFaits *base, const Allocateur *A);
+bool bf_est_vide(const BaseFaits *BF);
+size_t bf_taille(const BaseFaits *BF);
+
+bool bf_contient(const BaseFaits *BF, const char *fait);
+bool bf_ajouter(BaseFaits *BF, const char *fait);
+
+/* Ajout en lot : une réservation, une recherche-insertion par fait */
+void bf_reserver(BaseFaits *BF, size_t n);
+size_t bf_affirmer_lot(BaseFaits *BF, const char *const *faits, size_t n);
+
+/* Format texte : un fait par ligne, '#' pour les commentaires */
+bool bf_charger_flux(BaseFaits *BF, FILE *f, size_t *ajoutes);
+bool bf_charger_fichier(BaseFaits *BF, const char *chemin, size_t *ajoutes);
+
+bool bf_supprimer(BaseFaits *BF, const char *fait);
+size_t bf_union(BaseFaits *BF, const BaseFaits *autre);
+void bf_vider(BaseFaits *BF);
+void bf_detruire(BaseFaits *BF);
+
+/* Provenance : règle (version dans la BC) qui a déduit chaque fait */
+void bf_activer_provenance(BaseFaits *BF);
+bool bf_deduire(BaseFaits *BF, const char *fait, uint64_t regle);
+uint64_t bf_origine(const BaseFaits *BF, const char *fait);
+
+/* Points de retour : poser (hauteur de pile), revenir, puis valider (garder l’état courant) */
+size_t bf_point(BaseFaits *BF);
+void bf_revenir(BaseFaits *BF, size_t point);
+void bf_valider(BaseFaits *BF);
+
+/* Parcours dans l’ordre d’insertion : ignorer les emplacements NULL */
+size_t bf_nb_emplacements(const BaseFaits *BF);
+const char *bf_emplacement(const BaseFaits *BF, size_t pos);
+
+void bf_afficher(const BaseFaits *BF, const char *prefix);
+
+/* Taille et mémoire de la BF (couche propre) ; index : santé de la table de hachage */
+typedef struct {
+    size_t nb_faits;
+    size_t nb_emplacements;   // dont emplacements libérés en attente de compactage
+    size_t cap;
+    size_t octets_ordre;      // tableaux ordre et origine
+    StatsHash index;
+} StatsFaits;
+
+void bf_stats(const BaseFaits *BF, StatsFaits *s);
+
+#endif
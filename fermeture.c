@@ -0,0 +1,394 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "fermeture.h"
+#include "trace.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAGIE_FERMETURE "LO21FRM1"
+
+/* En-tête du fichier, suivi de nb_entrees puis nb_faits identifiants (uint32_t) */
+typedef struct {
+    char magie[8];
+    uint64_t empreinte_bc;
+    uint64_t empreinte_entrees;
+    uint64_t controle;          // empreinte des deux tableaux d’identifiants
+    uint32_t nb_propositions;
+    uint32_t nb_entrees;
+    uint32_t nb_faits;
+    uint32_t reserve;
+} EnteteFermeture;
+
+/* FNV-1a 64 bits */
+#define FNV_BASE 0xcbf29ce484222325ULL
+#define FNV_PREMIER 0x100000001b3ULL
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : fnv
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Poursuit une empreinte FNV-1a 64 bits sur un bloc d’octets.
+ *
+ * Paramètres :
+ *  - h       : empreinte courante (FNV_BASE au départ)
+ *  - donnees : octets
+ *  - n       : nombre d’octets
+ *
+ * Valeur de retour :
+ *  - nouvelle empreinte
+ */
+static uint64_t fnv(uint64_t h, const void *donnees, size_t n) {
+    const unsigned char *p = (const unsigned char *)donnees;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= FNV_PREMIER;
+    }
+    return h;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : fermeture_empreinte_bc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Empreinte (version) d’une BC compilée : noms des propositions
+ *  dans l’ordre des identifiants, puis prémisses et conclusion de
+ *  chaque règle. Deux BC de même empreinte attribuent les mêmes
+ *  identifiants aux mêmes propositions.
+ *
+ * Paramètres :
+ *  - C : BC compilée
+ *
+ * Valeur de retour :
+ *  - empreinte 64 bits
+ *
+ * Variables locales :
+ *  - np : nombre de propositions
+ */
+uint64_t fermeture_empreinte_bc(const BCCompilee *C) {
+    size_t np = bcc_nb_propositions(C);
+    uint64_t h = fnv(FNV_BASE, &np, sizeof(np));
+
+    for (PropId p = 0; p < np; p++) {
+        const char *nom = symboles_nom(&C->symboles, p);
+        h = fnv(h, nom, strlen(nom) + 1);
+    }
+    h = fnv(h, &C->nb_regles, sizeof(C->nb_regles));
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        const RegleCompilee *R = &C->regles[r];
+        h = fnv(h, &R->nb, sizeof(R->nb));
+        h = fnv(h, C->premisses + R->debut, R->nb * sizeof(PropId));
+        h = fnv(h, &R->conclusion, sizeof(R->conclusion));
+    }
+    return h;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : comparer_ids
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ordre croissant des identifiants (pour qsort).
+ *
+ * Paramètres :
+ *  - a, b : pointeurs vers deux PropId
+ *
+ * Valeur de retour :
+ *  - négatif, nul ou positif
+ */
+static int comparer_ids(const void *a, const void *b) {
+    PropId x = *(const PropId *)a, y = *(const PropId *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : normaliser_entrees
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Copie les faits d’entrée connus de la BC, triés et sans
+ *  doublon : forme canonique hachée et comparée au fichier.
+ *
+ * Paramètres :
+ *  - entrees : faits d’entrée (ordre quelconque)
+ *  - n       : nombre de faits
+ *  - np      : nombre de propositions de la BC
+ *  - A       : allocateur
+ *  - nb      : reçoit le nombre d’entrées retenues
+ *
+ * Valeur de retour :
+ *  - tableau trié (à libérer)
+ */
+static PropId *normaliser_entrees(const PropId *entrees, size_t n, size_t np, const Allocateur *A, size_t *nb) {
+    PropId *t = (PropId *)mem_allouer(A, n * sizeof(PropId));
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (entrees[i] < np) t[k++] = entrees[i];
+    }
+    qsort(t, k, sizeof(PropId), comparer_ids);
+
+    size_t u = 0;
+    for (size_t i = 0; i < k; i++) {
+        if (u == 0 || t[u - 1] != t[i]) t[u++] = t[i];
+    }
+    *nb = u;
+    return t;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : inclus_trie
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si un tableau trié est inclus dans un autre (fusion).
+ *
+ * Paramètres :
+ *  - a, na : tableau trié supposé inclus
+ *  - b, nb : tableau trié
+ *
+ * Valeur de retour :
+ *  - true si chaque élément de a est dans b
+ */
+static bool inclus_trie(const PropId *a, size_t na, const PropId *b, size_t nb) {
+    size_t j = 0;
+    for (size_t i = 0; i < na; i++) {
+        while (j < nb && b[j] < a[i]) j++;
+        if (j == nb || b[j] != a[i]) return false;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : projeter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Projette un fichier de fermeture en mémoire (lecture seule)
+ *  et vérifie sa forme : en-tête, taille, identifiants bornés
+ *  par la BC et somme de contrôle.
+ *
+ * Paramètres :
+ *  - chemin : fichier
+ *  - np     : nombre de propositions de la BC
+ *  - taille : reçoit la taille de la projection
+ *
+ * Valeur de retour :
+ *  - projection (munmap), NULL si le fichier est absent ou invalide
+ */
+static const EnteteFermeture *projeter(const char *chemin, size_t np, size_t *taille) {
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void *carte = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(EnteteFermeture)) {
+        carte = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (carte == MAP_FAILED) return NULL;
+
+    *taille = (size_t)st.st_size;
+    const EnteteFermeture *e = (const EnteteFermeture *)carte;
+    const PropId *ids = (const PropId *)(e + 1);
+    size_t nb_ids = (size_t)e->nb_entrees + e->nb_faits;
+
+    bool ok = memcmp(e->magie, MAGIE_FERMETURE, sizeof(e->magie)) == 0 && e->nb_propositions == np &&
+              *taille == sizeof(*e) + nb_ids * sizeof(PropId) &&
+              fnv(FNV_BASE, ids, nb_ids * sizeof(PropId)) == e->controle;
+    for (size_t i = 0; ok && i < nb_ids; i++) {
+        if (ids[i] >= np) ok = false;
+    }
+    if (!ok) {
+        munmap(carte, *taille);
+        return NULL;
+    }
+    return e;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : fermeture_enregistrer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit la fermeture d’une session saturée et ses faits
+ *  d’entrée. Le fichier est écrit à côté puis renommé : un
+ *  lecteur voit l’ancienne ou la nouvelle fermeture, jamais un
+ *  fichier partiel.
+ *
+ * Paramètres :
+ *  - chemin     : fichier de fermeture
+ *  - C          : BC compilée
+ *  - entrees    : faits d’entrée triés, sans doublon
+ *  - nb_entrees : nombre de faits d’entrée
+ *  - S          : session saturée
+ *
+ * Valeur de retour :
+ *  - true si le fichier a été remplacé
+ */
+bool fermeture_enregistrer(const char *chemin, const BCCompilee *C, const PropId *entrees, size_t nb_entrees,
+                           const Session *S) {
+    EnteteFermeture e;
+    memset(&e, 0, sizeof(e));
+    memcpy(e.magie, MAGIE_FERMETURE, sizeof(e.magie));
+    e.empreinte_bc = fermeture_empreinte_bc(C);
+    e.empreinte_entrees = fnv(FNV_BASE, entrees, nb_entrees * sizeof(PropId));
+    e.controle = fnv(e.empreinte_entrees, S->faits, S->nb_faits * sizeof(PropId));
+    e.nb_propositions = (uint32_t)bcc_nb_propositions(C);
+    e.nb_entrees = (uint32_t)nb_entrees;
+    e.nb_faits = (uint32_t)S->nb_faits;
+
+    char *tmp = (char *)mem_allouer(NULL, strlen(chemin) + 5);
+    sprintf(tmp, "%s.tmp", chemin);
+
+    FILE *f = fopen(tmp, "wb");
+    bool ok = f && fwrite(&e, sizeof(e), 1, f) == 1 &&
+              fwrite(entrees, sizeof(PropId), nb_entrees, f) == nb_entrees &&
+              fwrite(S->faits, sizeof(PropId), S->nb_faits, f) == S->nb_faits &&
+              fflush(f) == 0 && fdatasync(fileno(f)) == 0;
+    if (f && fclose(f) != 0) ok = false;
+    ok = ok && rename(tmp, chemin) == 0;
+    if (!ok) {
+        perror(chemin);
+        unlink(tmp);
+    }
+    mem_liberer(NULL, tmp);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : fermeture_calculer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Amène une session à la fermeture de ses faits d’entrée en
+ *  repartant du fichier quand il correspond à la même BC :
+ *   - mêmes entrées : restauration sans propagation ;
+ *   - entrées incluses dans les nouvelles : restauration puis
+ *     propagation des seuls faits ajoutés (réutilisation pure si
+ *     les nouvelles entrées étaient déjà dans la fermeture) ;
+ *   - sinon : saturation complète.
+ *  Le fichier est réécrit si la fermeture a changé.
+ *
+ * Paramètres :
+ *  - chemin  : fichier de fermeture (créé s’il n’existe pas)
+ *  - S       : session sur la BC compilée
+ *  - entrees : faits d’entrée (ordre quelconque)
+ *  - n       : nombre de faits d’entrée
+ *  - bilan   : reçoit l’origine et la taille de la fermeture
+ *
+ * Valeur de retour :
+ *  - true si le fichier est à jour (la session est saturée dans
+ *    tous les cas)
+ *
+ * Variables locales :
+ *  - e      : en-tête projeté (NULL si fichier inutilisable)
+ *  - tries  : entrées sous forme canonique
+ */
+bool fermeture_calculer(const char *chemin, Session *S, const PropId *entrees, size_t n, BilanFermeture *bilan) {
+    TRACE_DEBUT("fermeture");
+    const BCCompilee *C = S->bc;
+    size_t np = bcc_nb_propositions(C);
+    size_t nb = 0;
+    PropId *tries = normaliser_entrees(entrees, n, np, S->alloc, &nb);
+    uint64_t empreinte = fnv(FNV_BASE, tries, nb * sizeof(PropId));
+
+    size_t taille = 0;
+    const EnteteFermeture *e = projeter(chemin, np, &taille);
+    if (e && e->empreinte_bc != fermeture_empreinte_bc(C)) {
+        munmap((void *)e, taille);
+        e = NULL;
+    }
+
+    bilan->origine = FERMETURE_CALCULEE;
+    if (e) {
+        const PropId *anciennes = (const PropId *)(e + 1);
+        if (e->empreinte_entrees == empreinte && e->nb_entrees == nb &&
+            memcmp(anciennes, tries, nb * sizeof(PropId)) == 0) {
+            bilan->origine = FERMETURE_REUTILISEE;
+        } else if (inclus_trie(anciennes, e->nb_entrees, tries, nb)) {
+            bilan->origine = FERMETURE_REPRISE;
+        }
+        if (bilan->origine != FERMETURE_CALCULEE) session_restaurer(S, anciennes + e->nb_entrees, e->nb_faits);
+        munmap((void *)e, taille);
+    }
+    if (bilan->origine == FERMETURE_CALCULEE) session_reinitialiser(S);
+
+    size_t avant = S->nb_faits;
+    session_affirmer_lot(S, tries, nb);
+    session_saturer(S);
+
+    // Entrées nouvelles toutes déjà dans la fermeture : elle est inchangée, le fichier reste valable
+    bool ok = true;
+    if (bilan->origine != FERMETURE_CALCULEE && S->nb_faits == avant) {
+        bilan->origine = FERMETURE_REUTILISEE;
+    } else {
+        ok = fermeture_enregistrer(chemin, C, tries, nb, S);
+    }
+    bilan->entrees = nb;
+    bilan->faits = S->nb_faits;
+    mem_liberer(S->alloc, tries);
+    TRACE_FIN("fermeture");
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : fermeture_inferer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Chaînage avant complet de la BF par la BC en s’appuyant sur
+ *  un fichier de fermeture : la BC est compilée, les faits de la
+ *  BF connus de la BC servent d’entrées, et la fermeture obtenue
+ *  est recopiée dans la BF. Chaque fait ajouté note la règle qui
+ *  l’a déduit ; ceux relus depuis le fichier sont notés déduits
+ *  sans règle connue (BF_ORIGINE_INCONNUE).
+ *
+ * Paramètres :
+ *  - BC     : base de connaissances
+ *  - BF     : base de faits (complétée)
+ *  - chemin : fichier de fermeture
+ *  - bilan  : reçoit l’origine de la fermeture et les faits ajoutés
+ *
+ * Valeur de retour :
+ *  - true si le fichier est à jour
+ *
+ * Variables locales :
+ *  - entrees : identifiants des faits de la BF
+ *  - r       : règle compilée qui a déduit le fait courant
+ */
+bool fermeture_inferer(const BaseConnaissances *BC, BaseFaits *BF, const char *chemin, BilanFermeture *bilan) {
+    BCCompilee C;
+    Session S;
+    bcc_compiler(&C, BC);
+    session_init(&S, &C);
+    session_activer_provenance(&S);
+
+    PropId *entrees = (PropId *)mem_allouer(S.alloc, bf_nb_emplacements(BF) * sizeof(PropId));
+    size_t n = 0;
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *fait = bf_emplacement(BF, i);
+        PropId p = fait ? symboles_chercher(&C.symboles, fait) : PROP_AUCUNE;
+        if (p != PROP_AUCUNE) entrees[n++] = p;
+    }
+
+    bool ok = fermeture_calculer(chemin, &S, entrees, n, bilan);
+
+    bilan->deduits = 0;
+    bf_reserver(BF, S.nb_faits);
+    for (size_t i = 0; i < S.nb_faits; i++) {
+        uint32_t r = S.regle[i];
+        uint64_t origine = r == SESSION_SANS_REGLE ? BF_ORIGINE_INCONNUE : bc_version(BC, C.emplacements[r]);
+        if (bf_deduire(BF, symboles_nom(&C.symboles, S.faits[i]), origine)) bilan->deduits++;
+    }
+
+    mem_liberer(S.alloc, entrees);
+    session_detruire(&S);
+    bcc_detruire(&C);
+    return ok;
+}
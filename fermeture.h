@@ -0,0 +1,45 @@
+#ifndef FERMETURE_H
+#define FERMETURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+#include "facts.h"
+#include "kb.h"
+
+/*
+ * Fermeture matérialisée sur disque. Le fichier contient, après un
+ * en-tête fixe, les faits d’entrée (identifiants triés) puis tous les
+ * faits de la fermeture (identifiants dans l’ordre de déduction). Il
+ * porte l’empreinte de la BC compilée (noms des propositions et
+ * règles) et celle des entrées :
+ *  - même BC, mêmes entrées (ou entrées ajoutées déjà présentes dans
+ *    la fermeture) : la fermeture est relue telle quelle (fichier
+ *    projeté en mémoire, aucune propagation) ;
+ *  - même BC, entrées enrichies : la fermeture est restaurée puis
+ *    seuls les nouveaux faits sont propagés (chaînage monotone) ;
+ *  - sinon : la fermeture est recalculée puis le fichier remplacé.
+ * Les entiers sont écrits dans l’ordre d’octets de la machine.
+ */
+
+typedef enum {
+    FERMETURE_CALCULEE,
+    FERMETURE_REUTILISEE,
+    FERMETURE_REPRISE
+} OrigineFermeture;
+
+typedef struct {
+    OrigineFermeture origine;
+    size_t entrees;     // faits d’entrée connus de la BC
+    size_t faits;       // taille de la fermeture
+    size_t deduits;     // faits ajoutés à la BF (fermeture_inferer)
+} BilanFermeture;
+
+uint64_t fermeture_empreinte_bc(const BCCompilee *C);
+bool fermeture_enregistrer(const char *chemin, const BCCompilee *C, const PropId *entrees, size_t nb_entrees,
+                           const Session *S);
+bool fermeture_calculer(const char *chemin, Session *S, const PropId *entrees, size_t n, BilanFermeture *bilan);
+bool fermeture_inferer(const BaseConnaissances *BC, BaseFaits *BF, const char *chemin, BilanFermeture *bilan);
+
+#endif
@@ -1,74 +1,76 @@
 #include "hash.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
 
 /*
  * ------------------------------------------------------------
- * Fonction : strdup_safe
+ * Fonction : hash_function
  * ------------------------------------------------------------
  * Rôle :
- *  Duplique une chaîne de caractères de manière portable,
- *  sans dépendre de la fonction strdup (non standard en C).
+ *  Calcule l’empreinte d’une chaîne de caractères à l’aide
+ *  d’une fonction de hachage simple basée sur une accumulation
+ *  multiplicative. L’indice d’alvéole est obtenu par réduction
+ *  modulo le nombre d’alvéoles courant.
  *
  * Paramètres :
- *  - s : pointeur vers la chaîne de caractères à dupliquer
+ *  - str : chaîne de caractères à hacher
  *
  * Valeur de retour :
- *  - pointeur vers une nouvelle chaîne allouée dynamiquement
- *  - NULL si la chaîne est NULL ou si l’allocation échoue
+ *  - empreinte complète de la chaîne
  *
  * Variables locales :
- *  - n : taille de la chaîne à copier (caractère nul inclus)
- *  - p : pointeur vers la zone mémoire allouée
+ *  - hash : valeur intermédiaire du calcul de hachage
  */
-static char *strdup_safe(const char *s) {
-    // Vérifie que la chaîne source existe
-    if (!s) {
-        return NULL;
-    }
-
-    // Calcul de la taille nécessaire pour la copie
-    size_t n = strlen(s) + 1;
+static size_t hash_function(const char *str) {
+    size_t hash = 0;
 
-    // Allocation dynamique de la mémoire
-    char *p = (char *)malloc(n);
-    if (!p) {
-        return NULL;
+    // Parcours de chaque caractère de la chaîne
+    while (*str) {
+        hash = (hash * 31) + (unsigned char)(*str++);
     }
 
-    // Copie du contenu de la chaîne source vers la nouvelle zone mémoire
-    memcpy(p, s, n);
-    return p;
+    return hash;
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : hash_function
+ * Fonction : redimensionner
  * ------------------------------------------------------------
  * Rôle :
- *  Calcule l’indice de hachage associé à une chaîne de caractères.
- *  Utilise une fonction de hachage simple basée sur une
- *  accumulation multiplicative.
+ *  Remplace le tableau d’alvéoles par un tableau de n alvéoles
+ *  et y rattache les nœuds existants (sans recopier les
+ *  propositions), afin de garder des chaînes de longueur
+ *  moyenne inférieure à 1.
  *
  * Paramètres :
- *  - str : chaîne de caractères à hacher
+ *  - ht : table de hachage
+ *  - n  : nouveau nombre d’alvéoles
  *
  * Valeur de retour :
- *  - indice compris entre 0 et HASH_SIZE - 1
+ *  - Aucune (void)
  *
  * Variables locales :
- *  - hash : valeur intermédiaire du calcul de hachage
+ *  - t       : nouveau tableau d’alvéoles
+ *  - current : nœud en cours de déplacement
  */
-static size_t hash_function(const char *str) {
-    size_t hash = 0;
+static void redimensionner(HashTable *ht, size_t n) {
+    HashNode **t = (HashNode **)mem_allouer_zero(ht->alloc, n * sizeof(HashNode *));
 
-    // Parcours de chaque caractère de la chaîne
-    while (*str) {
-        hash = (hash * 31) + (unsigned char)(*str++);
+    for (size_t i = 0; i < ht->nb_alveoles; i++) {
+        HashNode *current = ht->table[i];
+        while (current) {
+            HashNode *next = current->next;
+            size_t index = current->empreinte % n;
+            current->next = t[index];
+            t[index] = current;
+            current = next;
+        }
     }
 
-    // Réduction de la valeur pour rester dans les limites de la table
-    return hash % HASH_SIZE;
+    mem_liberer(ht->alloc, ht->table);
+    ht->table = t;
+    ht->nb_alveoles = n;
 }
 
 /*
@@ -76,68 +78,230 @@ static size_t hash_function(const char *str) {
  * Fonction : hash_table_init
  * ------------------------------------------------------------
  * Rôle :
- *  Initialise une table de hachage en mettant tous les
- *  pointeurs de listes à NULL.
+ *  Initialise une table de hachage vide de
+ *  HASH_TAILLE_INITIALE alvéoles.
  *
  * Paramètres :
  *  - ht : pointeur vers la table de hachage à initialiser
  *
  * Valeur de retour :
  *  - Aucune (void)
- *
- * Variables locales :
- *  - i : indice utilisé pour parcourir la table
  */
 void hash_table_init(HashTable *ht) {
+    hash_table_init_avec(ht, NULL);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une table de hachage vide dont les alvéoles, les
+ *  nœuds et les propositions sont alloués par l’allocateur donné.
+ *
+ * Paramètres :
+ *  - ht : pointeur vers la table de hachage à initialiser
+ *  - A  : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void hash_table_init_avec(HashTable *ht, const Allocateur *A) {
     // Vérifie que la table existe
     if (!ht) return;
 
-    // Initialisation de chaque case de la table
-    for (size_t i = 0; i < HASH_SIZE; i++) {
-        ht->table[i] = NULL;
-    }
+    ht->alloc = A ? A : &allocateur_systeme;
+    ht->nb_alveoles = HASH_TAILLE_INITIALE;
+    ht->nb_elements = 0;
+    ht->table = (HashNode **)mem_allouer_zero(ht->alloc, ht->nb_alveoles * sizeof(HashNode *));
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : hash_table_insert
+ * Fonction : hash_table_chercher
  * ------------------------------------------------------------
  * Rôle :
- *  Insère une proposition dans la table de hachage.
- *  Les collisions sont gérées par chaînage.
+ *  Recherche le nœud associé à une proposition.
  *
  * Paramètres :
  *  - ht          : pointeur vers la table de hachage
- *  - proposition: chaîne de caractères à insérer
+ *  - proposition : chaîne de caractères recherchée
  *
  * Valeur de retour :
- *  - Aucune (void)
+ *  - nœud contenant la proposition
+ *  - NULL si elle est absente
  *
  * Variables locales :
- *  - index    : indice calculé par la fonction de hachage
- *  - new_node : nouveau nœud inséré dans la table
+ *  - h       : empreinte de la proposition
+ *  - current : pointeur pour parcourir la liste chaînée
  */
-void hash_table_insert(HashTable *ht, const char *proposition) {
+HashNode *hash_table_chercher(const HashTable *ht, const char *proposition) {
     // Vérification des paramètres
-    if (!ht || !proposition) return;
+    if (!ht || !proposition) return NULL;
 
-    // Calcul de l’indice de hachage
-    size_t index = hash_function(proposition);
+    size_t h = hash_function(proposition);
+    HashNode *current = ht->table[h % ht->nb_alveoles];
 
-    // Allocation d’un nouveau nœud
-    HashNode *new_node = (HashNode *)malloc(sizeof(HashNode));
-    if (!new_node) return;
-
-    // Duplication de la proposition
-    new_node->proposition = strdup_safe(proposition);
-    if (!new_node->proposition) {
-        free(new_node);
-        return;
+    // Parcours de la chaîne : l’empreinte évite la plupart des strcmp
+    while (current) {
+        if (current->empreinte == h && strcmp(current->proposition, proposition) == 0) {
+            return current;
+        }
+        current = current->next;
     }
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : inserer_noeud
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Crée le nœud d’une proposition absente dont l’empreinte est
+ *  déjà calculée et l’insère en tête de son alvéole.
+ *
+ * Paramètres :
+ *  - ht          : pointeur vers la table de hachage
+ *  - proposition : chaîne de caractères à insérer (absente)
+ *  - h           : empreinte de la proposition
+ *  - valeur      : donnée associée
+ *
+ * Valeur de retour :
+ *  - nœud créé
+ *
+ * Variables locales :
+ *  - n        : taille de la proposition (caractère nul inclus)
+ *  - new_node : nouveau nœud inséré dans la table
+ *  - index    : alvéole de la proposition
+ */
+static HashNode *inserer_noeud(HashTable *ht, const char *proposition, size_t h, size_t valeur) {
+    // Un seul bloc par nœud : le nœud suivi de la proposition
+    size_t n = strlen(proposition) + 1;
+    HashNode *new_node = (HashNode *)mem_allouer(ht->alloc, sizeof(HashNode) + n);
+    new_node->proposition = (char *)(new_node + 1);
+    memcpy(new_node->proposition, proposition, n);
+    new_node->empreinte = h;
+    new_node->valeur = valeur;
 
     // Insertion du nœud en tête de la liste chaînée
+    size_t index = h % ht->nb_alveoles;
     new_node->next = ht->table[index];
     ht->table[index] = new_node;
+
+    // Facteur de charge maximal : 1
+    if (++ht->nb_elements > ht->nb_alveoles) redimensionner(ht, ht->nb_alveoles * 2);
+    return new_node;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_inserer_valeur
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Insère une proposition absente de la table en lui associant
+ *  une valeur. Les collisions sont gérées par chaînage.
+ *
+ * Paramètres :
+ *  - ht          : pointeur vers la table de hachage
+ *  - proposition : chaîne de caractères à insérer (absente)
+ *  - valeur      : donnée associée
+ *
+ * Valeur de retour :
+ *  - nœud créé (sa proposition est une copie stable tant que
+ *    le nœud existe)
+ *  - NULL si les paramètres sont invalides
+ */
+HashNode *hash_table_inserer_valeur(HashTable *ht, const char *proposition, size_t valeur) {
+    // Vérification des paramètres
+    if (!ht || !proposition) return NULL;
+
+    return inserer_noeud(ht, proposition, hash_function(proposition), valeur);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_inserer_unique
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Recherche une proposition et l’insère avec la valeur donnée
+ *  si elle est absente, en ne calculant son empreinte qu’une
+ *  seule fois.
+ *
+ * Paramètres :
+ *  - ht          : pointeur vers la table de hachage
+ *  - proposition : chaîne de caractères
+ *  - valeur      : donnée associée en cas d’insertion
+ *  - nouveau     : reçoit true si le nœud vient d’être créé
+ *
+ * Valeur de retour :
+ *  - nœud existant ou créé
+ *  - NULL si les paramètres sont invalides
+ *
+ * Variables locales :
+ *  - h       : empreinte de la proposition
+ *  - current : pointeur pour parcourir la liste chaînée
+ */
+HashNode *hash_table_inserer_unique(HashTable *ht, const char *proposition, size_t valeur, bool *nouveau) {
+    *nouveau = false;
+    if (!ht || !proposition) return NULL;
+
+    size_t h = hash_function(proposition);
+    for (HashNode *current = ht->table[h % ht->nb_alveoles]; current; current = current->next) {
+        if (current->empreinte == h && strcmp(current->proposition, proposition) == 0) {
+            return current;
+        }
+    }
+
+    *nouveau = true;
+    return inserer_noeud(ht, proposition, h, valeur);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_reserver
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Prépare la table à contenir n éléments au total sans
+ *  redimensionnement : le nombre d’alvéoles est porté en une
+ *  seule fois à la première puissance de 2 suffisante.
+ *
+ * Paramètres :
+ *  - ht : pointeur vers la table de hachage
+ *  - n  : nombre total d’éléments attendu
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - alveoles : nombre d’alvéoles visé
+ */
+void hash_table_reserver(HashTable *ht, size_t n) {
+    if (!ht) return;
+
+    size_t alveoles = ht->nb_alveoles;
+    while (alveoles < n) alveoles *= 2;
+    if (alveoles != ht->nb_alveoles) redimensionner(ht, alveoles);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_insert
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Insère une proposition dans la table de hachage si elle
+ *  n’y figure pas déjà.
+ *
+ * Paramètres :
+ *  - ht          : pointeur vers la table de hachage
+ *  - proposition : chaîne de caractères à insérer
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void hash_table_insert(HashTable *ht, const char *proposition) {
+    if (!hash_table_chercher(ht, proposition)) {
+        hash_table_inserer_valeur(ht, proposition, 0);
+    }
 }
 
 /*
@@ -150,33 +314,51 @@ void hash_table_insert(HashTable *ht, const char *proposition) {
  *
  * Paramètres :
  *  - ht          : pointeur vers la table de hachage
- *  - proposition: chaîne de caractères recherchée
+ *  - proposition : chaîne de caractères recherchée
  *
  * Valeur de retour :
  *  - true  : la proposition est trouvée
  *  - false : la proposition est absente
+ */
+bool hash_table_contains(const HashTable *ht, const char *proposition) {
+    return hash_table_chercher(ht, proposition) != NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_supprimer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire une proposition de la table et libère son nœud.
+ *
+ * Paramètres :
+ *  - ht          : pointeur vers la table de hachage
+ *  - proposition : chaîne de caractères à retirer
+ *
+ * Valeur de retour :
+ *  - true  : la proposition a été retirée
+ *  - false : elle était absente
  *
  * Variables locales :
- *  - index   : indice de hachage correspondant à la proposition
- *  - current : pointeur pour parcourir la liste chaînée
+ *  - h    : empreinte de la proposition
+ *  - lien : pointeur vers le lien menant au nœud courant
  */
-bool hash_table_contains(const HashTable *ht, const char *proposition) {
-    // Vérification des paramètres
+bool hash_table_supprimer(HashTable *ht, const char *proposition) {
     if (!ht || !proposition) return false;
 
-    // Calcul de l’indice de hachage
-    size_t index = hash_function(proposition);
-    const HashNode *current = ht->table[index];
+    size_t h = hash_function(proposition);
+    HashNode **lien = &ht->table[h % ht->nb_alveoles];
 
-    // Parcours de la liste chaînée associée à l’indice
-    while (current) {
-        if (strcmp(current->proposition, proposition) == 0) {
+    while (*lien) {
+        HashNode *current = *lien;
+        if (current->empreinte == h && strcmp(current->proposition, proposition) == 0) {
+            *lien = current->next;
+            mem_liberer(ht->alloc, current);
+            ht->nb_elements--;
             return true;
         }
-        current = current->next;
+        lien = &current->next;
     }
-
-    // Proposition non trouvée
     return false;
 }
 
@@ -185,11 +367,11 @@ bool hash_table_contains(const HashTable *ht, const char *proposition) {
  * Fonction : hash_table_clear
  * ------------------------------------------------------------
  * Rôle :
- *  Libère toute la mémoire utilisée par la table de hachage
- *  et remet toutes les cases à NULL.
+ *  Libère tous les nœuds de la table de hachage. La table reste
+ *  utilisable (ses alvéoles sont conservées).
  *
  * Paramètres :
- *  - ht : pointeur vers la table de hachage à libérer
+ *  - ht : pointeur vers la table de hachage à vider
  *
  * Valeur de retour :
  *  - Aucune (void)
@@ -204,18 +386,82 @@ void hash_table_clear(HashTable *ht) {
     if (!ht) return;
 
     // Parcours de chaque case de la table
-    for (size_t i = 0; i < HASH_SIZE; i++) {
+    for (size_t i = 0; i < ht->nb_alveoles; i++) {
         HashNode *current = ht->table[i];
 
         // Libération de la liste chaînée
         while (current) {
             HashNode *next = current->next;
-            free(current->proposition);
-            free(current);
+            mem_liberer(ht->alloc, current);
             current = next;
         }
 
         // Réinitialisation de la case
         ht->table[i] = NULL;
     }
+    ht->nb_elements = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vide la table puis libère son tableau d’alvéoles.
+ *
+ * Paramètres :
+ *  - ht : pointeur vers la table de hachage à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void hash_table_detruire(HashTable *ht) {
+    if (!ht) return;
+
+    hash_table_clear(ht);
+    mem_liberer(ht->alloc, ht->table);
+    ht->table = NULL;
+    ht->nb_alveoles = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hash_table_stats
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Relève l’occupation de la table : alvéoles occupées, plus
+ *  longue chaîne, facteur de charge, longueur moyenne de sondage
+ *  d’une recherche fructueuse (le k-ième nœud d’une chaîne coûte
+ *  k comparaisons d’empreintes) et mémoire utilisée. Coût
+ *  proportionnel au nombre d’alvéoles et d’éléments.
+ *
+ * Paramètres :
+ *  - ht : table de hachage
+ *  - s  : statistiques à remplir
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - sondes : somme des rangs de tous les nœuds dans leur chaîne
+ */
+void hash_table_stats(const HashTable *ht, StatsHash *s) {
+    memset(s, 0, sizeof(*s));
+    if (!ht || !ht->table) return;
+
+    size_t sondes = 0;
+    s->nb_alveoles = ht->nb_alveoles;
+    s->nb_elements = ht->nb_elements;
+    s->octets = ht->nb_alveoles * sizeof(HashNode *);
+    for (size_t i = 0; i < ht->nb_alveoles; i++) {
+        size_t longueur = 0;
+        for (const HashNode *n = ht->table[i]; n; n = n->next) {
+            sondes += ++longueur;
+            s->octets += sizeof(HashNode) + strlen(n->proposition) + 1;
+        }
+        if (longueur) s->alveoles_occupees++;
+        if (longueur > s->chaine_max) s->chaine_max = longueur;
+    }
+    s->charge = (double)ht->nb_elements / (double)ht->nb_alveoles;
+    s->sondes_presente = ht->nb_elements ? (double)sondes / (double)ht->nb_elements : 0.0;
 }
@@ -3,22 +3,54 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include "alloc.h"
 
-#define HASH_SIZE 1000
+/* Nombre d’alvéoles d’une table neuve (doublé quand la charge dépasse 1) */
+#define HASH_TAILLE_INITIALE 16
 
 typedef struct HashNode {
-    char *proposition;
+    char *proposition;       // rangée dans le même bloc que le nœud
+    size_t empreinte;        // valeur complète de la fonction de hachage
+    size_t valeur;           // donnée associée (libre pour l’appelant)
     struct HashNode *next;
 } HashNode;
 
 typedef struct HashTable {
-    HashNode *table[HASH_SIZE];
+    HashNode **table;
+    size_t nb_alveoles;
+    size_t nb_elements;
+    const Allocateur *alloc;
 } HashTable;
 
 void hash_table_init(HashTable *ht);
+void hash_table_init_avec(HashTable *ht, const Allocateur *A);
 void hash_table_insert(HashTable *ht, const char *proposition);
 bool hash_table_contains(const HashTable *ht, const char *proposition);
 void hash_table_clear(HashTable *ht);
 
-#endif
+HashNode *hash_table_chercher(const HashTable *ht, const char *proposition);
+HashNode *hash_table_inserer_valeur(HashTable *ht, const char *proposition, size_t valeur);
+HashNode *hash_table_inserer_unique(HashTable *ht, const char *proposition, size_t valeur, bool *nouveau);
+void hash_table_reserver(HashTable *ht, size_t n);
+bool hash_table_supprimer(HashTable *ht, const char *proposition);
+void hash_table_detruire(HashTable *ht);
+
+/*
+ * Santé de la table, relevée par un parcours des alvéoles (aucun
+ * compteur sur le chemin des recherches). Une recherche infructueuse
+ * examine en moyenne "charge" nœuds. Les octets sont ceux demandés
+ * à l’allocateur (alvéoles, nœuds et propositions).
+ */
+typedef struct {
+    size_t nb_alveoles;
+    size_t nb_elements;
+    size_t alveoles_occupees;
+    size_t chaine_max;        // plus longue chaîne
+    double charge;            // éléments par alvéole
+    double sondes_presente;   // nœuds examinés en moyenne pour trouver un élément présent
+    size_t octets;
+} StatsHash;
 
+void hash_table_stats(const HashTable *ht, StatsHash *s);
+
+#endif
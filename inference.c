@@ -1,72 +1,336 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "inference.h"
-#include "hash.h"
+#include "compile.h"
 #include "kb.h"
 #include "rule.h"
 #include "list.h"
+#include "trace.h"
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
 
 /*
  * ------------------------------------------------------------
- * Fonction : inference
+ * Fonction : toutes_premisses_vraies
  * ------------------------------------------------------------
  * Rôle :
- *  Cette fonction synchronise la table de hachage avec la base
- *  de faits courante. Elle vide complètement la table de hachage
- *  puis y réinsère tous les faits présents dans la base de faits.
+ *  Vérifie si toutes les prémisses d’une règle sont présentes
+ *  dans la base de faits (une recherche hachée par prémisse).
  *
  * Paramètres :
- *  - BF : pointeur vers la base de faits contenant les faits actuels
- *  - ht : pointeur vers la table de hachage à synchroniser
+ *  - R  : pointeur vers la règle dont on veut tester les prémisses
+ *  - BF : pointeur vers la base de faits actuelle
+ *
+ * Valeur de retour :
+ *  - true  : toutes les prémisses sont présentes dans la base de faits
+ *  - false : au moins une prémisse est absente
+ *
+ * Variables locales :
+ *  - i : position de la prémisse courante
+ */
+bool toutes_premisses_vraies(const Regle *R, const BaseFaits *BF) {
+    // Parcours de toutes les prémisses de la règle
+    for (size_t i = 0; i < R->premisses.size; i++) {
+        // Si une prémisse n’est pas trouvée dans la base de faits,
+        // la règle ne peut pas être appliquée
+        if (!bf_contient(BF, liste_element(&R->premisses, i))) return false;
+    }
+
+    // Toutes les prémisses sont présentes
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : options_inference_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise des options sans cible ni budget : le moteur va
+ *  jusqu’à la saturation et affiche ses déductions.
+ *
+ * Paramètres :
+ *  - O : options à initialiser
  *
  * Valeur de retour :
  *  - Aucune (void)
+ */
+void options_inference_init(OptionsInference *O) {
+    O->cibles = NULL;
+    O->nb_cibles = 0;
+    O->max_tours = 0;
+    O->max_declenchements = 0;
+    O->max_deduits = 0;
+    O->delai_us = 0;
+    O->silencieux = false;
+    O->base_possible = NULL;
+    O->nb_base_possible = 0;
+    O->profil = NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : horloge_us
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit l’horloge monotone.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - temps courant en microsecondes
+ */
+static uint64_t horloge_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : cible_atteinte
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Recherche parmi les cibles celle qui est égale à un fait.
+ *
+ * Paramètres :
+ *  - O    : options (cibles)
+ *  - fait : fait à comparer
+ *
+ * Valeur de retour :
+ *  - la cible correspondante
+ *  - NULL si le fait n’est pas une cible
+ */
+static const char *cible_atteinte(const OptionsInference *O, const char *fait) {
+    for (size_t i = 0; i < O->nb_cibles; i++) {
+        if (strcmp(O->cibles[i], fait) == 0) return O->cibles[i];
+    }
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : regles_actives
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Liste les règles (avec conclusion) examinées à chaque tour.
+ *  Si des propositions de base sont déclarées, seules les règles
+ *  atteignables depuis elles et depuis les faits déjà connus sont
+ *  retenues : la BC est compilée une fois pour parcourir le graphe
+ *  prémisses -> conclusions (bcc_atteignables).
+ *
+ * Paramètres :
+ *  - BC       : base de connaissances
+ *  - BF       : base de faits (faits déjà connus)
+ *  - O        : options (base_possible)
+ *  - nb       : reçoit le nombre de règles retenues
+ *  - elaguees : reçoit le nombre de règles écartées
+ *
+ * Valeur de retour :
+ *  - tableau des règles retenues, dans l’ordre de la BC (à libérer)
  *
  * Variables locales :
- *  - p : pointeur permettant de parcourir la liste chaînée des faits
+ *  - C      : BC compilée (même ordre de règles que la BC)
+ *  - base   : identifiants des propositions de base
+ *  - garder : par règle compilée, 1 si atteignable
  */
-void inference(BaseConnaissances *BF, HashTable *ht){
-    // Suppression de tous les éléments actuellement stockés dans la table
-    hash_table_clear(ht);
+static RegleId *regles_actives(const BaseConnaissances *BC, const BaseFaits *BF, const OptionsInference *O,
+                               size_t *nb, size_t *elaguees) {
+    RegleId *actives = (RegleId *)mem_allouer(NULL, BC->size * sizeof(RegleId));
+    *nb = *elaguees = 0;
+
+    if (!O->base_possible) {
+        for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+            if (regle_obtenir_conclusion(bc_regle(BC, id))) actives[(*nb)++] = id;
+        }
+        return actives;
+    }
 
-    // Réinitialisation de la table de hachage (table vide et prête à l’usage)
-    hash_table_init(ht);
+    TRACE_DEBUT("elagage");
+    BCCompilee C;
+    bcc_compiler(&C, BC);
 
-    // Parcours de tous les faits présents dans la base de faits
-    for (ListNode *p = BF->head; p != NULL; p = p->next) {
-        // Insertion de chaque fait dans la table de hachage
-        hash_table_insert(ht, p->s);
+    size_t n = 0;
+    PropId *base = (PropId *)mem_allouer(NULL, (O->nb_base_possible + bf_nb_emplacements(BF)) * sizeof(PropId));
+    for (size_t i = 0; i < O->nb_base_possible; i++) {
+        PropId p = symboles_chercher(&C.symboles, O->base_possible[i]);
+        if (p != PROP_AUCUNE) base[n++] = p;
     }
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *f = bf_emplacement(BF, i);
+        PropId p = f ? symboles_chercher(&C.symboles, f) : PROP_AUCUNE;
+        if (p != PROP_AUCUNE) base[n++] = p;
+    }
+
+    uint8_t *garder = (uint8_t *)mem_allouer(NULL, C.nb_regles);
+    bcc_atteignables(&C, base, n, garder);
+
+    // bcc_compiler range les règles avec conclusion dans l’ordre de la BC
+    size_t r = 0;
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        if (!regle_obtenir_conclusion(bc_regle(BC, id))) continue;
+        if (garder[r++]) actives[(*nb)++] = id;
+        else (*elaguees)++;
+    }
+
+    mem_liberer(NULL, garder);
+    mem_liberer(NULL, base);
+    bcc_detruire(&C);
+    TRACE_FIN("elagage");
+    return actives;
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : toutes_premisses_vraies
+ * Fonction : profiler_premisses
  * ------------------------------------------------------------
  * Rôle :
- *  Vérifie si toutes les prémisses d’une règle sont présentes
- *  dans la base de faits.
+ *  Note dans le profil, pour la requête qui s’achève, la valeur
+ *  finale de chaque prémisse des règles examinées.
  *
  * Paramètres :
- *  - R  : pointeur vers la règle dont on veut tester les prémisses
- *  - BF : pointeur vers la base de faits actuelle
+ *  - BC         : base de connaissances
+ *  - BF         : base de faits en fin d’inférence
+ *  - P          : profil à enrichir
+ *  - actives    : règles examinées
+ *  - nb_actives : nombre de règles examinées
  *
  * Valeur de retour :
- *  - true  : toutes les prémisses sont présentes dans la base de faits
- *  - false : au moins une prémisse est absente
+ *  - Aucune (void)
+ */
+static void profiler_premisses(const BaseConnaissances *BC, const BaseFaits *BF, ProfilPremisses *P,
+                               const RegleId *actives, size_t nb_actives) {
+    profil_commencer(P);
+    for (size_t k = 0; k < nb_actives; k++) {
+        const Regle *R = bc_regle(BC, actives[k]);
+        for (size_t i = 0; i < R->premisses.size; i++) {
+            const char *p = liste_element(&R->premisses, i);
+            profil_noter(P, p, bf_contient(BF, p));
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : moteur_inference_opts
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Chaînage avant avec conditions d’arrêt : le moteur s’arrête
+ *  dès qu’une cible est connue, ou quand un budget est épuisé
+ *  (tours, déclenchements de règles, faits déduits, délai).
+ *  Une règle se déclenche quand ses prémisses sont vraies et que
+ *  sa conclusion est nouvelle. Le délai est vérifié entre deux
+ *  règles toutes les 64 règles examinées. Si O->base_possible
+ *  est fourni, les règles qui ne peuvent pas se déclencher à
+ *  partir de ces propositions (et des faits déjà connus) sont
+ *  écartées avant le premier tour.
+ *
+ * Paramètres :
+ *  - BC : base de connaissances
+ *  - BF : base de faits à enrichir
+ *  - O  : options (NULL : saturation complète, avec affichage)
+ *
+ * Valeur de retour :
+ *  - bilan de l’exécution ; r.complete indique si la fermeture
+ *    a été atteinte (aucune règle ne peut plus se déclencher)
  *
  * Variables locales :
- *  - p : pointeur permettant de parcourir la liste des prémisses
+ *  - r        : bilan retourné
+ *  - echeance : instant limite (0 si aucun délai)
+ *  - examens  : règles examinées (cadence du contrôle du délai)
+ *  - nouveau  : un fait a été ajouté pendant le tour
+ *  - actives  : règles examinées à chaque tour
  */
-bool toutes_premisses_vraies(const Regle *R, const BaseFaits *BF) {
-    // Parcours de toutes les prémisses de la règle
-    for (ListNode *p = R->premisses.head; p; p = p->next) {
-        // Si une prémisse n’est pas trouvée dans la base de faits,
-        // la règle ne peut pas être appliquée
-        if (!liste_contient_rec(BF, p->s)) return false;
+ResultatInference moteur_inference_opts(const BaseConnaissances *BC, BaseFaits *BF,
+                                        const OptionsInference *O) {
+    OptionsInference defaut;
+    if (!O) {
+        options_inference_init(&defaut);
+        O = &defaut;
     }
 
-    // Toutes les prémisses sont présentes
-    return true;
+    ResultatInference r = {INFERENCE_SATUREE, true, 0, 0, 0, NULL, 0};
+    uint64_t echeance = O->delai_us ? horloge_us() + O->delai_us : 0;
+    unsigned examens = 0;
+    TRACE_DEBUT("moteur_inference");
+    size_t nb_actives;
+    RegleId *actives = regles_actives(BC, BF, O, &nb_actives, &r.elaguees);
+
+    // Une cible déjà connue termine immédiatement
+    for (size_t i = 0; i < O->nb_cibles && !r.cible; i++) {
+        if (bf_contient(BF, O->cibles[i])) r.cible = O->cibles[i];
+    }
+    if (r.cible) {
+        r.arret = INFERENCE_CIBLE;
+        r.complete = false;
+    }
+
+    // Boucle principale : continue tant que de nouveaux faits sont déduits
+    bool nouveau = !r.cible;
+    while (nouveau) {
+        if (O->max_tours && r.tours == O->max_tours) {
+            r.arret = INFERENCE_TOURS;
+            break;
+        }
+        nouveau = false;
+        r.tours++;
+        TRACE_DEBUT("tour");
+
+        // Parcours des règles de la base de connaissances (sauf règles élaguées)
+        for (size_t k = 0; k < nb_actives; k++) {
+            if (echeance && (++examens & 63) == 0 && horloge_us() >= echeance) {
+                r.arret = INFERENCE_DELAI;
+                break;
+            }
+
+            const Regle *R = bc_regle(BC, actives[k]);
+            const char *c = regle_obtenir_conclusion(R);
+
+            // Règle applicable : prémisses vraies et conclusion nouvelle
+            if (bf_contient(BF, c) || !toutes_premisses_vraies(R, BF)) continue;
+
+            r.declenchements++;
+            if (bf_deduire(BF, c, bc_version(BC, (uint32_t)actives[k]))) {
+                r.deduits++;
+                nouveau = true;
+                if (!O->silencieux) printf(">> Nouvelle déduction : %s\n", c);
+            }
+
+            // Conditions d’arrêt liées à la déduction
+            if (O->nb_cibles && (r.cible = cible_atteinte(O, c)) != NULL) {
+                r.arret = INFERENCE_CIBLE;
+                break;
+            }
+            if (O->max_declenchements && r.declenchements == O->max_declenchements) {
+                r.arret = INFERENCE_DECLENCHEMENTS;
+                break;
+            }
+            if (O->max_deduits && r.deduits == O->max_deduits) {
+                r.arret = INFERENCE_DEDUITS;
+                break;
+            }
+        }
+        TRACE_FIN("tour");
+
+        if (r.arret != INFERENCE_SATUREE) break;
+        if (echeance && horloge_us() >= echeance && nouveau) {
+            r.arret = INFERENCE_DELAI;
+            break;
+        }
+    }
+
+    // Un arrêt anticipé laisse une fermeture partielle
+    r.complete = r.arret == INFERENCE_SATUREE;
+    if (O->profil) profiler_premisses(BC, BF, O->profil, actives, nb_actives);
+    mem_liberer(NULL, actives);
+    TRACE_FIN("moteur_inference");
+
+    if (!O->silencieux) {
+        if (r.complete) printf("Inférence terminée.\n");
+        else printf("Inférence interrompue (%s).\n", inference_arret_nom(r.arret));
+    }
+    return r;
 }
 
 /*
@@ -82,54 +346,134 @@ bool toutes_premisses_vraies(const Regle *R, const BaseFaits *BF) {
  * Paramètres :
  *  - BC : pointeur vers la base de connaissances (ensemble des règles)
  *  - BF : pointeur vers la base de faits à enrichir
- *  - ht : pointeur vers la table de hachage utilisée pour éviter
- *         les doublons de faits
  *
  * Valeur de retour :
  *  - Aucune (void)
+ */
+void moteur_inference(const BaseConnaissances *BC, BaseFaits *BF) {
+    moteur_inference_opts(BC, BF, NULL);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : expliquer_fait
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit la preuve d’un fait (arbre indenté) en suivant la
+ *  provenance : le fait, la règle qui l’a déduit, puis la preuve
+ *  de chaque prémisse. Un fait déjà expliqué n’est pas repris, si
+ *  bien que chaque fait de la preuve est visité une seule fois.
+ *
+ * Paramètres :
+ *  - BC         : base de connaissances
+ *  - BF         : base de faits (avec provenance)
+ *  - fait       : fait à expliquer (présent dans BF)
+ *  - profondeur : niveau d’indentation
+ *  - vus        : faits déjà expliqués
+ *  - sortie     : flux d’écriture
+ *
+ * Valeur de retour :
+ *  - nombre de faits expliqués (sous-arbre compris)
  *
  * Variables locales :
- *  - nouveau : booléen indiquant si un nouveau fait a été ajouté
- *  - n       : pointeur pour parcourir les règles
- *  - R       : règle courante analysée
- *  - c       : conclusion de la règle courante
+ *  - v : version de la règle d’origine au moment de la déduction
+ *  - e : emplacement de la règle d’origine
+ *  - R : règle d’origine (NULL si supprimée ou modifiée depuis)
  */
-void moteur_inference(const BaseConnaissances *BC, BaseFaits *BF, HashTable *ht) {
-    // Indique si une nouvelle déduction a été faite
-    bool nouveau = true;
-
-    // Boucle principale : continue tant que de nouveaux faits sont déduits
-    while (nouveau) {
-        nouveau = false;
+static size_t expliquer_fait(const BaseConnaissances *BC, const BaseFaits *BF, const char *fait,
+                             size_t profondeur, HashTable *vus, FILE *sortie) {
+    fprintf(sortie, "%*s%s", (int)(2 * profondeur), "", fait);
+    if (hash_table_contains(vus, fait)) {
+        fprintf(sortie, " (voir plus haut)\n");
+        return 0;
+    }
+    hash_table_insert(vus, fait);
 
-        // Parcours de toutes les règles de la base de connaissances
-        for (BCNode *n = BC->head; n != NULL; n = n->next) {
-            const Regle *R = &n->regle;
+    uint64_t v = bf_origine(BF, fait);
+    if (v == BF_ORIGINE_AUCUNE) {
+        fprintf(sortie, " (fait initial)\n");
+        return 1;
+    }
+    if (v == BF_ORIGINE_INCONNUE) {
+        fprintf(sortie, " (déduit, règle non enregistrée)\n");
+        return 1;
+    }
 
-            // Récupération de la conclusion associée à la règle
-            const char *c = regle_obtenir_conclusion(R);
-            if (!c) continue;
+    // La règle doit être celle-là même qui a déduit le fait (même
+    // version), de prémisses toujours vraies
+    uint32_t e = (uint32_t)v;
+    const Regle *R = bc_version(BC, e) == v ? bc_regle(BC, bc_id_emplacement(BC, e)) : NULL;
+    if (!R || !toutes_premisses_vraies(R, BF)) {
+        fprintf(sortie, " (règle [%u] modifiée ou supprimée depuis)\n", e);
+        return 1;
+    }
 
-            // Vérifie si la règle est applicable :
-            //  - toutes les prémisses sont vraies
-            //  - la conclusion n’est pas déjà connue
-            if (toutes_premisses_vraies(R, BF) && !hash_table_contains(ht, c)) {
+    fprintf(sortie, " <= [%u] ", e);
+    for (size_t i = 0; i < R->premisses.size; i++) {
+        fprintf(sortie, "%s%s", i ? " AND " : "", liste_element(&R->premisses, i));
+    }
+    fprintf(sortie, " => %s\n", regle_obtenir_conclusion(R));
 
-                // Ajout de la nouvelle conclusion à la base de faits
-                liste_ajouter_en_queue(BF, c);
+    size_t n = 1;
+    for (size_t i = 0; i < R->premisses.size; i++) {
+        n += expliquer_fait(BC, BF, liste_element(&R->premisses, i), profondeur + 1, vus, sortie);
+    }
+    return n;
+}
 
-                // Insertion dans la table de hachage pour éviter les doublons
-                hash_table_insert(ht, c);
+/*
+ * ------------------------------------------------------------
+ * Fonction : inference_expliquer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Explique pourquoi un fait est connu sans relancer l’inférence :
+ *  l’arbre de preuve est reconstruit à partir de la provenance
+ *  enregistrée par le moteur (bf_activer_provenance), en un temps
+ *  proportionnel à la taille de la preuve.
+ *
+ * Paramètres :
+ *  - BC     : base de connaissances
+ *  - BF     : base de faits
+ *  - fait   : fait à expliquer
+ *  - sortie : flux d’écriture
+ *
+ * Valeur de retour :
+ *  - nombre de faits de la preuve (0 si le fait est inconnu)
+ *
+ * Variables locales :
+ *  - vus : faits déjà expliqués
+ */
+size_t inference_expliquer(const BaseConnaissances *BC, const BaseFaits *BF, const char *fait, FILE *sortie) {
+    if (!bf_contient(BF, fait)) return 0;
 
-                // Affichage de la nouvelle déduction
-                printf(">> Nouvelle déduction : %s\n", c);
+    HashTable vus;
+    hash_table_init(&vus);
+    size_t n = expliquer_fait(BC, BF, fait, 0, &vus, sortie);
+    hash_table_detruire(&vus);
+    return n;
+}
 
-                // Indique qu’un nouveau fait a été ajouté
-                nouveau = true;
-            }
-        }
+/*
+ * ------------------------------------------------------------
+ * Fonction : inference_arret_nom
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne un libellé lisible à une cause d’arrêt.
+ *
+ * Paramètres :
+ *  - a : cause d’arrêt
+ *
+ * Valeur de retour :
+ *  - libellé (chaîne statique)
+ */
+const char *inference_arret_nom(ArretInference a) {
+    switch (a) {
+        case INFERENCE_SATUREE:         return "saturation";
+        case INFERENCE_CIBLE:           return "cible atteinte";
+        case INFERENCE_TOURS:           return "limite de tours";
+        case INFERENCE_DECLENCHEMENTS:  return "limite de déclenchements";
+        case INFERENCE_DEDUITS:         return "limite de faits déduits";
+        case INFERENCE_DELAI:           return "délai dépassé";
     }
-
-    // Fin du processus d’inférence
-    printf("Inférence terminée.\n");
+    return "?";
 }
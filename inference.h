@@ -2,16 +2,55 @@
 #define INFERENCE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include "kb.h"
-#include "list.h"
-#include "hash.h"
+#include "facts.h"
+#include "profil.h"
 
-/* BaseFaits = une liste de faits (strings) */
-typedef Liste BaseFaits;
+/* Conditions d’arrêt anticipé (0 / NULL : pas de limite) */
+typedef struct {
+    const char *const *cibles;   // arrêt dès que l’une est connue
+    size_t nb_cibles;
+    size_t max_tours;
+    size_t max_declenchements;
+    size_t max_deduits;
+    uint64_t delai_us;           // durée maximale depuis l’appel
+    bool silencieux;             // pas d’affichage des déductions
+    const char *const *base_possible; // faits pouvant être affirmés (élagage ; NULL : aucun)
+    size_t nb_base_possible;
+    ProfilPremisses *profil;     // fréquences des prémisses à enrichir (NULL : aucun)
+} OptionsInference;
+
+typedef enum {
+    INFERENCE_SATUREE,           // fermeture complète
+    INFERENCE_CIBLE,
+    INFERENCE_TOURS,
+    INFERENCE_DECLENCHEMENTS,
+    INFERENCE_DEDUITS,
+    INFERENCE_DELAI
+} ArretInference;
+
+typedef struct {
+    ArretInference arret;
+    bool complete;               // false : fermeture partielle
+    size_t tours;
+    size_t declenchements;
+    size_t deduits;
+    const char *cible;           // cible atteinte (INFERENCE_CIBLE)
+    size_t elaguees;             // règles écartées avant le premier tour
+} ResultatInference;
 
 bool toutes_premisses_vraies(const Regle *R, const BaseFaits *BF);
-void moteur_inference(const BaseConnaissances *BC, BaseFaits *BF, HashTable *ht);
+void moteur_inference(const BaseConnaissances *BC, BaseFaits *BF);
 
-#endif
+void options_inference_init(OptionsInference *O);
+ResultatInference moteur_inference_opts(const BaseConnaissances *BC, BaseFaits *BF,
+                                        const OptionsInference *O);
+const char *inference_arret_nom(ArretInference a);
 
+/* Arbre de preuve d’un fait d’après la provenance (bf_activer_provenance) */
+size_t inference_expliquer(const BaseConnaissances *BC, const BaseFaits *BF, const char *fait, FILE *sortie);
 
+#endif
@@ -0,0 +1,829 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "journal.h"
+#include "trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* En-têtes des fichiers (8 octets) */
+#define MAGIE_JOURNAL "LO21WAL1"
+#define MAGIE_INSTANTANE "LO21SNP1"
+#define TAILLE_MAGIE 8
+
+/* Longueur et CRC, puis numéro et type (couverts par le CRC) */
+#define ENTETE_ENREGISTREMENT (2 * sizeof(uint32_t))
+#define CORPS_MIN (sizeof(uint64_t) + 1)
+
+/* Types d’enregistrements */
+#define ENR_REGLE 'r'               // "p1\0...\0c\0"
+#define ENR_REGLE_SUPPRIMEE 'x'     // rang u32
+#define ENR_PREMISSE_SUPPRIMEE 'p'  // rang u32, prémisse
+#define ENR_FAIT 'f'                // fait
+#define ENR_FAIT_SUPPRIME 'g'       // fait
+#define ENR_REGLES_VIDEES 'R'
+#define ENR_FAITS_VIDES 'F'
+#define ENR_FIN 'E'                 // fin d’instantané
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : crc32
+ * ------------------------------------------------------------
+ * Rôle :
+ *  CRC-32 (polynôme 0xEDB88320, celui de zlib) d’un bloc, par
+ *  table de 256 entrées calculée au premier appel.
+ *
+ * Paramètres :
+ *  - donnees : octets
+ *  - n       : nombre d’octets
+ *
+ * Valeur de retour :
+ *  - somme de contrôle
+ */
+static uint32_t crc32(const void *donnees, size_t n) {
+    static uint32_t table[256];
+    static bool prete = false;
+
+    if (!prete) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        prete = true;
+    }
+
+    const unsigned char *p = (const unsigned char *)donnees;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; i++) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : coder
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un enregistrement (longueur, CRC, numéro, type,
+ *  charge) à la fin d’un tampon.
+ *
+ * Paramètres :
+ *  - t      : tampon (agrandi au besoin)
+ *  - nb     : octets utilisés
+ *  - cap    : capacité
+ *  - numero : numéro de l’enregistrement
+ *  - type   : type
+ *  - charge : données (peut être NULL si n vaut 0)
+ *  - n      : taille des données
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void coder(char **t, size_t *nb, size_t *cap, uint64_t numero, char type, const void *charge, size_t n) {
+    size_t total = ENTETE_ENREGISTREMENT + CORPS_MIN + n;
+    if (*nb + total > *cap) {
+        size_t c = *cap ? *cap : 4096;
+        while (c < *nb + total) c *= 2;
+        *t = (char *)mem_reallouer(NULL, *t, c);
+        *cap = c;
+    }
+
+    char *corps = *t + *nb + ENTETE_ENREGISTREMENT;
+    memcpy(corps, &numero, sizeof(numero));
+    corps[sizeof(numero)] = type;
+    if (n) memcpy(corps + CORPS_MIN, charge, n);
+
+    uint32_t longueur = (uint32_t)(CORPS_MIN + n);
+    uint32_t crc = crc32(corps, longueur);
+    memcpy(*t + *nb, &longueur, sizeof(longueur));
+    memcpy(*t + *nb + sizeof(longueur), &crc, sizeof(crc));
+    *nb += total;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : decoder
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit l’enregistrement situé à *pos et vérifie son CRC.
+ *
+ * Paramètres :
+ *  - d      : contenu du fichier
+ *  - taille : taille du contenu
+ *  - pos    : position (avancée si l’enregistrement est valide)
+ *  - numero : reçoit le numéro
+ *  - type   : reçoit le type
+ *  - charge : reçoit les données
+ *  - n      : reçoit la taille des données
+ *
+ * Valeur de retour :
+ *  - true  : enregistrement complet et intact
+ *  - false : fin des données, enregistrement tronqué ou corrompu
+ */
+static bool decoder(const char *d, size_t taille, size_t *pos, uint64_t *numero, char *type,
+                    const char **charge, size_t *n) {
+    if (taille - *pos < ENTETE_ENREGISTREMENT) return false;
+
+    uint32_t longueur, crc;
+    memcpy(&longueur, d + *pos, sizeof(longueur));
+    memcpy(&crc, d + *pos + sizeof(longueur), sizeof(crc));
+    if (longueur < CORPS_MIN || taille - *pos - ENTETE_ENREGISTREMENT < longueur) return false;
+
+    const char *corps = d + *pos + ENTETE_ENREGISTREMENT;
+    if (crc32(corps, longueur) != crc) return false;
+
+    memcpy(numero, corps, sizeof(*numero));
+    *type = corps[sizeof(*numero)];
+    *charge = corps + CORPS_MIN;
+    *n = longueur - CORPS_MIN;
+    *pos += ENTETE_ENREGISTREMENT + longueur;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ecrire_tout
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit un bloc complet sur un descripteur (écritures
+ *  partielles et interruptions reprises).
+ *
+ * Paramètres :
+ *  - fd : descripteur
+ *  - p  : données
+ *  - n  : taille
+ *
+ * Valeur de retour :
+ *  - true si tout a été écrit
+ */
+static bool ecrire_tout(int fd, const char *p, size_t n) {
+    while (n > 0) {
+        ssize_t k = write(fd, p, n);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += k;
+        n -= (size_t)k;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lire_tout
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit le contenu entier d’un fichier ouvert.
+ *
+ * Paramètres :
+ *  - fd     : descripteur (positionné au début)
+ *  - taille : reçoit la taille lue
+ *
+ * Valeur de retour :
+ *  - contenu (à libérer), NULL en cas d’erreur de lecture
+ */
+static char *lire_tout(int fd, size_t *taille) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return NULL;
+
+    size_t n = (size_t)st.st_size, lus = 0;
+    char *d = (char *)mem_allouer(NULL, n + 1);
+    while (lus < n) {
+        ssize_t k = read(fd, d + lus, n - lus);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) break;
+        lus += (size_t)k;
+    }
+    *taille = lus;
+    return d;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : rang_regle
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Rang d’une règle dans l’ordre d’insertion (désignation
+ *  stable d’un instantané à l’autre, contrairement aux
+ *  emplacements qui sont réutilisés).
+ *
+ * Paramètres :
+ *  - BC : base de connaissances
+ *  - id : règle
+ *
+ * Valeur de retour :
+ *  - rang (0 pour la première règle)
+ */
+static uint32_t rang_regle(const BaseConnaissances *BC, RegleId id) {
+    uint32_t rang = 0;
+    for (RegleId r = bc_premiere(BC); r != REGLE_ID_INVALIDE && r != id; r = bc_suivante(BC, r)) rang++;
+    return rang;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : regle_au_rang
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Règle située à un rang donné de l’ordre d’insertion.
+ *
+ * Paramètres :
+ *  - BC   : base de connaissances
+ *  - rang : rang cherché
+ *
+ * Valeur de retour :
+ *  - identifiant, REGLE_ID_INVALIDE si le rang est hors limites
+ */
+static RegleId regle_au_rang(const BaseConnaissances *BC, uint32_t rang) {
+    RegleId r = bc_premiere(BC);
+    while (r != REGLE_ID_INVALIDE && rang-- > 0) r = bc_suivante(BC, r);
+    return r;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : appliquer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Rejoue un enregistrement sur la BC et la BF.
+ *
+ * Paramètres :
+ *  - BC     : base de connaissances
+ *  - BF     : base de faits
+ *  - type   : type de l’enregistrement
+ *  - charge : données (terminées par '\0' pour les chaînes)
+ *  - n      : taille des données
+ *
+ * Valeur de retour :
+ *  - true  : enregistrement appliqué
+ *  - false : enregistrement incohérent avec l’état reconstruit
+ */
+static bool appliquer(BaseConnaissances *BC, BaseFaits *BF, char type, const char *charge, size_t n) {
+    bool chaine = n > 0 && charge[n - 1] == '\0';
+    uint32_t rang = 0;
+    if (type == ENR_REGLE_SUPPRIMEE || type == ENR_PREMISSE_SUPPRIMEE) {
+        if (n < sizeof(rang)) return false;
+        memcpy(&rang, charge, sizeof(rang));
+    }
+
+    switch (type) {
+        case ENR_REGLE: {
+            if (!chaine) return false;
+            // La dernière chaîne est la conclusion
+            Regle R;
+            regle_init_avec(&R, BC->alloc);
+            const char *c = charge;
+            for (const char *s = charge; s < charge + n; s += strlen(s) + 1) {
+                if (s != c) regle_ajouter_premisse(&R, c);
+                c = s;
+            }
+            regle_definir_conclusion(&R, c);
+            bc_ajouter_regle_en_queue(BC, &R);
+            regle_detruire(&R);
+            return true;
+        }
+
+        case ENR_REGLE_SUPPRIMEE:
+            return bc_supprimer_regle(BC, regle_au_rang(BC, rang));
+
+        case ENR_PREMISSE_SUPPRIMEE:
+            if (n <= sizeof(rang) || charge[n - 1] != '\0') return false;
+            return bc_supprimer_premisse(BC, regle_au_rang(BC, rang), charge + sizeof(rang));
+
+        case ENR_FAIT:
+            if (!chaine) return false;
+            bf_ajouter(BF, charge);
+            return true;
+
+        case ENR_FAIT_SUPPRIME:
+            if (!chaine) return false;
+            bf_supprimer(BF, charge);
+            return true;
+
+        case ENR_REGLES_VIDEES:
+            bc_vider(BC);
+            return true;
+
+        case ENR_FAITS_VIDES:
+            bf_vider(BF);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : charger_instantane
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Charge l’instantané s’il existe.
+ *
+ * Paramètres :
+ *  - J      : journal (chemin_instantane)
+ *  - BC, BF : bases remplies
+ *  - numero : reçoit le numéro du dernier enregistrement inclus
+ *  - trouve : reçoit true si un instantané existe
+ *
+ * Valeur de retour :
+ *  - true  : aucun instantané, ou instantané chargé
+ *  - false : instantané illisible ou incomplet (message sur stderr)
+ */
+static bool charger_instantane(Journal *J, BaseConnaissances *BC, BaseFaits *BF, uint64_t *numero, bool *trouve) {
+    *numero = 0;
+    *trouve = false;
+
+    int fd = open(J->chemin_instantane, O_RDONLY);
+    if (fd < 0) return errno == ENOENT;
+
+    size_t taille = 0;
+    char *d = lire_tout(fd, &taille);
+    close(fd);
+
+    bool complet = false;
+    if (d && taille >= TAILLE_MAGIE + sizeof(uint64_t) && memcmp(d, MAGIE_INSTANTANE, TAILLE_MAGIE) == 0) {
+        memcpy(numero, d + TAILLE_MAGIE, sizeof(*numero));
+
+        size_t pos = TAILLE_MAGIE + sizeof(uint64_t), n;
+        uint64_t k;
+        char type;
+        const char *charge;
+        while (decoder(d, taille, &pos, &k, &type, &charge, &n)) {
+            if (type == ENR_FIN) {
+                complet = true;
+                break;
+            }
+            if (!appliquer(BC, BF, type, charge, n)) break;
+        }
+    }
+    mem_liberer(NULL, d);
+
+    if (!complet) {
+        fprintf(stderr, "Instantané %s invalide.\n", J->chemin_instantane);
+        return false;
+    }
+    *trouve = true;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_ouvrir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ouvre (ou crée) un journal et reconstruit l’état : chargement
+ *  de l’instantané, puis rejeu des enregistrements plus récents.
+ *  Le premier enregistrement invalide marque la fin du journal ;
+ *  le fichier est coupé à cet endroit avant les nouveaux ajouts.
+ *
+ * Paramètres :
+ *  - J       : journal à ouvrir
+ *  - chemin  : fichier du journal (l’instantané est "<chemin>.snap")
+ *  - BC, BF  : bases (vides) reconstruites
+ *  - bilan   : reçoit le détail de la reprise (peut être NULL)
+ *
+ * Valeur de retour :
+ *  - true  : journal prêt
+ *  - false : fichier inaccessible ou invalide (message sur stderr)
+ *
+ * Variables locales :
+ *  - base : numéro du dernier enregistrement inclus dans l’instantané
+ *  - fin  : fin du dernier enregistrement valide
+ */
+bool journal_ouvrir(Journal *J, const char *chemin, BaseConnaissances *BC, BaseFaits *BF, BilanReprise *bilan) {
+    TRACE_DEBUT("reprise_journal");
+    BilanReprise local;
+    if (!bilan) bilan = &local;
+    memset(bilan, 0, sizeof(*bilan));
+    memset(J, 0, sizeof(*J));
+    J->fd = -1;
+    J->chemin = mem_dupliquer(NULL, chemin);
+    J->chemin_instantane = (char *)mem_allouer(NULL, strlen(chemin) + 6);
+    sprintf(J->chemin_instantane, "%s.snap", chemin);
+
+    uint64_t base;
+    if (!charger_instantane(J, BC, BF, &base, &bilan->instantane)) {
+        journal_fermer(J);
+        TRACE_FIN("reprise_journal");
+        return false;
+    }
+    J->numero = base;
+
+    J->fd = open(chemin, O_RDWR | O_CREAT, 0644);
+    if (J->fd < 0) {
+        perror(chemin);
+        journal_fermer(J);
+        TRACE_FIN("reprise_journal");
+        return false;
+    }
+
+    size_t taille = 0;
+    char *d = lire_tout(J->fd, &taille);
+    bool ok = d != NULL;
+    size_t fin = TAILLE_MAGIE;
+
+    if (ok && taille == 0) {
+        ok = ecrire_tout(J->fd, MAGIE_JOURNAL, TAILLE_MAGIE) && fdatasync(J->fd) == 0;
+    } else if (ok && (taille < TAILLE_MAGIE || memcmp(d, MAGIE_JOURNAL, TAILLE_MAGIE) != 0)) {
+        fprintf(stderr, "%s n’est pas un journal LO21.\n", chemin);
+        ok = false;
+    } else if (ok) {
+        size_t pos = TAILLE_MAGIE, n;
+        uint64_t numero;
+        char type;
+        const char *charge;
+        while (decoder(d, taille, &pos, &numero, &type, &charge, &n)) {
+            // Enregistrements déjà inclus dans l’instantané (arrêt avant la troncature)
+            if (numero > base) {
+                if (!appliquer(BC, BF, type, charge, n)) break;
+                bilan->rejoues++;
+            }
+            if (numero > J->numero) J->numero = numero;
+            J->depuis_instantane++;
+            fin = pos;
+        }
+
+        if (fin < taille) {
+            bilan->tronque = true;
+            ok = ftruncate(J->fd, (off_t)fin) == 0;
+        }
+    }
+    mem_liberer(NULL, d);
+
+    if (!ok || lseek(J->fd, 0, SEEK_END) < 0) {
+        if (ok) perror(chemin);
+        journal_fermer(J);
+        TRACE_FIN("reprise_journal");
+        return false;
+    }
+    TRACE_FIN("reprise_journal");
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : enregistrer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Place un enregistrement dans le tampon ; le tampon est écrit
+ *  (sans synchronisation) dès qu’il dépasse JOURNAL_TAMPON.
+ *
+ * Paramètres :
+ *  - J      : journal (NULL : rien n’est fait)
+ *  - type   : type
+ *  - charge : données
+ *  - n      : taille des données
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void enregistrer(Journal *J, char type, const void *charge, size_t n) {
+    if (!J) return;
+
+    coder(&J->tampon, &J->nb, &J->cap, ++J->numero, type, charge, n);
+    J->enregistrements++;
+    J->depuis_instantane++;
+
+    if (J->nb >= JOURNAL_TAMPON) {
+        if (!ecrire_tout(J->fd, J->tampon, J->nb)) perror(J->chemin);
+        J->nb = 0;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : coder_regle
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit une règle sous la forme "p1\0...\0c\0".
+ *
+ * Paramètres :
+ *  - R      : règle (conclusion définie)
+ *  - taille : reçoit la taille écrite
+ *
+ * Valeur de retour :
+ *  - données (à libérer)
+ */
+static char *coder_regle(const Regle *R, size_t *taille) {
+    size_t n = strlen(R->conclusion) + 1;
+    for (size_t i = 0; i < R->premisses.size; i++) n += strlen(liste_element(&R->premisses, i)) + 1;
+
+    char *d = (char *)mem_allouer(NULL, n);
+    size_t pos = 0;
+    for (size_t i = 0; i <= R->premisses.size; i++) {
+        const char *s = i < R->premisses.size ? liste_element(&R->premisses, i) : R->conclusion;
+        size_t l = strlen(s) + 1;
+        memcpy(d + pos, s, l);
+        pos += l;
+    }
+    *taille = n;
+    return d;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_regle_ajoutee
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise l’ajout d’une règle en fin de BC.
+ *
+ * Paramètres :
+ *  - J : journal (NULL : aucun)
+ *  - R : règle ajoutée (conclusion définie)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_regle_ajoutee(Journal *J, const Regle *R) {
+    if (!J || !R->conclusion) return;
+
+    size_t n;
+    char *d = coder_regle(R, &n);
+    enregistrer(J, ENR_REGLE, d, n);
+    mem_liberer(NULL, d);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_regle_supprimee
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise la suppression d’une règle. À appeler avant la
+ *  suppression (le rang de la règle est calculé sur la BC).
+ *
+ * Paramètres :
+ *  - J  : journal (NULL : aucun)
+ *  - BC : base de connaissances
+ *  - id : règle supprimée (valide)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_regle_supprimee(Journal *J, const BaseConnaissances *BC, RegleId id) {
+    if (!J) return;
+
+    uint32_t rang = rang_regle(BC, id);
+    enregistrer(J, ENR_REGLE_SUPPRIMEE, &rang, sizeof(rang));
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_premisse_supprimee
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise la suppression d’une prémisse d’une règle.
+ *
+ * Paramètres :
+ *  - J  : journal (NULL : aucun)
+ *  - BC : base de connaissances
+ *  - id : règle modifiée
+ *  - p  : prémisse supprimée
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_premisse_supprimee(Journal *J, const BaseConnaissances *BC, RegleId id, const char *p) {
+    if (!J) return;
+
+    uint32_t rang = rang_regle(BC, id);
+    size_t l = strlen(p) + 1;
+    char *d = (char *)mem_allouer(NULL, sizeof(rang) + l);
+    memcpy(d, &rang, sizeof(rang));
+    memcpy(d + sizeof(rang), p, l);
+    enregistrer(J, ENR_PREMISSE_SUPPRIMEE, d, sizeof(rang) + l);
+    mem_liberer(NULL, d);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_fait_ajoute
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise l’ajout d’un fait (affirmé ou déduit).
+ *
+ * Paramètres :
+ *  - J    : journal (NULL : aucun)
+ *  - fait : fait ajouté
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_fait_ajoute(Journal *J, const char *fait) {
+    enregistrer(J, ENR_FAIT, fait, strlen(fait) + 1);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_fait_supprime
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise la suppression d’un fait.
+ *
+ * Paramètres :
+ *  - J    : journal (NULL : aucun)
+ *  - fait : fait supprimé
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_fait_supprime(Journal *J, const char *fait) {
+    enregistrer(J, ENR_FAIT_SUPPRIME, fait, strlen(fait) + 1);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_regles_videes
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise la suppression de toutes les règles.
+ *
+ * Paramètres :
+ *  - J : journal (NULL : aucun)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_regles_videes(Journal *J) {
+    enregistrer(J, ENR_REGLES_VIDEES, NULL, 0);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_faits_vides
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise la suppression de tous les faits.
+ *
+ * Paramètres :
+ *  - J : journal (NULL : aucun)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_faits_vides(Journal *J) {
+    enregistrer(J, ENR_FAITS_VIDES, NULL, 0);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_valider
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Validation groupée : écrit les enregistrements en attente et
+ *  synchronise le fichier une seule fois pour tout le groupe.
+ *
+ * Paramètres :
+ *  - J : journal (NULL : aucun)
+ *
+ * Valeur de retour :
+ *  - true  : modifications durables
+ *  - false : erreur d’écriture (message sur stderr)
+ *
+ */
+bool journal_valider(Journal *J) {
+    if (!J || J->fd < 0) return true;
+
+    if (J->nb > 0) {
+        bool ok = ecrire_tout(J->fd, J->tampon, J->nb);
+        J->nb = 0;
+        if (!ok) {
+            perror(J->chemin);
+            return false;
+        }
+    } else if (J->enregistrements == J->valides) {
+        return true;
+    }
+
+    if (fdatasync(J->fd) != 0) {
+        perror(J->chemin);
+        return false;
+    }
+    J->validations++;
+    J->valides = J->enregistrements;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_instantane
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit l’état complet (règles dans l’ordre d’insertion, puis
+ *  faits) dans un instantané, remplacé atomiquement (fichier
+ *  temporaire puis rename), puis vide le journal. Un arrêt entre
+ *  les deux étapes est sans effet : les enregistrements restants
+ *  portent des numéros déjà couverts par l’instantané.
+ *
+ * Paramètres :
+ *  - J  : journal
+ *  - BC : base de connaissances
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - true  : instantané écrit, journal vidé
+ *  - false : erreur d’écriture (le journal reste valide)
+ *
+ * Variables locales :
+ *  - d, nb, cap : contenu de l’instantané
+ *  - tmp        : chemin du fichier temporaire
+ */
+bool journal_instantane(Journal *J, const BaseConnaissances *BC, const BaseFaits *BF) {
+    if (!journal_valider(J)) return false;
+    TRACE_DEBUT("instantane");
+
+    size_t nb = TAILLE_MAGIE + sizeof(J->numero), cap = 4096;
+    char *d = (char *)mem_allouer(NULL, cap);
+    memcpy(d, MAGIE_INSTANTANE, TAILLE_MAGIE);
+    memcpy(d + TAILLE_MAGIE, &J->numero, sizeof(J->numero));
+
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        const Regle *R = bc_regle(BC, id);
+        if (!R->conclusion) continue;
+        size_t n;
+        char *r = coder_regle(R, &n);
+        coder(&d, &nb, &cap, J->numero, ENR_REGLE, r, n);
+        mem_liberer(NULL, r);
+    }
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *f = bf_emplacement(BF, i);
+        if (f) coder(&d, &nb, &cap, J->numero, ENR_FAIT, f, strlen(f) + 1);
+    }
+    coder(&d, &nb, &cap, J->numero, ENR_FIN, NULL, 0);
+
+    char *tmp = (char *)mem_allouer(NULL, strlen(J->chemin_instantane) + 5);
+    sprintf(tmp, "%s.tmp", J->chemin_instantane);
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool ok = fd >= 0 && ecrire_tout(fd, d, nb) && fdatasync(fd) == 0;
+    if (fd >= 0) close(fd);
+    ok = ok && rename(tmp, J->chemin_instantane) == 0;
+
+    // Le journal ne contient plus que son en-tête
+    ok = ok && ftruncate(J->fd, TAILLE_MAGIE) == 0 && lseek(J->fd, 0, SEEK_END) >= 0 && fdatasync(J->fd) == 0;
+    if (!ok) {
+        perror(J->chemin_instantane);
+        unlink(tmp);
+    } else {
+        J->depuis_instantane = 0;
+    }
+
+    mem_liberer(NULL, tmp);
+    mem_liberer(NULL, d);
+    TRACE_FIN("instantane");
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_point_controle
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Valide les modifications en attente et, si le journal a reçu
+ *  JOURNAL_SEUIL_INSTANTANE enregistrements depuis le dernier
+ *  instantané, le compacte.
+ *
+ * Paramètres :
+ *  - J  : journal (NULL : aucun)
+ *  - BC : base de connaissances
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - true si les modifications sont durables
+ */
+bool journal_point_controle(Journal *J, const BaseConnaissances *BC, const BaseFaits *BF) {
+    if (!J) return true;
+    if (!journal_valider(J)) return false;
+    if (J->depuis_instantane >= JOURNAL_SEUIL_INSTANTANE) journal_instantane(J, BC, BF);
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journal_fermer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Valide les modifications en attente puis ferme le journal.
+ *
+ * Paramètres :
+ *  - J : journal
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void journal_fermer(Journal *J) {
+    if (J->fd >= 0) {
+        journal_valider(J);
+        close(J->fd);
+    }
+    mem_liberer(NULL, J->tampon);
+    mem_liberer(NULL, J->chemin);
+    mem_liberer(NULL, J->chemin_instantane);
+    memset(J, 0, sizeof(*J));
+    J->fd = -1;
+}
@@ -0,0 +1,67 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "facts.h"
+#include "kb.h"
+
+/*
+ * Journal d’écriture anticipée (WAL) des modifications de la BC et
+ * de la BF. Chaque modification devient un enregistrement
+ *   [longueur u32][crc32 u32][numéro u64][type u8][charge]
+ * ajouté à un tampon ; journal_valider écrit le tampon d’un seul
+ * bloc puis le synchronise (fdatasync) : toutes les modifications
+ * d’une action sont validées ensemble. Un instantané compacté
+ * ("<journal>.snap", remplacé atomiquement) contient l’état complet
+ * et le numéro du dernier enregistrement qu’il inclut ; au démarrage,
+ * il est chargé puis seuls les enregistrements plus récents du
+ * journal sont rejoués. Une fin de journal tronquée ou corrompue
+ * (arrêt brutal pendant une écriture) est ignorée puis coupée.
+ * Les règles sont désignées par leur rang dans l’ordre d’insertion,
+ * qui est conservé par l’instantané.
+ */
+
+/* Taille du tampon au-delà de laquelle les enregistrements sont écrits sans attendre */
+#define JOURNAL_TAMPON (64 * 1024)
+
+/* Enregistrements validés au-delà desquels journal_point_controle écrit un instantané */
+#define JOURNAL_SEUIL_INSTANTANE 10000
+
+typedef struct {
+    int fd;
+    char *chemin;
+    char *chemin_instantane;
+    uint64_t numero;            // dernier numéro attribué
+    char *tampon;               // enregistrements non encore écrits
+    size_t nb;
+    size_t cap;
+    size_t depuis_instantane;   // enregistrements écrits depuis le dernier instantané
+    size_t validations;         // synchronisations effectuées
+    size_t enregistrements;     // enregistrements produits
+    size_t valides;             // enregistrements déjà synchronisés
+} Journal;
+
+typedef struct {
+    bool instantane;            // un instantané a été chargé
+    size_t rejoues;             // enregistrements du journal appliqués
+    bool tronque;               // fin de journal invalide coupée
+} BilanReprise;
+
+bool journal_ouvrir(Journal *J, const char *chemin, BaseConnaissances *BC, BaseFaits *BF, BilanReprise *bilan);
+
+void journal_regle_ajoutee(Journal *J, const Regle *R);
+void journal_regle_supprimee(Journal *J, const BaseConnaissances *BC, RegleId id);
+void journal_premisse_supprimee(Journal *J, const BaseConnaissances *BC, RegleId id, const char *p);
+void journal_fait_ajoute(Journal *J, const char *fait);
+void journal_fait_supprime(Journal *J, const char *fait);
+void journal_regles_videes(Journal *J);
+void journal_faits_vides(Journal *J);
+
+bool journal_valider(Journal *J);
+bool journal_instantane(Journal *J, const BaseConnaissances *BC, const BaseFaits *BF);
+bool journal_point_controle(Journal *J, const BaseConnaissances *BC, const BaseFaits *BF);
+void journal_fermer(Journal *J);
+
+#endif
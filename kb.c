@@ -1,32 +1,58 @@
+#define _POSIX_C_SOURCE 200809L
 #include "kb.h"
+#include "trace.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <ctype.h>
 
 /*
  * ------------------------------------------------------------
- * Fonction : xmalloc
+ * Fonction : faire_id
  * ------------------------------------------------------------
  * Rôle :
- *  Alloue dynamiquement un bloc mémoire de taille donnée.
- *  En cas d’échec de l’allocation, le programme est arrêté
- *  proprement avec un message d’erreur.
+ *  Construit l’identifiant de la règle occupant un emplacement.
  *
  * Paramètres :
- *  - n : taille (en octets) de la mémoire à allouer
+ *  - BC : pointeur constant vers la base de connaissances
+ *  - e  : emplacement occupé
+ *
+ * Valeur de retour :
+ *  - identifiant (génération << 32) | emplacement
+ */
+static RegleId faire_id(const BaseConnaissances *BC, uint32_t e) {
+    return ((RegleId)BC->emplacements[e].generation << 32) | e;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : emplacement_valide
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie qu’un identifiant désigne une règle encore présente :
+ *  emplacement existant, occupé et de même génération.
+ *
+ * Paramètres :
+ *  - BC  : pointeur constant vers la base de connaissances
+ *  - id  : identifiant à vérifier
+ *  - out : emplacement correspondant (si valide)
  *
  * Valeur de retour :
- *  - pointeur vers la zone mémoire allouée
+ *  - true  : l’identifiant est valide
+ *  - false : il est invalide ou périmé
  *
  * Variables locales :
- *  - p : pointeur vers la mémoire allouée
+ *  - e : emplacement extrait de l’identifiant
  */
-static void *xmalloc(size_t n) {
-    void *p = malloc(n);
-    if (!p) {
-        perror("malloc");
-        exit(EXIT_FAILURE);
-    }
-    return p;
+static bool emplacement_valide(const BaseConnaissances *BC, RegleId id, uint32_t *out) {
+    uint32_t e = (uint32_t)(id & 0xffffffffu);
+
+    if (e >= BC->nb_emplacements) return false;
+    const BCEmplacement *s = &BC->emplacements[e];
+    if (!s->occupe || s->generation != (uint32_t)(id >> 32)) return false;
+
+    *out = e;
+    return true;
 }
 
 /*
@@ -35,7 +61,6 @@ static void *xmalloc(size_t n) {
  * ------------------------------------------------------------
  * Rôle :
  *  Initialise une base de connaissances vide.
- *  Tous les pointeurs sont mis à NULL et la taille est remise à zéro.
  *
  * Paramètres :
  *  - BC : pointeur vers la base de connaissances à initialiser
@@ -44,9 +69,34 @@ static void *xmalloc(size_t n) {
  *  - Aucune (void)
  */
 void bc_init(BaseConnaissances *BC) {
-    BC->head = NULL;
-    BC->tail = NULL;
+    bc_init_avec(BC, NULL);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une base de connaissances vide dont toute la
+ *  mémoire (emplacements, prémisses, conclusions) sera fournie
+ *  par l’allocateur donné.
+ *
+ * Paramètres :
+ *  - BC : pointeur vers la base de connaissances à initialiser
+ *  - A  : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bc_init_avec(BaseConnaissances *BC, const Allocateur *A) {
+    BC->emplacements = NULL;
+    BC->nb_emplacements = 0;
+    BC->cap = 0;
+    BC->premier = BC->dernier = BC_FIN;
+    BC->libre = BC_FIN;
     BC->size = 0;
+    BC->versions = 0;
+    BC->alloc = A ? A : &allocateur_systeme;
 }
 
 /*
@@ -64,7 +114,7 @@ void bc_init(BaseConnaissances *BC) {
  *  - false : elle contient au moins une règle
  */
 bool bc_est_vide(const BaseConnaissances *BC) {
-    return BC->head == NULL;
+    return BC->size == 0;
 }
 
 /*
@@ -72,47 +122,67 @@ bool bc_est_vide(const BaseConnaissances *BC) {
  * Fonction : bc_ajouter_regle_en_queue
  * ------------------------------------------------------------
  * Rôle :
- *  Ajoute une règle à la fin de la base de connaissances.
- *  Une copie complète de la règle est créée (prémisses et conclusion).
+ *  Ajoute une règle à la fin de l’ordre de parcours de la base
+ *  de connaissances. Une copie complète de la règle est créée
+ *  (prémisses et conclusion). Un emplacement libéré par une
+ *  suppression est réutilisé en priorité.
  *
  * Paramètres :
  *  - BC : pointeur vers la base de connaissances
  *  - R  : pointeur vers la règle à ajouter
  *
  * Valeur de retour :
- *  - Aucune (void)
+ *  - identifiant stable de la règle ajoutée
  *
  * Variables locales :
- *  - n : nouveau nœud contenant la règle copiée
- *  - p : pointeur pour parcourir les prémisses de la règle source
+ *  - copie : copie profonde de la règle
+ *  - e     : emplacement attribué à la règle
+ *  - s     : emplacement en cours de remplissage
+ *  - i     : position de la prémisse copiée dans la règle source
  */
-void bc_ajouter_regle_en_queue(BaseConnaissances *BC, const Regle *R) {
-    // Allocation d’un nouveau nœud de base de connaissances
-    BCNode *n = (BCNode *)xmalloc(sizeof(BCNode));
-
-    // Initialisation de la règle contenue dans le nœud
-    regle_init(&n->regle);
-
-    // Copie de toutes les prémisses de la règle source
-    for (ListNode *p = R->premisses.head; p; p = p->next) {
-        regle_ajouter_premisse(&n->regle, p->s);
+RegleId bc_ajouter_regle_en_queue(BaseConnaissances *BC, const Regle *R) {
+    // Extension du tableau si aucun emplacement n’est disponible
+    if (BC->libre == BC_FIN && BC->nb_emplacements == BC->cap) {
+        uint32_t cap = BC->cap ? BC->cap * 2 : 16;
+        BC->emplacements = (BCEmplacement *)mem_reallouer(BC->alloc, BC->emplacements,
+                                                          cap * sizeof(BCEmplacement));
+        BC->cap = cap;
     }
 
-    // Copie de la conclusion si elle existe
+    // Copie de toutes les prémisses et de la conclusion, avant de
+    // modifier la BC (un échec d’allocation la laisse intacte)
+    Regle copie;
+    regle_init_avec(&copie, BC->alloc);
+    for (size_t i = 0; i < R->premisses.size; i++) {
+        regle_ajouter_premisse(&copie, liste_element(&R->premisses, i));
+    }
     if (R->conclusion)
-        regle_definir_conclusion(&n->regle, R->conclusion);
+        regle_definir_conclusion(&copie, R->conclusion);
 
-    // Insertion du nœud en fin de liste
-    n->next = NULL;
-    if (BC->tail == NULL) {
-        BC->head = BC->tail = n;
+    // Réutilisation d’un emplacement libre ou nouvel emplacement
+    uint32_t e;
+    if (BC->libre != BC_FIN) {
+        e = BC->libre;
+        BC->libre = BC->emplacements[e].suiv;
     } else {
-        BC->tail->next = n;
-        BC->tail = n;
+        e = BC->nb_emplacements++;
+        BC->emplacements[e].generation = 1;
     }
+    BCEmplacement *s = &BC->emplacements[e];
+    s->regle = copie;
+    s->version = ++BC->versions;
+
+    // Chaînage en fin d’ordre d’insertion
+    s->occupe = true;
+    s->prec = BC->dernier;
+    s->suiv = BC_FIN;
+    if (BC->dernier == BC_FIN) BC->premier = e;
+    else BC->emplacements[BC->dernier].suiv = e;
+    BC->dernier = e;
 
     // Mise à jour du nombre de règles
     BC->size++;
+    return faire_id(BC, e);
 }
 
 /*
@@ -130,58 +200,218 @@ void bc_ajouter_regle_en_queue(BaseConnaissances *BC, const Regle *R) {
  *  - NULL si la base est vide
  */
 const Regle *bc_tete(const BaseConnaissances *BC) {
-    return BC->head ? &BC->head->regle : NULL;
+    return BC->premier != BC_FIN ? &BC->emplacements[BC->premier].regle : NULL;
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : bc_supprimer_regle_index
+ * Fonction : bc_regle
  * ------------------------------------------------------------
  * Rôle :
- *  Supprime une règle située à un indice donné dans la
- *  base de connaissances.
+ *  Retourne la règle désignée par un identifiant, en O(1).
+ *  Le pointeur reste valable jusqu’au prochain ajout de règle.
  *
  * Paramètres :
- *  - BC  : pointeur vers la base de connaissances
- *  - idx : indice de la règle à supprimer
+ *  - BC : pointeur constant vers la base de connaissances
+ *  - id : identifiant de la règle
  *
  * Valeur de retour :
- *  - true  : la suppression a été effectuée
- *  - false : l’indice est invalide
+ *  - pointeur vers la règle
+ *  - NULL si l’identifiant est invalide ou périmé
  *
  * Variables locales :
- *  - prev : pointeur vers le nœud précédent
- *  - cur  : pointeur vers le nœud courant
+ *  - e : emplacement de la règle
  */
-bool bc_supprimer_regle_index(BaseConnaissances *BC, size_t idx) {
-    // Vérification de la validité de l’indice
-    if (idx >= BC->size) return false;
-
-    BCNode *prev = NULL;
-    BCNode *cur = BC->head;
+Regle *bc_regle(const BaseConnaissances *BC, RegleId id) {
+    uint32_t e;
+    return emplacement_valide(BC, id, &e) ? &BC->emplacements[e].regle : NULL;
+}
 
-    // Parcours jusqu’au nœud à supprimer
-    for (size_t i = 0; i < idx; i++) {
-        prev = cur;
-        cur = cur->next;
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_id_emplacement
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne l’identifiant de la règle occupant un emplacement
+ *  (numéro affiché par bc_afficher).
+ *
+ * Paramètres :
+ *  - BC          : pointeur constant vers la base de connaissances
+ *  - emplacement : numéro d’emplacement
+ *
+ * Valeur de retour :
+ *  - identifiant de la règle
+ *  - REGLE_ID_INVALIDE si l’emplacement est libre ou inexistant
+ */
+RegleId bc_id_emplacement(const BaseConnaissances *BC, size_t emplacement) {
+    if (emplacement >= BC->nb_emplacements || !BC->emplacements[emplacement].occupe) {
+        return REGLE_ID_INVALIDE;
     }
+    return faire_id(BC, (uint32_t)emplacement);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_version
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne la version de la règle occupant un emplacement : elle
+ *  change à chaque modification de la règle et n’est jamais
+ *  reprise par une autre règle du même emplacement.
+ *
+ * Paramètres :
+ *  - BC          : pointeur constant vers la base de connaissances
+ *  - emplacement : numéro d’emplacement
+ *
+ * Valeur de retour :
+ *  - (version << 32) | emplacement
+ *  - 0 si l’emplacement est libre ou inexistant
+ */
+uint64_t bc_version(const BaseConnaissances *BC, size_t emplacement) {
+    if (emplacement >= BC->nb_emplacements || !BC->emplacements[emplacement].occupe) return 0;
+    return ((uint64_t)BC->emplacements[emplacement].version << 32) | emplacement;
+}
 
-    // Réorganisation des pointeurs
-    if (prev) prev->next = cur->next;
-    else BC->head = cur->next;
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_supprimer_regle
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Supprime en O(1) la règle désignée par un identifiant.
+ *  L’emplacement change de génération puis rejoint la pile des
+ *  emplacements libres.
+ *
+ * Paramètres :
+ *  - BC : pointeur vers la base de connaissances
+ *  - id : identifiant de la règle
+ *
+ * Valeur de retour :
+ *  - true  : la règle a été supprimée
+ *  - false : l’identifiant est invalide ou périmé
+ *
+ * Variables locales :
+ *  - e : emplacement de la règle
+ *  - s : emplacement libéré
+ */
+bool bc_supprimer_regle(BaseConnaissances *BC, RegleId id) {
+    uint32_t e;
+    if (!emplacement_valide(BC, id, &e)) return false;
+    BCEmplacement *s = &BC->emplacements[e];
 
-    // Mise à jour de la fin de liste si nécessaire
-    if (cur == BC->tail) BC->tail = prev;
+    // Retrait de l’ordre d’insertion
+    if (s->prec != BC_FIN) BC->emplacements[s->prec].suiv = s->suiv;
+    else BC->premier = s->suiv;
+    if (s->suiv != BC_FIN) BC->emplacements[s->suiv].prec = s->prec;
+    else BC->dernier = s->prec;
 
-    // Libération de la règle et du nœud
-    regle_detruire(&cur->regle);
-    free(cur);
+    // Libération de la règle et recyclage de l’emplacement
+    regle_detruire(&s->regle);
+    s->occupe = false;
+    if (++s->generation == 0) s->generation = 1;
+    s->suiv = BC->libre;
+    BC->libre = e;
 
     // Mise à jour de la taille
     BC->size--;
     return true;
 }
 
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_supprimer_premisse
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Supprime une prémisse de la règle désignée par un
+ *  identifiant (accès à la règle en O(1)). L’identifiant est
+ *  inchangé ; la règle prend une nouvelle version.
+ *
+ * Paramètres :
+ *  - BC : pointeur vers la base de connaissances
+ *  - id : identifiant de la règle
+ *  - p  : prémisse à supprimer
+ *
+ * Valeur de retour :
+ *  - true  : la prémisse a été supprimée
+ *  - false : identifiant invalide ou prémisse introuvable
+ */
+bool bc_supprimer_premisse(BaseConnaissances *BC, RegleId id, const char *p) {
+    uint32_t e;
+    if (!emplacement_valide(BC, id, &e) || !regle_supprimer_premisse(&BC->emplacements[e].regle, p)) return false;
+    BC->emplacements[e].version = ++BC->versions;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_premiere
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Début du parcours des règles dans l’ordre d’insertion.
+ *
+ * Paramètres :
+ *  - BC : pointeur constant vers la base de connaissances
+ *
+ * Valeur de retour :
+ *  - identifiant de la première règle
+ *  - REGLE_ID_INVALIDE si la base est vide
+ */
+RegleId bc_premiere(const BaseConnaissances *BC) {
+    return BC->premier != BC_FIN ? faire_id(BC, BC->premier) : REGLE_ID_INVALIDE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_suivante
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Avance le parcours des règles dans l’ordre d’insertion.
+ *
+ * Paramètres :
+ *  - BC : pointeur constant vers la base de connaissances
+ *  - id : identifiant de la règle courante (valide)
+ *
+ * Valeur de retour :
+ *  - identifiant de la règle suivante
+ *  - REGLE_ID_INVALIDE en fin de parcours
+ *
+ * Variables locales :
+ *  - suiv : emplacement suivant
+ */
+RegleId bc_suivante(const BaseConnaissances *BC, RegleId id) {
+    uint32_t suiv = BC->emplacements[(uint32_t)(id & 0xffffffffu)].suiv;
+    return suiv != BC_FIN ? faire_id(BC, suiv) : REGLE_ID_INVALIDE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_supprimer_regle_index
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Supprime la règle située à une position donnée dans l’ordre
+ *  de parcours (parcours en O(idx), préférer bc_supprimer_regle).
+ *
+ * Paramètres :
+ *  - BC  : pointeur vers la base de connaissances
+ *  - idx : position de la règle à supprimer
+ *
+ * Valeur de retour :
+ *  - true  : la suppression a été effectuée
+ *  - false : la position est invalide
+ *
+ * Variables locales :
+ *  - id : identifiant de la règle courante
+ */
+bool bc_supprimer_regle_index(BaseConnaissances *BC, size_t idx) {
+    // Vérification de la validité de la position
+    if (idx >= BC->size) return false;
+
+    // Parcours jusqu’à la règle à supprimer
+    RegleId id = bc_premiere(BC);
+    for (size_t i = 0; i < idx; i++) id = bc_suivante(BC, id);
+
+    return bc_supprimer_regle(BC, id);
+}
+
 /*
  * ------------------------------------------------------------
  * Fonction : bc_vider
@@ -197,22 +427,21 @@ bool bc_supprimer_regle_index(BaseConnaissances *BC, size_t idx) {
  *  - Aucune (void)
  *
  * Variables locales :
- *  - cur : pointeur pour parcourir les nœuds
- *  - nxt : pointeur vers le nœud suivant
+ *  - e : emplacement courant
  */
 void bc_vider(BaseConnaissances *BC) {
-    BCNode *cur = BC->head;
-
-    // Parcours et destruction de tous les nœuds
-    while (cur) {
-        BCNode *nxt = cur->next;
-        regle_detruire(&cur->regle);
-        free(cur);
-        cur = nxt;
+    // Destruction de toutes les règles
+    for (uint32_t e = BC->premier; e != BC_FIN; e = BC->emplacements[e].suiv) {
+        regle_detruire(&BC->emplacements[e].regle);
     }
+    mem_liberer(BC->alloc, BC->emplacements);
 
-    // Réinitialisation de la base de connaissances
-    bc_init(BC);
+    // Réinitialisation de la base de connaissances (l’allocateur et le
+    // compteur de versions sont conservés : une règle rechargée ne
+    // reprend pas la version d’une règle détruite)
+    uint32_t versions = BC->versions;
+    bc_init_avec(BC, BC->alloc);
+    BC->versions = versions;
 }
 
 /*
@@ -220,8 +449,8 @@ void bc_vider(BaseConnaissances *BC) {
  * Fonction : bc_afficher
  * ------------------------------------------------------------
  * Rôle :
- *  Affiche toutes les règles de la base de connaissances
- *  avec leur indice.
+ *  Affiche toutes les règles de la base de connaissances avec
+ *  leur numéro d’emplacement (stable entre deux suppressions).
  *
  * Paramètres :
  *  - BC : pointeur constant vers la base de connaissances
@@ -230,15 +459,204 @@ void bc_vider(BaseConnaissances *BC) {
  *  - Aucune (void)
  *
  * Variables locales :
- *  - i : indice de la règle affichée
- *  - n : pointeur pour parcourir les règles
+ *  - e : emplacement de la règle affichée
  */
 void bc_afficher(const BaseConnaissances *BC) {
-    size_t i = 0;
-
     // Parcours de toutes les règles pour affichage
-    for (BCNode *n = BC->head; n; n = n->next) {
-        printf("[%zu] ", i++);
-        regle_afficher(&n->regle);
+    for (uint32_t e = BC->premier; e != BC_FIN; e = BC->emplacements[e].suiv) {
+        printf("[%u] ", e);
+        regle_afficher(&BC->emplacements[e].regle);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : nettoyer_bornes
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire les espaces en début et en fin d’un segment de texte
+ *  (modifié sur place).
+ *
+ * Paramètres :
+ *  - s : début du segment
+ *
+ * Valeur de retour :
+ *  - pointeur vers le premier caractère non blanc du segment
+ *
+ * Variables locales :
+ *  - n : longueur restante du segment
+ */
+static char *nettoyer_bornes(char *s) {
+    while (*s && isspace((unsigned char)*s)) s++;
+
+    size_t n = strlen(s);
+    while (n > 0 && isspace((unsigned char)s[n - 1])) s[--n] = '\0';
+    return s;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : analyser_ligne
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Construit une règle à partir d’une ligne de la forme
+ *  "P1 AND P2 AND ... => C". Les prémisses peuvent être absentes
+ *  ("=> C") mais la conclusion est obligatoire.
+ *
+ * Paramètres :
+ *  - ligne : texte de la ligne (modifié sur place)
+ *  - R     : règle initialisée à remplir
+ *
+ * Valeur de retour :
+ *  - true  : la ligne est bien formée
+ *  - false : flèche ou conclusion manquante, prémisse vide
+ *            ou opérande de AND manquant
+ *
+ * Variables locales :
+ *  - fleche : position du séparateur "=>"
+ *  - cur    : début de la prémisse courante
+ *  - et     : position du prochain séparateur " AND "
+ *  - p      : prémisse courante sans les espaces de bord
+ */
+static bool analyser_ligne(char *ligne, Regle *R) {
+    char *fleche = strstr(ligne, "=>");
+    if (!fleche) return false;
+    *fleche = '\0';
+
+    // Conclusion (partie droite)
+    char *c = nettoyer_bornes(fleche + 2);
+    if (*c == '\0') return false;
+
+    // Prémisses (partie gauche) séparées par " AND "
+    char *cur = nettoyer_bornes(ligne);
+    while (*cur) {
+        char *et = strstr(cur, " AND ");
+        if (et) *et = '\0';
+
+        // Un "AND" isolé en bord de prémisse signale un opérande manquant
+        char *p = nettoyer_bornes(cur);
+        size_t n = strlen(p);
+        if (n == 0 || strcmp(p, "AND") == 0 || strncmp(p, "AND ", 4) == 0 ||
+            (n > 4 && strcmp(p + n - 4, " AND") == 0)) {
+            return false;
+        }
+        regle_ajouter_premisse(R, p);
+
+        if (!et) break;
+        cur = et + 5;
+    }
+
+    regle_definir_conclusion(R, c);
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_charger_flux
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit des règles depuis un flux texte et les ajoute en queue
+ *  de la base de connaissances. Les lignes vides et celles
+ *  commençant par '#' sont ignorées. Une ligne est lue en entier,
+ *  quelle que soit sa longueur (getline).
+ *
+ * Paramètres :
+ *  - BC : pointeur vers la base de connaissances
+ *  - f  : flux ouvert en lecture
+ *
+ * Valeur de retour :
+ *  - true  : toutes les lignes ont été chargées
+ *  - false : une ligne est mal formée (le chargement s’arrête,
+ *            les règles précédentes restent dans la base)
+ *
+ * Variables locales :
+ *  - buf    : tampon de lecture d’une ligne (agrandi par getline)
+ *  - cap    : taille allouée de buf
+ *  - numero : numéro de la ligne courante (pour les messages)
+ *  - R      : règle temporaire construite à partir de la ligne
+ */
+bool bc_charger_flux(BaseConnaissances *BC, FILE *f) {
+    char *buf = NULL;
+    size_t cap = 0;
+    size_t numero = 0;
+    bool ok = true;
+
+    while (getline(&buf, &cap, f) != -1) {
+        numero++;
+
+        char *l = nettoyer_bornes(buf);
+        if (*l == '\0' || *l == '#') continue;
+
+        Regle R;
+        regle_init_avec(&R, BC->alloc);
+        if (!analyser_ligne(l, &R)) {
+            fprintf(stderr, "Ligne %zu invalide (attendu : A AND B => C).\n", numero);
+            regle_detruire(&R);
+            ok = false;
+            break;
+        }
+
+        bc_ajouter_regle_en_queue(BC, &R);
+        regle_detruire(&R);
+    }
+    free(buf);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_charger_fichier
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ouvre un fichier de règles et le charge avec bc_charger_flux.
+ *
+ * Paramètres :
+ *  - BC     : pointeur vers la base de connaissances
+ *  - chemin : chemin du fichier de règles
+ *
+ * Valeur de retour :
+ *  - true  : fichier lu et chargé sans erreur
+ *  - false : fichier introuvable ou mal formé
+ */
+bool bc_charger_fichier(BaseConnaissances *BC, const char *chemin) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) {
+        perror(chemin);
+        return false;
+    }
+
+    TRACE_DEBUT("chargement_bc");
+    bool ok = bc_charger_flux(BC, f);
+    TRACE_FIN("chargement_bc");
+    fclose(f);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : bc_stats
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Relève la taille de la BC et la mémoire qu’elle occupe, en
+ *  un parcours des règles.
+ *
+ * Paramètres :
+ *  - BC : pointeur constant vers la base de connaissances
+ *  - s  : statistiques à remplir
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void bc_stats(const BaseConnaissances *BC, StatsBC *s) {
+    s->nb_regles = BC->size;
+    s->nb_emplacements = BC->nb_emplacements;
+    s->cap = BC->cap;
+    s->nb_premisses = 0;
+    s->octets_emplacements = (size_t)BC->cap * sizeof(BCEmplacement);
+    s->octets_regles = 0;
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        const Regle *R = bc_regle(BC, id);
+        s->nb_premisses += R->premisses.size;
+        s->octets_regles += regle_octets(R);
     }
 }
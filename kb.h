@@ -4,27 +4,82 @@
 #include "rule.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
-typedef struct BCNode {
+/*
+ * Identifiant stable d’une règle : (génération << 32) | emplacement.
+ * La génération d’un emplacement change à chaque suppression, si bien
+ * qu’un identifiant périmé n’est jamais confondu avec la règle qui
+ * réutilise l’emplacement.
+ * Version d’une règle : (version << 32) | emplacement. La version
+ * vient d’un compteur de la BC, pris à l’ajout et à chaque
+ * modification de la règle (identifiant inchangé) : elle date le
+ * contenu exact de la règle, par exemple pour la provenance.
+ */
+typedef uint64_t RegleId;
+
+#define REGLE_ID_INVALIDE 0
+#define BC_FIN UINT32_MAX
+
+typedef struct {
     Regle regle;
-    struct BCNode *next;
-} BCNode;
+    uint32_t generation;
+    uint32_t version;   // dernier ajout ou modification (compteur de la BC)
+    bool occupe;
+    uint32_t prec;   // ordre d’insertion (emplacements occupés)
+    uint32_t suiv;   // ordre d’insertion, ou prochain emplacement libre
+} BCEmplacement;
 
 typedef struct {
-    BCNode *head;
-    BCNode *tail;
-    size_t size;
+    BCEmplacement *emplacements;
+    uint32_t nb_emplacements;
+    uint32_t cap;
+    uint32_t premier;   // première règle dans l’ordre d’insertion
+    uint32_t dernier;
+    uint32_t libre;     // pile des emplacements libres
+    size_t size;        // nombre de règles
+    uint32_t versions;  // dernière version attribuée (conservée par bc_vider)
+    const Allocateur *alloc;   // emplacements et règles copiées
 } BaseConnaissances;
 
 void bc_init(BaseConnaissances *BC);
+void bc_init_avec(BaseConnaissances *BC, const Allocateur *A);
 bool bc_est_vide(const BaseConnaissances *BC);
 
-void bc_ajouter_regle_en_queue(BaseConnaissances *BC, const Regle *R); // copie profonde
+RegleId bc_ajouter_regle_en_queue(BaseConnaissances *BC, const Regle *R); // copie profonde
 const Regle *bc_tete(const BaseConnaissances *BC);
 
+/* Accès par identifiant en O(1) ; NULL si l’identifiant est périmé */
+Regle *bc_regle(const BaseConnaissances *BC, RegleId id);
+RegleId bc_id_emplacement(const BaseConnaissances *BC, size_t emplacement);
+uint64_t bc_version(const BaseConnaissances *BC, size_t emplacement);
+bool bc_supprimer_regle(BaseConnaissances *BC, RegleId id);
+bool bc_supprimer_premisse(BaseConnaissances *BC, RegleId id, const char *p);
+
+/* Parcours dans l’ordre d’insertion */
+RegleId bc_premiere(const BaseConnaissances *BC);
+RegleId bc_suivante(const BaseConnaissances *BC, RegleId id);
+
 bool bc_supprimer_regle_index(BaseConnaissances *BC, size_t idx);
 void bc_vider(BaseConnaissances *BC);
 
 void bc_afficher(const BaseConnaissances *BC);
 
+/* Mémoire de la BC : tableau d’emplacements et contenu des règles (octets demandés) */
+typedef struct {
+    size_t nb_regles;
+    size_t nb_emplacements;       // emplacements utilisés (occupés ou libres)
+    size_t cap;
+    size_t nb_premisses;
+    size_t octets_emplacements;
+    size_t octets_regles;         // listes de prémisses et conclusions
+} StatsBC;
+
+void bc_stats(const BaseConnaissances *BC, StatsBC *s);
+
+/* Format texte : une règle par ligne, "A AND B => C", '#' pour les commentaires */
+bool bc_charger_flux(BaseConnaissances *BC, FILE *f);
+bool bc_charger_fichier(BaseConnaissances *BC, const char *chemin);
+
 #endif
@@ -0,0 +1,254 @@
+/*
+ * kb2c : compile une base de connaissances (format texte de
+ * bc_charger_fichier) en code C spécialisé pour codegen.h.
+ *
+ * Usage : kb2c [--profil <fichier>] <entree.kb> <sortie.c> <nom>
+ */
+#include "compile.h"
+#include "kb.h"
+#include "profil.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ecrire_chaine
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit un littéral chaîne C en échappant les caractères
+ *  spéciaux et les octets non ASCII.
+ *
+ * Paramètres :
+ *  - out : fichier de sortie
+ *  - s   : chaîne à écrire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void ecrire_chaine(FILE *out, const char *s) {
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char *)s; *p; p++) {
+        if (*p == '"' || *p == '\\') fprintf(out, "\\%c", *p);
+        else if (*p < 0x20 || *p >= 0x7f) fprintf(out, "\\%03o", *p);
+        else fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+/* Renumérotation utilisée par qsort pour trier les noms */
+static const BCCompilee *tri_bc;
+static const uint32_t *tri_ancien;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : comparer_noms
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Compare deux nouveaux identifiants selon le nom de leur
+ *  proposition (pour qsort).
+ *
+ * Paramètres :
+ *  - a, b : pointeurs vers deux identifiants
+ *
+ * Valeur de retour :
+ *  - résultat de strcmp sur les noms
+ */
+static int comparer_noms(const void *a, const void *b) {
+    const char *na = symboles_nom(&tri_bc->symboles, tri_ancien[*(const uint32_t *)a]);
+    const char *nb = symboles_nom(&tri_bc->symboles, tri_ancien[*(const uint32_t *)b]);
+    return strcmp(na, nb);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : generer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Émet le code C d’une BC compilée. Les propositions sont
+ *  renumérotées : d’abord celles qui ne sont conclues par aucune
+ *  règle, puis les conclusions dans l’ordre de dépendance. Chaque
+ *  règle devient un test de masques constants par mot de 64 bits ;
+ *  les mots sont testés dans l’ordre des prémisses de la règle
+ *  (le premier contient la plus sélective après kb2c --profil).
+ *
+ * Paramètres :
+ *  - C      : BC compilée
+ *  - out    : fichier de sortie
+ *  - nom    : préfixe des symboles générés
+ *  - source : chemin de la BC (pour l’en-tête)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - A       : allocateur des tableaux de travail (système)
+ *  - ordre   : règles dans l’ordre de dépendance
+ *  - nouveau : ancien identifiant -> nouvel identifiant
+ *  - ancien  : nouvel identifiant -> ancien identifiant
+ *  - masques : masque de prémisses par mot pour la règle courante
+ *  - mots    : mots de la règle courante, dans l’ordre des prémisses
+ */
+static void generer(const BCCompilee *C, FILE *out, const char *nom, const char *source) {
+    size_t np = bcc_nb_propositions(C), nr = C->nb_regles;
+    size_t nb_mots = (np + 63) / 64;
+    const Allocateur *A = &allocateur_systeme;
+
+    uint32_t *ordre = (uint32_t *)mem_allouer(A, nr * sizeof(uint32_t));
+    bool acyclique = bcc_ordre_dependances(C, ordre);
+
+    // Renumérotation des propositions
+    uint32_t *nouveau = (uint32_t *)mem_allouer(A, np * sizeof(uint32_t));
+    uint32_t *ancien = (uint32_t *)mem_allouer(A, np * sizeof(uint32_t));
+    uint32_t suivant = 0;
+    for (size_t p = 0; p < np; p++) {
+        nouveau[p] = UINT32_MAX;
+        if (C->prod_debut[p] == C->prod_debut[p + 1]) nouveau[p] = suivant++;
+    }
+    for (size_t i = 0; i < nr; i++) {
+        PropId c = C->regles[ordre[i]].conclusion;
+        if (nouveau[c] == UINT32_MAX) nouveau[c] = suivant++;
+    }
+    for (size_t p = 0; p < np; p++) ancien[nouveau[p]] = (uint32_t)p;
+
+    fprintf(out, "/* Généré par kb2c depuis %s : ne pas modifier. */\n", source);
+    fprintf(out, "#include \"codegen.h\"\n\n");
+    fprintf(out, "#define NB_PROPOSITIONS %zu\n\n", np);
+
+    // Noms et index trié
+    fprintf(out, "static const char *const noms[NB_PROPOSITIONS + 1] = {\n");
+    for (size_t id = 0; id < np; id++) {
+        fprintf(out, "    ");
+        ecrire_chaine(out, symboles_nom(&C->symboles, ancien[id]));
+        fprintf(out, ",\n");
+    }
+    fprintf(out, "    0\n};\n\n");
+
+    uint32_t *tries = (uint32_t *)mem_allouer(A, np * sizeof(uint32_t));
+    for (size_t id = 0; id < np; id++) tries[id] = (uint32_t)id;
+    tri_bc = C;
+    tri_ancien = ancien;
+    qsort(tries, np, sizeof(uint32_t), comparer_noms);
+
+    fprintf(out, "static const uint32_t index_tries[NB_PROPOSITIONS + 1] = {\n   ");
+    for (size_t id = 0; id < np; id++) {
+        fprintf(out, " %u,", tries[id]);
+        if (id % 16 == 15) fprintf(out, "\n   ");
+    }
+    fprintf(out, " 0\n};\n\n");
+
+    // Règles
+    fprintf(out, "static void executer(uint64_t *f) {\n");
+    const char *retrait = "    ";
+    if (!acyclique) {
+        fprintf(out, "    int change;\n    do {\n        change = 0;\n");
+        retrait = "        ";
+    }
+
+    uint64_t *masques = (uint64_t *)mem_allouer_zero(A, nb_mots * sizeof(uint64_t));
+    size_t *mots = (size_t *)mem_allouer(A, nb_mots * sizeof(size_t));
+    for (size_t i = 0; i < nr; i++) {
+        const RegleCompilee *R = &C->regles[ordre[i]];
+        uint32_t c = nouveau[R->conclusion];
+
+        memset(masques, 0, nb_mots * sizeof(uint64_t));
+        size_t nb_utilises = 0;
+        for (uint32_t k = R->debut; k < R->debut + R->nb; k++) {
+            uint32_t p = nouveau[C->premisses[k]];
+            if (!masques[p / 64]) mots[nb_utilises++] = p / 64;
+            masques[p / 64] |= UINT64_C(1) << (p % 64);
+        }
+
+        fprintf(out, "%s/* R%u */\n", retrait, ordre[i]);
+        fprintf(out, "%sif (!(f[%u] & UINT64_C(0x%llx))", retrait, c / 64,
+                (unsigned long long)(UINT64_C(1) << (c % 64)));
+        for (size_t m = 0; m < nb_utilises; m++) {
+            size_t w = mots[m];
+            fprintf(out, "\n%s    && (f[%zu] & UINT64_C(0x%llx)) == UINT64_C(0x%llx)", retrait, w,
+                    (unsigned long long)masques[w], (unsigned long long)masques[w]);
+        }
+        fprintf(out, ") {\n%s    f[%u] |= UINT64_C(0x%llx);\n", retrait, c / 64,
+                (unsigned long long)(UINT64_C(1) << (c % 64)));
+        if (!acyclique) fprintf(out, "%s    change = 1;\n", retrait);
+        fprintf(out, "%s}\n", retrait);
+    }
+
+    if (!acyclique) fprintf(out, "    } while (change);\n");
+    if (nr == 0) fprintf(out, "    (void)f;\n");
+    fprintf(out, "}\n\n");
+
+    fprintf(out, "const BCGeneree %s_bc = {\n", nom);
+    fprintf(out, "    \"%s\", NB_PROPOSITIONS, noms, index_tries, executer\n};\n", nom);
+
+    mem_liberer(A, mots);
+    mem_liberer(A, masques);
+    mem_liberer(A, tries);
+    mem_liberer(A, ancien);
+    mem_liberer(A, nouveau);
+    mem_liberer(A, ordre);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : main
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Charge la BC, la compile et écrit le code C généré. Avec un
+ *  profil (LO21 --profil), les prémisses de chaque règle compilée
+ *  sont d’abord réordonnées par fréquence croissante.
+ *
+ * Paramètres :
+ *  - argc, argv : [--profil <fichier>] <entree.kb> <sortie.c> <nom>
+ *
+ * Valeur de retour :
+ *  - 0 en cas de succès, 1 sinon
+ */
+int main(int argc, char **argv) {
+    const char *chemin_profil = NULL;
+    if (argc > 2 && strcmp(argv[1], "--profil") == 0) {
+        chemin_profil = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc != 4) {
+        fprintf(stderr, "Usage : kb2c [--profil <fichier>] <entree.kb> <sortie.c> <nom>\n");
+        return 1;
+    }
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+    if (!bc_charger_fichier(&BC, argv[1])) {
+        bc_vider(&BC);
+        return 1;
+    }
+
+    BCCompilee C;
+    bcc_compiler(&C, &BC);
+
+    if (chemin_profil) {
+        ProfilPremisses P;
+        profil_init(&P);
+        bool lu = profil_charger(&P, chemin_profil);
+        if (lu) profil_ordonner_bcc(&C, &P);
+        profil_detruire(&P);
+        if (!lu) {
+            bcc_detruire(&C);
+            bc_vider(&BC);
+            return 1;
+        }
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out) {
+        perror(argv[2]);
+        bcc_detruire(&C);
+        bc_vider(&BC);
+        return 1;
+    }
+    generer(&C, out, argv[3], argv[1]);
+
+    bool ok = (fclose(out) == 0);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+    return ok ? 0 : 1;
+}
@@ -5,78 +5,58 @@
 
 /*
  * ------------------------------------------------------------
- * Fonction : xmalloc
+ * Fonction : elements
  * ------------------------------------------------------------
  * Rôle :
- *  Alloue dynamiquement un bloc mémoire de taille donnée.
- *  En cas d’échec de l’allocation, le programme est interrompu
- *  avec un message d’erreur.
+ *  Retourne le tableau qui contient effectivement les éléments :
+ *  le stockage interne ou le tableau alloué.
  *
  * Paramètres :
- *  - n : taille (en octets) de la mémoire à allouer
+ *  - L : pointeur vers la liste
  *
  * Valeur de retour :
- *  - pointeur vers la zone mémoire allouée
- *
- * Variables locales :
- *  - p : pointeur vers la mémoire allouée
+ *  - pointeur vers le premier élément
  */
-static void *xmalloc(size_t n) {
-    void *p = malloc(n);
-    if (!p) {
-        perror("malloc");
-        exit(EXIT_FAILURE);
-    }
-    return p;
+static char **elements(Liste *L) {
+    return L->cap > LISTE_INLINE ? L->u.tas : L->u.interne;
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : xstrdup
+ * Fonction : liste_init
  * ------------------------------------------------------------
  * Rôle :
- *  Duplique une chaîne de caractères en allouant dynamiquement
- *  la mémoire nécessaire.
+ *  Initialise une liste vide utilisant le stockage interne.
  *
  * Paramètres :
- *  - s : chaîne de caractères à copier
+ *  - L : pointeur vers la liste à initialiser
  *
  * Valeur de retour :
- *  - pointeur vers la nouvelle chaîne copiée
- *
- * Variables locales :
- *  - n : taille de la chaîne (caractère nul inclus)
- *  - p : pointeur vers la chaîne allouée
+ *  - Aucune (void)
  */
-static char *xstrdup(const char *s) {
-    // Calcul de la taille nécessaire pour la copie
-    size_t n = strlen(s) + 1;
-
-    // Allocation de la mémoire
-    char *p = (char *)xmalloc(n);
-
-    // Copie de la chaîne source
-    memcpy(p, s, n);
-    return p;
+void liste_init(Liste *L) {
+    liste_init_avec(L, NULL);
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : liste_init
+ * Fonction : liste_init_avec
  * ------------------------------------------------------------
  * Rôle :
- *  Initialise une liste chaînée vide.
+ *  Initialise une liste vide dont la mémoire sera fournie par
+ *  l’allocateur donné.
  *
  * Paramètres :
  *  - L : pointeur vers la liste à initialiser
+ *  - A : allocateur (NULL : allocateur système)
  *
  * Valeur de retour :
  *  - Aucune (void)
  */
-void liste_init(Liste *L) {
-    L->head = NULL;
-    L->tail = NULL;
+void liste_init_avec(Liste *L, const Allocateur *A) {
     L->size = 0;
+    L->cap = LISTE_INLINE;
+    L->alloc = A ? A : &allocateur_systeme;
 }
 
 /*
@@ -94,7 +74,7 @@ void liste_init(Liste *L) {
  *  - false : la liste contient au moins un élément
  */
 bool liste_est_vide(const Liste *L) {
-    return L->head == NULL;
+    return L->size == 0;
 }
 
 /*
@@ -102,7 +82,10 @@ bool liste_est_vide(const Liste *L) {
  * Fonction : liste_ajouter_en_queue
  * ------------------------------------------------------------
  * Rôle :
- *  Ajoute une chaîne de caractères à la fin de la liste chaînée.
+ *  Ajoute une copie d’une chaîne de caractères à la fin de la
+ *  liste. La capacité double lorsqu’elle est atteinte (ajout en
+ *  O(1) amorti) ; le premier dépassement du stockage interne
+ *  recopie ses éléments dans un tableau alloué.
  *
  * Paramètres :
  *  - L : pointeur vers la liste
@@ -112,51 +95,56 @@ bool liste_est_vide(const Liste *L) {
  *  - Aucune (void)
  *
  * Variables locales :
- *  - n : nouveau nœud ajouté à la liste
+ *  - cap   : nouvelle capacité
+ *  - t     : nouveau tableau d’éléments
+ *  - copie : copie de la chaîne ajoutée
  */
 void liste_ajouter_en_queue(Liste *L, const char *s) {
-    // Allocation et initialisation du nouveau nœud
-    ListNode *n = (ListNode *)xmalloc(sizeof(ListNode));
-    n->s = xstrdup(s);
-    n->next = NULL;
+    if (L->size == L->cap) {
+        size_t cap = L->cap * 2;
 
-    // Insertion du nœud en fin de liste
-    if (L->tail == NULL) {
-        L->head = L->tail = n;
-    } else {
-        L->tail->next = n;
-        L->tail = n;
+        if (L->cap == LISTE_INLINE) {
+            // Passage du stockage interne au tableau alloué
+            char **t = (char **)mem_allouer(L->alloc, cap * sizeof(char *));
+            memcpy(t, L->u.interne, L->size * sizeof(char *));
+            L->u.tas = t;
+        } else {
+            L->u.tas = (char **)mem_reallouer(L->alloc, L->u.tas, cap * sizeof(char *));
+        }
+        L->cap = cap;
     }
 
-    // Mise à jour de la taille de la liste
-    L->size++;
+    // Copie de la chaîne en fin de tableau (taille mise à jour après l’allocation)
+    char *copie = mem_dupliquer(L->alloc, s);
+    elements(L)[L->size++] = copie;
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : contient_rec_node
+ * Fonction : contient_rec_depuis
  * ------------------------------------------------------------
  * Rôle :
- *  Recherche récursivement une chaîne de caractères dans
- *  une liste chaînée à partir d’un nœud donné.
+ *  Recherche récursivement une chaîne de caractères dans la
+ *  liste à partir d’une position donnée.
  *
  * Paramètres :
- *  - node : pointeur vers le nœud courant
- *  - s    : chaîne de caractères recherchée
+ *  - L : pointeur constant vers la liste
+ *  - i : position courante
+ *  - s : chaîne de caractères recherchée
  *
  * Valeur de retour :
  *  - true  : la chaîne est trouvée
  *  - false : la chaîne est absente
  */
-static bool contient_rec_node(const ListNode *node, const char *s) {
+static bool contient_rec_depuis(const Liste *L, size_t i, const char *s) {
     // Cas de base : fin de liste
-    if (!node) return false;
+    if (i >= L->size) return false;
 
-    // Comparaison de la valeur du nœud courant
-    if (strcmp(node->s, s) == 0) return true;
+    // Comparaison de l’élément courant
+    if (strcmp(liste_element(L, i), s) == 0) return true;
 
-    // Appel récursif sur le nœud suivant
-    return contient_rec_node(node->next, s);
+    // Appel récursif sur l’élément suivant
+    return contient_rec_depuis(L, i + 1, s);
 }
 
 /*
@@ -176,7 +164,7 @@ static bool contient_rec_node(const ListNode *node, const char *s) {
  *  - false : la chaîne est absente
  */
 bool liste_contient_rec(const Liste *L, const char *s) {
-    return contient_rec_node(L->head, s);
+    return contient_rec_depuis(L, 0, s);
 }
 
 /*
@@ -185,7 +173,8 @@ bool liste_contient_rec(const Liste *L, const char *s) {
  * ------------------------------------------------------------
  * Rôle :
  *  Supprime la première occurrence d’une chaîne de caractères
- *  dans la liste chaînée.
+ *  dans la liste. Les éléments suivants sont décalés pour
+ *  conserver l’ordre.
  *
  * Paramètres :
  *  - L : pointeur vers la liste
@@ -196,37 +185,58 @@ bool liste_contient_rec(const Liste *L, const char *s) {
  *  - false : la chaîne n’a pas été trouvée
  *
  * Variables locales :
- *  - prev : pointeur vers le nœud précédent
- *  - cur  : pointeur vers le nœud courant
+ *  - e : tableau des éléments
+ *  - i : position de l’élément courant
  */
 bool liste_supprimer_premiere(Liste *L, const char *s) {
-    ListNode *prev = NULL;
-    ListNode *cur = L->head;
+    char **e = elements(L);
 
     // Parcours de la liste
-    while (cur) {
-        if (strcmp(cur->s, s) == 0) {
-            // Suppression du nœud courant
-            if (prev) prev->next = cur->next;
-            else L->head = cur->next;
-
-            // Mise à jour de la fin de liste si nécessaire
-            if (cur == L->tail) L->tail = prev;
-
-            // Libération de la mémoire
-            free(cur->s);
-            free(cur);
+    for (size_t i = 0; i < L->size; i++) {
+        if (strcmp(e[i], s) == 0) {
+            // Libération puis décalage des éléments suivants
+            mem_liberer(L->alloc, e[i]);
+            memmove(&e[i], &e[i + 1], (L->size - i - 1) * sizeof(char *));
             L->size--;
             return true;
         }
-        prev = cur;
-        cur = cur->next;
     }
 
     // Élément non trouvé
     return false;
 }
 
+/*
+ * ------------------------------------------------------------
+ * Fonction : liste_permuter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Réordonne les éléments sans copier les chaînes : l’élément i
+ *  devient l’ancien élément ordre[i].
+ *
+ * Paramètres :
+ *  - L     : pointeur vers la liste
+ *  - ordre : permutation de 0..L->size-1
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - e     : tableau des éléments
+ *  - copie : éléments dans l’ordre d’origine (sur la pile tant que
+ *            la liste tient dans le stockage interne)
+ */
+void liste_permuter(Liste *L, const uint32_t *ordre) {
+    char **e = elements(L);
+    char *interne[LISTE_INLINE];
+    char **copie = L->size > LISTE_INLINE ? (char **)mem_allouer(L->alloc, L->size * sizeof(char *)) : interne;
+
+    memcpy(copie, e, L->size * sizeof(char *));
+    for (size_t i = 0; i < L->size; i++) e[i] = copie[ordre[i]];
+
+    if (copie != interne) mem_liberer(L->alloc, copie);
+}
+
 /*
  * ------------------------------------------------------------
  * Fonction : liste_vider
@@ -242,22 +252,20 @@ bool liste_supprimer_premiere(Liste *L, const char *s) {
  *  - Aucune (void)
  *
  * Variables locales :
- *  - cur : pointeur pour parcourir les nœuds
- *  - nxt : pointeur vers le nœud suivant
+ *  - e : tableau des éléments
  */
 void liste_vider(Liste *L) {
-    ListNode *cur = L->head;
+    char **e = elements(L);
 
-    // Parcours et libération de tous les nœuds
-    while (cur) {
-        ListNode *nxt = cur->next;
-        free(cur->s);
-        free(cur);
-        cur = nxt;
-    }
+    // Libération de toutes les chaînes
+    for (size_t i = 0; i < L->size; i++) mem_liberer(L->alloc, e[i]);
+
+    // Libération du tableau alloué le cas échéant
+    if (L->cap > LISTE_INLINE) mem_liberer(L->alloc, L->u.tas);
 
-    // Réinitialisation de la liste
-    liste_init(L);
+    // Réinitialisation de la liste (l’allocateur est conservé)
+    L->size = 0;
+    L->cap = LISTE_INLINE;
 }
 
 /*
@@ -276,7 +284,7 @@ void liste_vider(Liste *L) {
  *  - NULL si la liste est vide
  */
 const char *liste_tete(const Liste *L) {
-    return L->head ? L->head->s : NULL;
+    return L->size ? liste_element(L, 0) : NULL;
 }
 
 /*
@@ -295,11 +303,32 @@ const char *liste_tete(const Liste *L) {
  *  - Aucune (void)
  *
  * Variables locales :
- *  - p : pointeur pour parcourir les éléments de la liste
+ *  - i : position de l’élément affiché
  */
 void liste_afficher(const Liste *L, const char *prefix) {
     // Parcours et affichage de chaque élément
-    for (ListNode *p = L->head; p; p = p->next) {
-        printf("%s%s\n", prefix, p->s);
+    for (size_t i = 0; i < L->size; i++) {
+        printf("%s%s\n", prefix, liste_element(L, i));
     }
 }
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : liste_octets
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule la mémoire demandée à l’allocateur par la liste : le
+ *  tableau alloué (au-delà du stockage interne) et les copies
+ *  des chaînes. La structure elle-même n’est pas comptée.
+ *
+ * Paramètres :
+ *  - L : pointeur constant vers la liste
+ *
+ * Valeur de retour :
+ *  - nombre d’octets
+ */
+size_t liste_octets(const Liste *L) {
+    size_t octets = L->cap > LISTE_INLINE ? L->cap * sizeof(char *) : 0;
+    for (size_t i = 0; i < L->size; i++) octets += strlen(liste_element(L, i)) + 1;
+    return octets;
+}
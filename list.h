@@ -1,31 +1,52 @@
- #ifndef LIST_H
+#ifndef LIST_H
 #define LIST_H
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "alloc.h"
 
-typedef struct ListNode {
-    char *s;
-    struct ListNode *next;
-} ListNode;
+/* Nombre d’éléments stockés dans la structure elle-même avant allocation */
+#define LISTE_INLINE 4
 
+/*
+ * Tableau dynamique de chaînes : les LISTE_INLINE premiers pointeurs
+ * sont rangés dans la structure, au-delà un tableau contigu est
+ * alloué et doublé à chaque dépassement.
+ */
 typedef struct {
-    ListNode *head;
-    ListNode *tail;
     size_t size;
+    size_t cap;                       // LISTE_INLINE tant que le stockage interne suffit
+    const Allocateur *alloc;          // copies des chaînes et tableau alloué
+    union {
+        char *interne[LISTE_INLINE];
+        char **tas;
+    } u;
 } Liste;
 
 void liste_init(Liste *L);
+void liste_init_avec(Liste *L, const Allocateur *A);
 bool liste_est_vide(const Liste *L);
 
 void liste_ajouter_en_queue(Liste *L, const char *s);
 bool liste_contient_rec(const Liste *L, const char *s);
 bool liste_supprimer_premiere(Liste *L, const char *s);
 
+/* Réordonne la liste : l’élément i devient l’ancien élément ordre[i] */
+void liste_permuter(Liste *L, const uint32_t *ordre);
+
 void liste_vider(Liste *L);
 
 const char *liste_tete(const Liste *L);
 
 void liste_afficher(const Liste *L, const char *prefix);
 
+/* Octets alloués par la liste (tableau hors structure et copies des chaînes) */
+size_t liste_octets(const Liste *L);
+
+/* Accès direct à un élément (0 <= i < L->size) */
+static inline const char *liste_element(const Liste *L, size_t i) {
+    return L->cap > LISTE_INLINE ? L->u.tas[i] : L->u.interne[i];
+}
+
 #endif
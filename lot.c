@@ -0,0 +1,212 @@
+#include "lot.h"
+#include "trace.h"
+#include <string.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compter_bits
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Nombre de bits à 1 d’un mot (un par fait nouveau).
+ *
+ * Paramètres :
+ *  - x : mot
+ *
+ * Valeur de retour :
+ *  - nombre de bits à 1
+ */
+static size_t compter_bits(uint64_t x) {
+    size_t n = 0;
+    for (; x; x &= x - 1) n++;
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Prépare une session par lots sur une BC compilée, avec
+ *  l’allocateur de la BC.
+ *
+ * Paramètres :
+ *  - L : session à initialiser
+ *  - C : BC compilée (doit survivre à la session)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void lot_init(SessionLot *L, const BCCompilee *C) {
+    lot_init_avec(L, C, C->symboles.alloc);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Comme lot_init, avec un allocateur propre à la session. L’ordre
+ *  des règles est calculé une fois ; aucune allocation n’a lieu
+ *  ensuite.
+ *
+ * Paramètres :
+ *  - L : session à initialiser
+ *  - C : BC compilée (doit survivre à la session)
+ *  - A : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void lot_init_avec(SessionLot *L, const BCCompilee *C, const Allocateur *A) {
+    size_t np = bcc_nb_propositions(C);
+
+    L->bc = C;
+    L->alloc = A ? A : &allocateur_systeme;
+    L->vrai = (uint64_t *)mem_allouer_zero(L->alloc, (np ? np : 1) * LOT_MOTS * sizeof(uint64_t));
+    L->ordre = (uint32_t *)mem_allouer(L->alloc, (C->nb_regles ? C->nb_regles : 1) * sizeof(uint32_t));
+    L->cyclique = !bcc_ordre_dependances(C, L->ordre);
+    L->passages = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_affirmer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Rend une proposition vraie pour une requête du lot. La
+ *  propagation n’a lieu qu’à l’appel de lot_saturer.
+ *
+ * Paramètres :
+ *  - L       : session
+ *  - requete : rang de la requête (moins que LOT_TAILLE)
+ *  - p       : proposition affirmée
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void lot_affirmer(SessionLot *L, size_t requete, PropId p) {
+    if (requete >= LOT_TAILLE || p >= bcc_nb_propositions(L->bc)) return;
+    L->vrai[(size_t)p * LOT_MOTS + requete / 64] |= (uint64_t)1 << (requete % 64);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_saturer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Sature toutes les requêtes du lot : pour chaque règle, dans
+ *  l’ordre des dépendances, ET des mots des prémisses (arrêté dès
+ *  qu’il est nul pour tout le lot), puis OU dans le mot de la
+ *  conclusion. Un seul passage suffit sans cycle ; sinon les
+ *  passages se répètent jusqu’à ce qu’aucun bit ne change.
+ *
+ * Paramètres :
+ *  - L : session
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits, toutes requêtes confondues
+ *
+ * Variables locales :
+ *  - acc    : ET des prémisses de la règle courante
+ *  - change : un bit a changé pendant le passage
+ */
+size_t lot_saturer(SessionLot *L) {
+    const BCCompilee *C = L->bc;
+    uint64_t *vrai = L->vrai;
+    size_t deduits = 0;
+    bool change;
+
+    TRACE_DEBUT("lot_saturer");
+    L->passages = 0;
+    do {
+        change = false;
+        L->passages++;
+        for (size_t i = 0; i < C->nb_regles; i++) {
+            const RegleCompilee *R = &C->regles[L->ordre[i]];
+            const PropId *prem = C->premisses + R->debut;
+            uint64_t acc[LOT_MOTS];
+            uint64_t reste = ~(uint64_t)0;
+
+            for (size_t w = 0; w < LOT_MOTS; w++) acc[w] = ~(uint64_t)0;
+            for (uint32_t k = 0; k < R->nb && reste; k++) {
+                const uint64_t *v = vrai + (size_t)prem[k] * LOT_MOTS;
+                reste = 0;
+                for (size_t w = 0; w < LOT_MOTS; w++) {
+                    acc[w] &= v[w];
+                    reste |= acc[w];
+                }
+            }
+            if (!reste) continue;
+
+            uint64_t *c = vrai + (size_t)R->conclusion * LOT_MOTS;
+            for (size_t w = 0; w < LOT_MOTS; w++) {
+                uint64_t nouveaux = acc[w] & ~c[w];
+                if (!nouveaux) continue;
+                c[w] |= nouveaux;
+                deduits += compter_bits(nouveaux);
+                change = true;
+            }
+        }
+    } while (change && L->cyclique);
+    TRACE_FIN("lot_saturer");
+    return deduits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_est_vrai
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si une proposition est vraie pour une requête du lot.
+ *
+ * Paramètres :
+ *  - L       : session
+ *  - requete : rang de la requête
+ *  - p       : proposition testée
+ *
+ * Valeur de retour :
+ *  - true si le fait est connu (affirmé ou déduit)
+ */
+bool lot_est_vrai(const SessionLot *L, size_t requete, PropId p) {
+    if (requete >= LOT_TAILLE || p >= bcc_nb_propositions(L->bc)) return false;
+    return (L->vrai[(size_t)p * LOT_MOTS + requete / 64] >> (requete % 64)) & 1u;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_reinitialiser
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Remet toutes les requêtes du lot à vide (lot suivant).
+ *
+ * Paramètres :
+ *  - L : session
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void lot_reinitialiser(SessionLot *L) {
+    memset(L->vrai, 0, bcc_nb_propositions(L->bc) * LOT_MOTS * sizeof(uint64_t));
+    L->passages = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère les tableaux de la session (la BC compilée n’est pas
+ *  touchée).
+ *
+ * Paramètres :
+ *  - L : session à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void lot_detruire(SessionLot *L) {
+    mem_liberer(L->alloc, L->vrai);
+    mem_liberer(L->alloc, L->ordre);
+    L->vrai = NULL;
+    L->ordre = NULL;
+}
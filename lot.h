@@ -0,0 +1,46 @@
+#ifndef LOT_H
+#define LOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+
+/*
+ * Évaluation par lots en tranches de bits : LOT_TAILLE requêtes
+ * indépendantes sont saturées ensemble sur la même BC compilée.
+ * Chaque proposition porte LOT_MOTS mots de 64 bits, un bit par
+ * requête ; une règle devient un ET mot à mot de ses prémisses, ajouté
+ * par OU au mot de sa conclusion. Les règles sont parcourues dans
+ * l’ordre des dépendances : une BC sans cycle est saturée en un seul
+ * passage, une BC cyclique est reprise jusqu’au point fixe. Le
+ * parcours des règles est ainsi partagé par tout le lot.
+ *
+ * Les mots d’une proposition sont contigus et en nombre constant :
+ * compilée avec -O2 -mavx2 (ou -mavx512f et LOT_MOTS 8), la boucle sur
+ * les mots est vectorisée par le compilateur, sans code spécifique.
+ */
+
+#ifndef LOT_MOTS
+#define LOT_MOTS 4
+#endif
+#define LOT_TAILLE (LOT_MOTS * 64)
+
+typedef struct {
+    const BCCompilee *bc;
+    uint64_t *vrai;         // par proposition : LOT_MOTS mots (bit q : requête q)
+    uint32_t *ordre;        // règles dans l’ordre des dépendances
+    bool cyclique;          // une conclusion dépend d’elle-même : point fixe
+    size_t passages;        // passages sur les règles au dernier lot_saturer
+    const Allocateur *alloc;
+} SessionLot;
+
+void lot_init(SessionLot *L, const BCCompilee *C);
+void lot_init_avec(SessionLot *L, const BCCompilee *C, const Allocateur *A);
+void lot_affirmer(SessionLot *L, size_t requete, PropId p);
+size_t lot_saturer(SessionLot *L);
+bool lot_est_vrai(const SessionLot *L, size_t requete, PropId p);
+void lot_reinitialiser(SessionLot *L);
+void lot_detruire(SessionLot *L);
+
+#endif
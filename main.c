@@ -1,8 +1,22 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "inference.h"
+#include "abduction.h"
+#include "compile.h"
+#include "datalog.h"
+#include "diagramme.h"
+#include "shard.h"
+#include "stream.h"
 #include "utils.h"
 #include "hash.h"
+#include "fermeture.h"
+#include "journal.h"
+#include "lot.h"
+#include "profil.h"
 #include "tests.h"
+#include "trace.h"
 
 /*
  * ------------------------------------------------------------
@@ -31,6 +45,12 @@ static void menu_afficher(void) {
     printf("9) Supprimer tous les faits\n");
     printf("10) Supprimer une prémisse d'une règle\n");
     printf("11) Phase de test\n");
+    printf("12) Lancer l'inférence Datalog (règles à variables)\n");
+    printf("13) Expliquer un fait (preuve)\n");
+    printf("14) Réordonner les prémisses (profil)\n");
+    printf("15) Statistiques (mémoire, hachage)\n");
+    printf("16) Explorer des hypothèses (sans modifier les faits)\n");
+    printf("17) Diagnostic : faits manquants pour une observation\n");
     printf("0) Quitter\n");
 }
 
@@ -45,6 +65,7 @@ static void menu_afficher(void) {
  *
  * Paramètres :
  *  - BC : pointeur vers la base de connaissances
+ *  - J  : journal des modifications (NULL si désactivé)
  *
  * Valeur de retour :
  *  - Aucune (void)
@@ -53,7 +74,7 @@ static void menu_afficher(void) {
  *  - R   : règle temporaire construite à partir des entrées utilisateur
  *  - buf : tampon utilisé pour la saisie des chaînes de caractères
  */
-static void ajouter_regle(BaseConnaissances *BC) {
+static void ajouter_regle(BaseConnaissances *BC, Journal *J) {
     Regle R;
     regle_init(&R);
 
@@ -82,6 +103,7 @@ static void ajouter_regle(BaseConnaissances *BC) {
 
     // Ajout de la règle à la base de connaissances
     bc_ajouter_regle_en_queue(BC, &R);
+    journal_regle_ajoutee(J, &R);
 
     // Libération de la règle temporaire
     regle_detruire(&R);
@@ -98,6 +120,7 @@ static void ajouter_regle(BaseConnaissances *BC) {
  *
  * Paramètres :
  *  - BF : pointeur vers la base de faits
+ *  - J  : journal des modifications (NULL si désactivé)
  *
  * Valeur de retour :
  *  - Aucune (void)
@@ -105,14 +128,14 @@ static void ajouter_regle(BaseConnaissances *BC) {
  * Variables locales :
  *  - buf : tampon de saisie du fait
  */
-static void ajouter_fait(BaseFaits *BF) {
+static void ajouter_fait(BaseFaits *BF, Journal *J) {
     char buf[256];
     if (!lire_ligne("Fait: ", buf, sizeof(buf))) return;
     if (buf[0] == '\0') return;
 
-    // Vérifie l’unicité du fait avant insertion
-    if (!liste_contient_rec(BF, buf)) {
-        liste_ajouter_en_queue(BF, buf);
+    // Insertion si le fait est absent (test haché)
+    if (bf_ajouter(BF, buf)) {
+        journal_fait_ajoute(J, buf);
         printf("Fait ajouté.\n");
     } else {
         printf("Déjà présent.\n");
@@ -125,29 +148,34 @@ static void ajouter_fait(BaseFaits *BF) {
  * ------------------------------------------------------------
  * Rôle :
  *  Supprime une règle de la base de connaissances à partir
- *  de son indice.
+ *  du numéro affiché par la liste des règles (en O(1)).
  *
  * Paramètres :
  *  - BC : pointeur vers la base de connaissances
+ *  - J  : journal des modifications (NULL si désactivé)
  *
  * Valeur de retour :
  *  - Aucune (void)
  *
  * Variables locales :
- *  - idx : indice de la règle à supprimer
+ *  - idx : numéro de la règle à supprimer
  */
-static void supprimer_regle(BaseConnaissances *BC) {
+static void supprimer_regle(BaseConnaissances *BC, Journal *J) {
     int idx;
     if (!lire_entier("Index: ", &idx) || idx < 0) {
         printf("Index invalide.\n");
         return;
     }
 
-    // Suppression de la règle si l’indice est valide
-    if (bc_supprimer_regle_index(BC, (size_t)idx))
-        printf("Règle supprimée.\n");
-    else
+    // Suppression de la règle si le numéro désigne une règle présente
+    RegleId id = bc_id_emplacement(BC, (size_t)idx);
+    if (id == REGLE_ID_INVALIDE) {
         printf("Index hors limites.\n");
+        return;
+    }
+    journal_regle_supprimee(J, BC, id);
+    bc_supprimer_regle(BC, id);
+    printf("Règle supprimée.\n");
 }
 
 /*
@@ -159,6 +187,7 @@ static void supprimer_regle(BaseConnaissances *BC) {
  *
  * Paramètres :
  *  - BF : pointeur vers la base de faits
+ *  - J  : journal des modifications (NULL si désactivé)
  *
  * Valeur de retour :
  *  - Aucune (void)
@@ -166,14 +195,15 @@ static void supprimer_regle(BaseConnaissances *BC) {
  * Variables locales :
  *  - buf : tampon contenant le nom du fait à supprimer
  */
-static void supprimer_fait(BaseFaits *BF) {
+static void supprimer_fait(BaseFaits *BF, Journal *J) {
     char buf[256];
     if (!lire_ligne("Fait à supprimer: ", buf, sizeof(buf))) return;
     if (buf[0] == '\0') return;
 
-    if (liste_supprimer_premiere(BF, buf))
+    if (bf_supprimer(BF, buf)) {
+        journal_fait_supprime(J, buf);
         printf("Fait supprimé.\n");
-    else
+    } else
         printf("Introuvable.\n");
 }
 
@@ -183,45 +213,594 @@ static void supprimer_fait(BaseFaits *BF) {
  * ------------------------------------------------------------
  * Rôle :
  *  Supprime une prémisse spécifique d’une règle donnée,
- *  identifiée par son indice dans la base de connaissances.
+ *  identifiée par son numéro dans la liste des règles.
  *
  * Paramètres :
  *  - BC : pointeur vers la base de connaissances
+ *  - J  : journal des modifications (NULL si désactivé)
  *
  * Valeur de retour :
  *  - Aucune (void)
  *
  * Variables locales :
- *  - idx  : indice de la règle concernée
- *  - node : pointeur vers le nœud contenant la règle
- *  - buf  : tampon contenant la prémisse à supprimer
+ *  - idx : numéro de la règle concernée
+ *  - id  : identifiant de la règle
+ *  - buf : tampon contenant la prémisse à supprimer
  */
-static void supprimer_premisse(BaseConnaissances *BC) {
+static void supprimer_premisse(BaseConnaissances *BC, Journal *J) {
     int idx;
     if (!lire_entier("Index de la règle: ", &idx) || idx < 0) {
         printf("Index invalide.\n");
         return;
     }
-    if ((size_t)idx >= BC->size) {
+
+    // Accès direct à la règle ciblée
+    RegleId id = bc_id_emplacement(BC, (size_t)idx);
+    if (id == REGLE_ID_INVALIDE) {
         printf("Index hors limites.\n");
         return;
     }
 
-    // Accès à la règle ciblée
-    BCNode *node = BC->head;
-    for (int i = 0; i < idx; i++) node = node->next;
-
     char buf[256];
     if (!lire_ligne("Prémisse à supprimer (texte exact): ", buf, sizeof(buf))) return;
     if (buf[0] == '\0') return;
 
     // Suppression de la prémisse dans la règle
-    if (regle_supprimer_premisse(&node->regle, buf))
+    if (bc_supprimer_premisse(BC, id, buf)) {
+        journal_premisse_supprimee(J, BC, id, buf);
         printf("Prémisse supprimée.\n");
-    else
+    } else
         printf("Prémisse introuvable.\n");
 }
 
+/*
+ * ------------------------------------------------------------
+ * Fonction : journaliser_faits
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise les faits ajoutés à la BF à partir d’un
+ *  emplacement (faits importés ou déduits par une inférence).
+ *
+ * Paramètres :
+ *  - J     : journal (NULL si désactivé)
+ *  - BF    : base de faits
+ *  - avant : premier emplacement à journaliser
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void journaliser_faits(Journal *J, const BaseFaits *BF, size_t avant) {
+    if (!J) return;
+    for (size_t i = avant; i < bf_nb_emplacements(BF); i++) {
+        const char *fait = bf_emplacement(BF, i);
+        if (fait) journal_fait_ajoute(J, fait);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : expliquer_fait
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Demande un fait et affiche sa preuve d’après la provenance
+ *  enregistrée par la dernière inférence (option 3).
+ *
+ * Paramètres :
+ *  - BC : base de connaissances
+ *  - BF : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - buf : nom du fait
+ */
+static void expliquer_fait(const BaseConnaissances *BC, const BaseFaits *BF) {
+    char buf[256];
+    if (!lire_ligne("Fait à expliquer: ", buf, sizeof(buf))) return;
+    if (buf[0] == '\0') return;
+
+    if (inference_expliquer(BC, BF, buf, stdout) == 0) printf("Fait inconnu.\n");
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : explorer_hypotheses
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Demande des hypothèses une à une ; chacune est ajoutée aux
+ *  précédentes sous un point de retour, puis ses conséquences
+ *  sont déduites et affichées. À la fin, la base de faits est
+ *  rétablie en défaisant les seuls ajouts.
+ *
+ * Paramètres :
+ *  - BC : base de connaissances
+ *  - BF : base de faits (inchangée au retour)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - depart : point de retour initial
+ *  - avant  : premier emplacement des faits de l’hypothèse courante
+ */
+static void explorer_hypotheses(const BaseConnaissances *BC, BaseFaits *BF) {
+    OptionsInference O;
+    options_inference_init(&O);
+    O.silencieux = true;
+
+    size_t depart = bf_point(BF), taille = bf_taille(BF);
+    char buf[256];
+    while (lire_ligne("Hypothèse (vide pour terminer): ", buf, sizeof(buf)) && buf[0] != '\0') {
+        size_t avant = bf_nb_emplacements(BF);
+        if (!bf_ajouter(BF, buf)) {
+            printf("Déjà vrai.\n");
+            continue;
+        }
+        moteur_inference_opts(BC, BF, &O);
+        printf("Conséquences :");
+        for (size_t i = avant + 1; i < bf_nb_emplacements(BF); i++) {
+            if (bf_emplacement(BF, i)) printf(" %s", bf_emplacement(BF, i));
+        }
+        printf("%s\n", bf_nb_emplacements(BF) == avant + 1 ? " (aucune)" : "");
+    }
+
+    printf("%zu fait(s) retiré(s), base de faits rétablie.\n", bf_taille(BF) - taille);
+    bf_revenir(BF, depart);
+    bf_valider(BF);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : diagnostic_abductif
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Demande une observation et affiche les ensembles minimaux de
+ *  faits de base qui, ajoutés aux faits actuels, la déduiraient.
+ *  Le nombre et la taille des explications sont bornés pour que
+ *  la réponse reste immédiate sur une grande BC.
+ *
+ * Paramètres :
+ *  - BC : base de connaissances
+ *  - BF : base de faits (faits déjà connus)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - C      : BC compilée
+ *  - connus : par proposition, fait présent dans la BF
+ *  - E      : explications trouvées
+ */
+static void diagnostic_abductif(const BaseConnaissances *BC, const BaseFaits *BF) {
+    char buf[256];
+    if (!lire_ligne("Observation à expliquer: ", buf, sizeof(buf))) return;
+    if (buf[0] == '\0') return;
+
+    BCCompilee C;
+    bcc_compiler(&C, BC);
+    PropId but = symboles_chercher(&C.symboles, buf);
+    if (but == PROP_AUCUNE) {
+        printf("Proposition absente de la BC.\n");
+        bcc_detruire(&C);
+        return;
+    }
+
+    uint8_t *connus = (uint8_t *)calloc(bcc_nb_propositions(&C), 1);
+    if (!connus) {
+        perror("calloc");
+        bcc_detruire(&C);
+        return;
+    }
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *fait = bf_emplacement(BF, i);
+        PropId p = fait ? symboles_chercher(&C.symboles, fait) : PROP_AUCUNE;
+        if (p != PROP_AUCUNE) connus[p] = 1;
+    }
+
+    OptionsAbduction O;
+    abduction_options_init(&O);
+    O.max_explications = 20;
+    O.max_taille = 8;
+    O.connus = connus;
+
+    Explications E;
+    if (abduire(&C, but, &O, &E) == 0) {
+        printf("Aucune explication (au plus %zu fait(s) par explication).\n", O.max_taille);
+    } else if (E.e[0].nb == 0) {
+        printf("Déjà déductible des faits actuels.\n");
+    } else {
+        for (size_t i = 0; i < E.nb; i++) {
+            printf("%zu) {", i + 1);
+            for (uint32_t j = 0; j < E.e[i].nb; j++)
+                printf("%s %s", j ? "," : "", symboles_nom(&C.symboles, E.e[i].faits[j]));
+            printf(" }\n");
+        }
+        if (!E.complet) printf("(liste limitée aux %zu plus petites)\n", O.max_explications);
+    }
+
+    explications_detruire(&E);
+    free(connus);
+    bcc_detruire(&C);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : inference_datalog
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Interprète les règles de la BC comme un programme Datalog
+ *  (atomes à variables) et ajoute à la BF les faits déduits.
+ *
+ * Paramètres :
+ *  - BC : base de connaissances
+ *  - BF : base de faits enrichie
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - P     : programme compilé
+ *  - avant : premier emplacement des faits déduits
+ */
+static void inference_datalog(const BaseConnaissances *BC, BaseFaits *BF) {
+    ProgrammeDatalog P;
+    if (!datalog_compiler(&P, BC)) {
+        pause_console();
+        return;
+    }
+
+    size_t avant = bf_nb_emplacements(BF);
+    size_t deduits = datalog_evaluer(&P, BF);
+    for (size_t i = avant; i < bf_nb_emplacements(BF); i++) {
+        const char *fait = bf_emplacement(BF, i);
+        if (fait) printf("Déduit : %s\n", fait);
+    }
+    printf("%zu fait(s) déduit(s) en %zu itération(s).\n", deduits, P.iterations);
+
+    datalog_detruire(&P);
+    pause_console();
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mode_flux
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Exécute le mode flux : compile la base de connaissances puis
+ *  lit des faits sur l’entrée standard et écrit les faits déduits
+ *  sur la sortie standard au fur et à mesure.
+ *
+ * Paramètres :
+ *  - BC      : base de connaissances chargée
+ *  - base    : faits pouvant arriver sur l’entrée (--entrees ; NULL : tous)
+ *  - nb_base : nombre de faits de base
+ *
+ * Valeur de retour :
+ *  - code de sortie du programme
+ *
+ * Variables locales :
+ *  - C     : BC compilée
+ *  - bilan : compteurs de fin de flux
+ */
+static int mode_flux(const BaseConnaissances *BC, const char *const *base, size_t nb_base) {
+    if (bc_est_vide(BC)) {
+        fprintf(stderr, "Mode flux : BC vide (utiliser --kb <fichier>).\n");
+        return 1;
+    }
+
+    BCCompilee C;
+    bcc_compiler(&C, BC);
+
+    // Règles qui ne peuvent pas se déclencher pour ce déploiement
+    if (base) {
+        PropId *ids = (PropId *)malloc((nb_base ? nb_base : 1) * sizeof(PropId));
+        size_t n = 0, total = C.nb_regles;
+        for (size_t i = 0; ids && i < nb_base; i++) {
+            PropId p = symboles_chercher(&C.symboles, base[i]);
+            if (p != PROP_AUCUNE) ids[n++] = p;
+        }
+        size_t retirees = ids ? bcc_elaguer(&C, ids, n) : 0;
+        fprintf(stderr, "Élagage : %zu règle(s) sur %zu retirée(s).\n", retirees, total);
+        free(ids);
+    }
+
+    BilanFlux bilan;
+    bool ok = flux_executer(&C, stdin, stdout, &bilan);
+    if (ok) {
+        fprintf(stderr, "Flux terminé : %zu faits lus (%zu inconnus), %zu déduits.\n",
+                bilan.lus, bilan.inconnus, bilan.deduits);
+    } else {
+        fprintf(stderr, "Mode flux : impossible de démarrer les threads.\n");
+    }
+
+    bcc_detruire(&C);
+    return ok ? 0 : 1;
+}
+
+/* Taille maximale du diagramme de décision (mode_lot) */
+#define DIAGRAMME_MAX_NOEUDS 100000
+
+/* Requête d’un lot : feuille du diagramme, ou NULL (rang suivant de la SessionLot) */
+typedef struct {
+    const PropId *feuille;
+    uint32_t nb;
+} RequeteLot;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ecrire_lot
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Sature les requêtes du lot confiées à la SessionLot, puis écrit
+ *  pour chaque requête, dans l’ordre du fichier, une ligne avec
+ *  ses faits déduits (séparés par des espaces, par identifiant
+ *  croissant comme les feuilles du diagramme).
+ *
+ * Paramètres :
+ *  - C     : BC compilée
+ *  - L     : lot dont les faits des requêtes sont affirmés
+ *  - avant : tampon de la taille de L->vrai (faits affirmés)
+ *  - R     : requêtes du lot, dans l’ordre du fichier
+ *  - nb    : nombre de requêtes du lot
+ *  - out   : flux de sortie
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits dans le lot
+ *
+ * Variables locales :
+ *  - q : rang de la requête courante dans la SessionLot
+ */
+static size_t ecrire_lot(const BCCompilee *C, SessionLot *L, uint64_t *avant, const RequeteLot *R, size_t nb,
+                         FILE *out) {
+    size_t np = bcc_nb_propositions(C);
+    size_t deduits = 0, q = 0;
+
+    for (size_t i = 0; i < nb; i++)
+        if (!R[i].feuille) q++;
+    if (q) {
+        memcpy(avant, L->vrai, np * LOT_MOTS * sizeof(uint64_t));
+        lot_saturer(L);
+    }
+
+    q = 0;
+    for (size_t i = 0; i < nb; i++) {
+        const char *sep = "";
+        if (R[i].feuille) {
+            for (uint32_t k = 0; k < R[i].nb; k++) {
+                fprintf(out, "%s%s", sep, symboles_nom(&C->symboles, R[i].feuille[k]));
+                sep = " ";
+            }
+            deduits += R[i].nb;
+        } else {
+            for (PropId p = 0; p < np; p++) {
+                if (!lot_est_vrai(L, q, p) || ((avant[(size_t)p * LOT_MOTS + q / 64] >> (q % 64)) & 1u)) continue;
+                fprintf(out, "%s%s", sep, symboles_nom(&C->symboles, p));
+                sep = " ";
+                deduits++;
+            }
+            q++;
+        }
+        fputc('\n', out);
+    }
+    lot_reinitialiser(L);
+    return deduits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : mode_lot
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Exécute le mode par lots : chaque ligne du fichier est une
+ *  requête indépendante (faits séparés par des espaces, '#' pour
+ *  les commentaires). Si la BC se prête au diagramme de décision,
+ *  une requête qui n’affirme que des entrées y est évaluée d’un
+ *  seul chemin ; les autres (toutes, sinon) sont saturées ensemble
+ *  en tranches de bits. Les requêtes sont écrites LOT_TAILLE à la
+ *  fois, une ligne de faits déduits par requête, dans l’ordre du
+ *  fichier. Le bilan (stderr) indique aussi l’éligibilité de la
+ *  BC au diagramme et sa taille.
+ *
+ * Paramètres :
+ *  - BC     : base de connaissances chargée
+ *  - chemin : fichier des requêtes
+ *
+ * Valeur de retour :
+ *  - code de sortie du programme
+ *
+ * Variables locales :
+ *  - L        : session par lots
+ *  - D        : diagramme de décision (diag : BC éligible)
+ *  - buf      : ligne courante, lue en entier (une ligne, une requête)
+ *  - donne    : par proposition, affirmée par la requête courante
+ *  - faits    : faits connus de la requête courante, sans doublon
+ *  - R        : requêtes du lot en cours (nb), dont en_lot dans L
+ *  - inconnus : faits absents de la BC (ignorés)
+ */
+static int mode_lot(const BaseConnaissances *BC, const char *chemin) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) {
+        perror(chemin);
+        return 1;
+    }
+
+    BCCompilee C;
+    SessionLot L;
+    Diagramme D;
+    bcc_compiler(&C, BC);
+    lot_init(&L, &C);
+    bool diag = diagramme_compiler(&D, &C, DIAGRAMME_MAX_NOEUDS);
+    size_t np = bcc_nb_propositions(&C);
+    uint64_t *avant = (uint64_t *)malloc((np + 1) * LOT_MOTS * sizeof(uint64_t));
+    uint8_t *donne = (uint8_t *)calloc(np + 1, 1);
+    PropId *faits = (PropId *)malloc((np + 1) * sizeof(PropId));
+    if (!avant || !donne || !faits) {
+        perror("malloc");
+        free(faits);
+        free(donne);
+        free(avant);
+        diagramme_detruire(&D);
+        lot_detruire(&L);
+        bcc_detruire(&C);
+        fclose(f);
+        return 1;
+    }
+
+    RequeteLot R[LOT_TAILLE];
+    char *buf = NULL;
+    size_t cap = 0;
+    size_t nb = 0, en_lot = 0, requetes = 0, lots = 0, par_diagramme = 0, deduits = 0, inconnus = 0;
+    while (getline(&buf, &cap, f) != -1) {
+        if (buf[0] == '#') continue;
+        size_t nb_faits = 0;
+        bool entrees_seules = diag;
+        for (char *mot = strtok(buf, " \t\r\n"); mot; mot = strtok(NULL, " \t\r\n")) {
+            PropId p = symboles_chercher(&C.symboles, mot);
+            if (p == PROP_AUCUNE) {
+                inconnus++;
+                continue;
+            }
+            if (donne[p]) continue;
+            donne[p] = 1;
+            faits[nb_faits++] = p;
+            if (diag && D.conclue[p]) entrees_seules = false;
+        }
+        requetes++;
+
+        if (entrees_seules) {
+            R[nb].nb = (uint32_t)diagramme_evaluer(&D, donne, &R[nb].feuille);
+            par_diagramme++;
+        } else {
+            for (size_t i = 0; i < nb_faits; i++) lot_affirmer(&L, en_lot, faits[i]);
+            R[nb].feuille = NULL;
+            en_lot++;
+        }
+        for (size_t i = 0; i < nb_faits; i++) donne[faits[i]] = 0;
+
+        if (++nb == LOT_TAILLE) {
+            deduits += ecrire_lot(&C, &L, avant, R, nb, stdout);
+            lots++;
+            nb = en_lot = 0;
+        }
+    }
+    if (nb) {
+        deduits += ecrire_lot(&C, &L, avant, R, nb, stdout);
+        lots++;
+    }
+    fprintf(stderr, "Lots : %zu requête(s) en %zu lot(s) de %d, dont %zu par diagramme de décision, "
+            "%zu fait(s) déduit(s), %zu fait(s) inconnu(s)%s.\n",
+            requetes, lots, LOT_TAILLE, par_diagramme, deduits, inconnus,
+            L.cyclique ? ", BC cyclique (point fixe)" : "");
+    if (diag) {
+        fprintf(stderr, "Diagramme : %u entrée(s), %zu nœud(s), %zu feuille(s).\n", D.nb_entrees, D.nb_noeuds,
+                D.nb_feuilles);
+    } else if (D.motif == DIAG_CYCLE) {
+        fprintf(stderr, "Diagramme : non éligible (cycle entre les règles).\n");
+    } else {
+        fprintf(stderr, "Diagramme : non éligible (plus de %d nœuds).\n", DIAGRAMME_MAX_NOEUDS);
+    }
+
+    free(faits);
+    free(buf);
+    free(donne);
+    free(avant);
+    diagramme_detruire(&D);
+    lot_detruire(&L);
+    bcc_detruire(&C);
+    fclose(f);
+    return 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : afficher_stats
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit l’état de santé des structures : taille et mémoire de
+ *  la BC et de la BF, occupation de l’index haché des faits
+ *  (alvéoles, plus longue chaîne, charge, sondage moyen).
+ *  Un parcours de chaque structure, sans compilation : assez
+ *  léger pour être relevé régulièrement.
+ *
+ * Paramètres :
+ *  - out : flux de sortie
+ *  - BC  : base de connaissances
+ *  - BF  : base de faits
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - sc : statistiques de la BC
+ *  - sf : statistiques de la BF (et de son index)
+ */
+static void afficher_stats(FILE *out, const BaseConnaissances *BC, const BaseFaits *BF) {
+    StatsBC sc;
+    StatsFaits sf;
+    bc_stats(BC, &sc);
+    bf_stats(BF, &sf);
+    const StatsHash *h = &sf.index;
+
+    fprintf(out, "=== Statistiques ===\n");
+    fprintf(out, "BC    : %zu règle(s), %zu prémisse(s), %zu/%zu emplacement(s), "
+            "%zu o (emplacements) + %zu o (règles)\n", sc.nb_regles, sc.nb_premisses, sc.nb_emplacements, sc.cap,
+            sc.octets_emplacements, sc.octets_regles);
+    fprintf(out, "BF    : %zu fait(s), %zu/%zu emplacement(s), %zu o (ordre, provenance)\n", sf.nb_faits,
+            sf.nb_emplacements, sf.cap, sf.octets_ordre);
+    fprintf(out, "Index : %zu élément(s), %zu/%zu alvéole(s) occupée(s), charge %.2f, chaîne max %zu, "
+            "sondage moyen %.2f (présent) / %.2f (absent), %zu o\n", h->nb_elements, h->alveoles_occupees,
+            h->nb_alveoles, h->charge, h->chaine_max, h->sondes_presente, h->charge, h->octets);
+    fprintf(out, "Total : %zu o\n", sc.octets_emplacements + sc.octets_regles + sf.octets_ordre + h->octets);
+}
+
+/* Fichier de trace demandé par --trace (NULL si désactivé) */
+static const char *chemin_trace = NULL;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : exporter_trace
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit la trace des phases du moteur à la sortie du programme
+ *  (enregistrée avec atexit).
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void exporter_trace(void) {
+    if (trace_exporter(chemin_trace)) {
+        fprintf(stderr, "Trace écrite dans %s\n", chemin_trace);
+    }
+    trace_liberer();
+}
+
+/* Profil des prémisses demandé par --profil (NULL si désactivé) */
+static const char *chemin_profil = NULL;
+static ProfilPremisses profil;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : enregistrer_profil
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit le profil des prémisses enrichi par les inférences de
+ *  la session, à la sortie du programme (enregistrée avec atexit).
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void enregistrer_profil(void) {
+    profil_enregistrer(&profil, chemin_profil);
+    profil_detruire(&profil);
+}
+
 /*
  * ------------------------------------------------------------
  * Fonction : main
@@ -232,31 +811,251 @@ static void supprimer_premisse(BaseConnaissances *BC) {
  *  le moteur d’inférence selon les choix de l’utilisateur.
  *
  * Paramètres :
- *  - Aucun
+ *  - argc, argv : options de la ligne de commande
+ *      --kb <fichier> : charge les règles d’un fichier au démarrage
+ *      --flux         : mode flux (faits sur stdin, déductions sur stdout)
+ *      --lot <f>      : requêtes indépendantes (une par ligne) évaluées par lots
+ *      --faits <f>    : faits initiaux, un par ligne (mode interactif)
+ *      --cible <fait> : l’inférence s’arrête dès que ce fait est connu (répétable)
+ *      --delai-ms <n> : durée maximale d’une inférence
+ *      --entrees <f>  : seuls faits de base possibles (élagage des règles)
+ *      --shards <n>   : inférence (option 3) répartie sur n processus
+ *      --fermeture <f>: fermeture (option 3) conservée et réutilisée sur disque
+ *      --journal <f>  : journal des modifications (reprise au démarrage)
+ *      --profil <f>   : fréquences des prémisses (ordre des tests, enrichi par l’option 3)
+ *      --stats        : affiche les statistiques après le chargement et quitte
+ *      --trace <json> : trace des phases au format Chrome (chrome://tracing)
  *
  * Valeur de retour :
  *  - 0 à la fin normale du programme
  *
  * Variables principales :
  *  - BC : base de connaissances (règles)
- *  - BF : base de faits
- *  - ht : table de hachage utilisée pour optimiser l’inférence
+ *  - BF : base de faits (ordre d’insertion + index haché)
  */
-int main(void) {
+int main(int argc, char **argv) {
     BaseConnaissances BC;
     bc_init(&BC);
 
+    // Options de la ligne de commande
+    bool flux = false;
+    bool stats = false;
+    const char *chemin_kb = NULL;
+    const char *chemin_faits = NULL;
+    size_t shards = 0;
+    const char *chemin_journal = NULL;
+    const char *chemin_fermeture = NULL;
+    const char *chemin_entrees = NULL;
+    const char *chemin_lot = NULL;
+
+    // Conditions d’arrêt de l’inférence (option 3 du menu)
+    OptionsInference options;
+    options_inference_init(&options);
+    const char **cibles = (const char **)malloc((size_t)argc * sizeof(char *));
+    if (!cibles) {
+        perror("malloc");
+        return 1;
+    }
+    options.cibles = cibles;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--kb") == 0 && i + 1 < argc) {
+            chemin_kb = argv[++i];
+        } else if (strcmp(argv[i], "--flux") == 0) {
+            flux = true;
+        } else if (strcmp(argv[i], "--lot") == 0 && i + 1 < argc) {
+            chemin_lot = argv[++i];
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats = true;
+        } else if (strcmp(argv[i], "--faits") == 0 && i + 1 < argc) {
+            chemin_faits = argv[++i];
+        } else if (strcmp(argv[i], "--cible") == 0 && i + 1 < argc) {
+            cibles[options.nb_cibles++] = argv[++i];
+        } else if (strcmp(argv[i], "--delai-ms") == 0 && i + 1 < argc) {
+            options.delai_us = strtoull(argv[++i], NULL, 10) * 1000u;
+        } else if (strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            shards = strtoul(argv[++i], NULL, 10);
+            if (shards == 0 || shards > SHARDS_MAX) {
+                fprintf(stderr, "--shards : nombre de processus entre 1 et %d.\n", SHARDS_MAX);
+                free(cibles);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--entrees") == 0 && i + 1 < argc) {
+            chemin_entrees = argv[++i];
+        } else if (strcmp(argv[i], "--fermeture") == 0 && i + 1 < argc) {
+            chemin_fermeture = argv[++i];
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            chemin_journal = argv[++i];
+        } else if (strcmp(argv[i], "--profil") == 0 && i + 1 < argc) {
+            chemin_profil = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            chemin_trace = argv[++i];
+        } else {
+            fprintf(stderr, "Usage : %s [--kb <fichier>] [--faits <fichier>] [--cible <fait>]... "
+                    "[--delai-ms <n>] [--entrees <fichier>] [--shards <n>] [--fermeture <fichier>] [--journal <fichier>] [--profil <fichier>] [--flux] [--lot <fichier>] [--stats] [--trace <json>]\n", argv[0]);
+            free(cibles);
+            return 1;
+        }
+    }
+    if (flux && (chemin_faits || chemin_journal || stats)) {
+        fprintf(stderr, "--faits, --journal et --stats sont réservés au mode interactif (en mode flux, les faits sont lus sur stdin).\n");
+        free(cibles);
+        return 1;
+    }
+
+    if (chemin_lot && (flux || chemin_faits || chemin_journal || stats || shards || chemin_fermeture)) {
+        fprintf(stderr, "--lot ne se combine pas avec --flux, --faits, --journal, --stats, --shards ni --fermeture.\n");
+        free(cibles);
+        return 1;
+    }
+
+    if (shards && (flux || options.nb_cibles || options.delai_us)) {
+        fprintf(stderr, "--shards ne se combine pas avec --flux, --cible ni --delai-ms.\n");
+        free(cibles);
+        return 1;
+    }
+
+    if (chemin_fermeture && (shards || flux || options.nb_cibles || options.delai_us)) {
+        fprintf(stderr, "--fermeture ne se combine pas avec --shards, --flux, --cible ni --delai-ms.\n");
+        free(cibles);
+        return 1;
+    }
+
+    // Le traceur est activé avant le chargement pour en mesurer la durée
+    if (chemin_trace) {
+        trace_activer();
+        atexit(exporter_trace);
+    }
+
+    // Profil lu avant la BC pour ordonner ses prémisses dès le chargement
+    if (chemin_profil) {
+        profil_init(&profil);
+        if (!profil_charger(&profil, chemin_profil)) {
+            profil_detruire(&profil);
+            free(cibles);
+            return 1;
+        }
+        options.profil = &profil;
+        atexit(enregistrer_profil);
+    }
+
     BaseFaits BF;
-    liste_init(&BF);
+    bf_init(&BF);
+    bf_activer_provenance(&BF);
+
+    // Reprise de l’état journalisé ; --kb et --faits n’importent que dans un journal neuf
+    Journal journal;
+    Journal *J = NULL;
+    if (chemin_journal) {
+        BilanReprise reprise;
+        if (!journal_ouvrir(&journal, chemin_journal, &BC, &BF, &reprise)) {
+            bf_detruire(&BF);
+            bc_vider(&BC);
+            free(cibles);
+            return 1;
+        }
+        J = &journal;
+        printf("Journal %s : %zu règle(s), %zu fait(s), %zu modification(s) rejouée(s)%s%s.\n", chemin_journal,
+               BC.size, bf_taille(&BF), reprise.rejoues, reprise.instantane ? " après l'instantané" : "",
+               reprise.tronque ? " (fin invalide ignorée)" : "");
+        if (journal.numero > 0 && (chemin_kb || chemin_faits)) {
+            printf("Journal existant : --kb et --faits sont ignorés.\n");
+            chemin_kb = chemin_faits = NULL;
+        }
+    }
+
+    if (chemin_kb && !bc_charger_fichier(&BC, chemin_kb)) {
+        if (J) journal_fermer(J);
+        bf_detruire(&BF);
+        bc_vider(&BC);
+        free(cibles);
+        return 1;
+    }
+    for (RegleId id = J && chemin_kb ? bc_premiere(&BC) : REGLE_ID_INVALIDE; id != REGLE_ID_INVALIDE;
+         id = bc_suivante(&BC, id)) {
+        journal_regle_ajoutee(J, bc_regle(&BC, id));
+    }
+    if (chemin_profil && profil_taille(&profil)) {
+        fprintf(flux || chemin_lot ? stderr : stdout, "Profil %s : prémisses réordonnées dans %zu règle(s).\n", chemin_profil,
+                profil_ordonner_bc(&BC, &profil));
+    }
+
+    // Faits de base possibles du déploiement : les règles inatteignables sont écartées
+    BaseFaits possibles;
+    bf_init(&possibles);
+    const char **base = NULL;
+    if (chemin_entrees) {
+        size_t nb_possibles = 0;
+        if (!bf_charger_fichier(&possibles, chemin_entrees, &nb_possibles)) {
+            if (J) journal_fermer(J);
+            bf_detruire(&possibles);
+            bf_detruire(&BF);
+            bc_vider(&BC);
+            free(cibles);
+            return 1;
+        }
+        base = (const char **)malloc((nb_possibles ? nb_possibles : 1) * sizeof(char *));
+        for (size_t i = 0; base && i < bf_nb_emplacements(&possibles); i++) {
+            const char *f = bf_emplacement(&possibles, i);
+            if (f) base[options.nb_base_possible++] = f;
+        }
+        options.base_possible = base;
+    }
+
+    if (chemin_lot) {
+        int code = mode_lot(&BC, chemin_lot);
+        free(base);
+        bf_detruire(&possibles);
+        bf_detruire(&BF);
+        bc_vider(&BC);
+        free(cibles);
+        return code;
+    }
+
+    if (flux) {
+        int code = mode_flux(&BC, base, options.nb_base_possible);
+        free(base);
+        bf_detruire(&possibles);
+        bf_detruire(&BF);
+        bc_vider(&BC);
+        free(cibles);
+        return code;
+    }
+
+    size_t ajoutes = 0;
+    if (chemin_faits && !bf_charger_fichier(&BF, chemin_faits, &ajoutes)) {
+        if (J) journal_fermer(J);
+        free(base);
+        bf_detruire(&possibles);
+        bf_detruire(&BF);
+        bc_vider(&BC);
+        free(cibles);
+        return 1;
+    }
+    if (chemin_faits) {
+        journaliser_faits(J, &BF, 0);
+        printf("%zu faits chargés depuis %s.\n", ajoutes, chemin_faits);
+    }
 
-    // Initialisation de la table de hachage pour les faits
-    HashTable ht;
-    hash_table_init(&ht);
+    // Relevé des structures chargées, sans menu
+    if (stats) {
+        afficher_stats(stdout, &BC, &BF);
+        if (J) journal_fermer(J);
+        free(base);
+        bf_detruire(&possibles);
+        bf_detruire(&BF);
+        bc_vider(&BC);
+        free(cibles);
+        return 0;
+    }
 
     // Boucle principale du menu interactif
     for (;;) {
+        // Validation groupée des modifications de l’action précédente
+        journal_point_controle(J, &BC, &BF);
         menu_afficher();
         int choix;
+        size_t avant = bf_nb_emplacements(&BF);
 
         if (!lire_entier("> ", &choix)) {
             printf("Entrée invalide.\n");
@@ -264,8 +1063,8 @@ int main(void) {
         }
 
         switch (choix) {
-            case 1: ajouter_regle(&BC); break;
-            case 2: ajouter_fait(&BF); break;
+            case 1: ajouter_regle(&BC, J); break;
+            case 2: ajouter_fait(&BF, J); break;
 
             case 3:
                 if (bc_est_vide(&BC)) {
@@ -273,8 +1072,26 @@ int main(void) {
                     pause_console();
                     break;
                 }
-                moteur_inference(&BC, &BF, &ht);
-                printf("Inférence terminée.\n");
+                if (shards) {
+                    BilanShards bilan;
+                    if (shards_executer(&BC, &BF, shards, &bilan)) {
+                        printf("%zu processus, %zu proposition(s) frontière, %zu fait(s) échangé(s) en %zu lot(s).\n",
+                               bilan.nb_shards, bilan.frontiere, bilan.messages, bilan.lots);
+                        printf("%zu fait(s) déduit(s).\n", bilan.deduits);
+                    }
+                } else if (chemin_fermeture) {
+                    static const char *const origines[] = {"calculée", "réutilisée", "reprise"};
+                    BilanFermeture bilan;
+                    fermeture_inferer(&BC, &BF, chemin_fermeture, &bilan);
+                    printf("Fermeture %s (%s) : %zu fait(s), %zu fait(s) déduit(s).\n", origines[bilan.origine],
+                           chemin_fermeture, bilan.faits, bilan.deduits);
+                } else {
+                    ResultatInference r = moteur_inference_opts(&BC, &BF, &options);
+                    if (r.elaguees) printf("%zu règle(s) élaguée(s).\n", r.elaguees);
+                    if (r.cible) printf("Cible atteinte : %s\n", r.cible);
+                    printf("%zu tour(s), %zu fait(s) déduit(s).\n", r.tours, r.deduits);
+                }
+                journaliser_faits(J, &BF, avant);
                 pause_console();
                 break;
 
@@ -287,34 +1104,76 @@ int main(void) {
 
             case 5:
                 printf("=== Faits ===\n");
-                if (liste_est_vide(&BF)) printf("(aucun fait)\n");
-                else liste_afficher(&BF, "- ");
+                if (bf_est_vide(&BF)) printf("(aucun fait)\n");
+                else bf_afficher(&BF, "- ");
                 pause_console();
                 break;
 
-            case 6: supprimer_regle(&BC); break;
-            case 7: supprimer_fait(&BF); break;
+            case 6: supprimer_regle(&BC, J); break;
+            case 7: supprimer_fait(&BF, J); break;
 
             case 8:
                 bc_vider(&BC);
+                journal_regles_videes(J);
                 printf("Toutes les règles supprimées.\n");
                 break;
 
             case 9:
-                liste_vider(&BF);
-                hash_table_clear(&ht);
-                hash_table_init(&ht);
+                bf_vider(&BF);
+                journal_faits_vides(J);
                 printf("Tous les faits supprimés.\n");
                 break;
 
-            case 10: supprimer_premisse(&BC); break;
+            case 10: supprimer_premisse(&BC, J); break;
             case 11:
                 phase_tests();
                 break;
+
+            case 12:
+                if (bc_est_vide(&BC)) {
+                    printf("BC vide.\n");
+                    pause_console();
+                    break;
+                }
+                inference_datalog(&BC, &BF);
+                journaliser_faits(J, &BF, avant);
+                break;
+
+            case 13:
+                expliquer_fait(&BC, &BF);
+                pause_console();
+                break;
+
+            case 14:
+                if (!chemin_profil) {
+                    printf("Aucun profil (utiliser --profil <fichier>).\n");
+                    break;
+                }
+                printf("%zu proposition(s) profilée(s), prémisses réordonnées dans %zu règle(s).\n",
+                       profil_taille(&profil), profil_ordonner_bc(&BC, &profil));
+                break;
+
+            case 15:
+                afficher_stats(stdout, &BC, &BF);
+                pause_console();
+                break;
+
+            case 16:
+                explorer_hypotheses(&BC, &BF);
+                break;
+
+            case 17:
+                diagnostic_abductif(&BC, &BF);
+                pause_console();
+                break;
+
             case 0:
+                if (J) journal_fermer(J);
+                free(base);
+                bf_detruire(&possibles);
                 bc_vider(&BC);
-                liste_vider(&BF);
-                hash_table_clear(&ht);
+                bf_detruire(&BF);
+                free(cibles);
                 printf("Bye.\n");
                 return 0;
 
@@ -0,0 +1,394 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "profil.h"
+#include "list.h"
+#include "rule.h"
+#include "trace.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise un profil vide (allocateur système).
+ *
+ * Paramètres :
+ *  - P : profil à initialiser
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void profil_init(ProfilPremisses *P) {
+    symboles_init(&P->noms);
+    P->tests = P->vrais = P->vue = NULL;
+    P->cap = 0;
+    P->requetes = 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_commencer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ouvre une nouvelle requête : chaque proposition n’y sera
+ *  comptée qu’une fois, quel que soit le nombre de règles qui
+ *  l’ont en prémisse.
+ *
+ * Paramètres :
+ *  - P : profil
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void profil_commencer(ProfilPremisses *P) {
+    P->requetes++;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : indice
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne l’identifiant d’une proposition du profil, en
+ *  l’ajoutant (compteurs nuls) si elle est nouvelle.
+ *
+ * Paramètres :
+ *  - P    : profil
+ *  - prop : nom de la proposition
+ *
+ * Valeur de retour :
+ *  - identifiant de la proposition dans P->noms
+ */
+static PropId indice(ProfilPremisses *P, const char *prop) {
+    const Allocateur *A = P->noms.alloc;
+    PropId id = symboles_interner(&P->noms, prop);
+
+    if (id >= P->cap) {
+        size_t cap = P->cap ? P->cap * 2 : 64;
+        while (cap <= id) cap *= 2;
+        P->tests = (uint64_t *)mem_reallouer(A, P->tests, cap * sizeof(uint64_t));
+        P->vrais = (uint64_t *)mem_reallouer(A, P->vrais, cap * sizeof(uint64_t));
+        P->vue = (uint64_t *)mem_reallouer(A, P->vue, cap * sizeof(uint64_t));
+        memset(P->tests + P->cap, 0, (cap - P->cap) * sizeof(uint64_t));
+        memset(P->vrais + P->cap, 0, (cap - P->cap) * sizeof(uint64_t));
+        memset(P->vue + P->cap, 0, (cap - P->cap) * sizeof(uint64_t));
+        P->cap = cap;
+    }
+    return id;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_noter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Enregistre la valeur d’une prémisse pour la requête en cours
+ *  (profil_commencer). Une proposition déjà notée dans la même
+ *  requête est ignorée.
+ *
+ * Paramètres :
+ *  - P    : profil
+ *  - prop : proposition observée
+ *  - vrai : sa valeur à la fin de la requête
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void profil_noter(ProfilPremisses *P, const char *prop, bool vrai) {
+    PropId id = indice(P, prop);
+    if (P->vue[id] == P->requetes) return;
+
+    P->vue[id] = P->requetes;
+    P->tests[id]++;
+    if (vrai) P->vrais[id]++;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_frequence
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Estime la probabilité qu’une proposition soit vraie, lissée
+ *  (règle de Laplace) pour que les propositions peu observées
+ *  restent proches de 1/2.
+ *
+ * Paramètres :
+ *  - P    : profil
+ *  - prop : proposition
+ *
+ * Valeur de retour :
+ *  - (vrais + 1) / (tests + 2) ; 0,5 si elle n’a jamais été observée
+ */
+double profil_frequence(const ProfilPremisses *P, const char *prop) {
+    PropId id = symboles_chercher(&P->noms, prop);
+    if (id == PROP_AUCUNE) return 0.5;
+    return ((double)P->vrais[id] + 1.0) / ((double)P->tests[id] + 2.0);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_taille
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne le nombre de propositions connues du profil.
+ *
+ * Paramètres :
+ *  - P : profil
+ *
+ * Valeur de retour :
+ *  - nombre de propositions
+ */
+size_t profil_taille(const ProfilPremisses *P) {
+    return symboles_taille(&P->noms);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_enregistrer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit le profil au format texte (voir profil.h).
+ *
+ * Paramètres :
+ *  - P      : profil
+ *  - chemin : fichier de destination (remplacé)
+ *
+ * Valeur de retour :
+ *  - true  : fichier écrit
+ *  - false : erreur d’ouverture ou d’écriture
+ */
+bool profil_enregistrer(const ProfilPremisses *P, const char *chemin) {
+    FILE *f = fopen(chemin, "w");
+    if (!f) {
+        perror(chemin);
+        return false;
+    }
+
+    fprintf(f, "# Profil des prémisses : <requêtes> <vraie> <proposition>\n");
+    for (PropId id = 0; id < profil_taille(P); id++) {
+        fprintf(f, "%llu %llu %s\n", (unsigned long long)P->tests[id], (unsigned long long)P->vrais[id],
+                symboles_nom(&P->noms, id));
+    }
+
+    bool ok = !ferror(f);
+    if (fclose(f) != 0) ok = false;
+    if (!ok) perror(chemin);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_charger
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute au profil les compteurs d’un fichier. Un fichier absent
+ *  donne un profil inchangé (premier enregistrement à venir).
+ *
+ * Paramètres :
+ *  - P      : profil
+ *  - chemin : fichier à lire
+ *
+ * Valeur de retour :
+ *  - true  : fichier lu (ou absent)
+ *  - false : fichier illisible ou ligne mal formée
+ *
+ * Variables locales :
+ *  - buf    : ligne courante, lue en entier (cap : taille du tampon)
+ *  - numero : numéro de la ligne courante (pour les messages)
+ */
+bool profil_charger(ProfilPremisses *P, const char *chemin) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) {
+        if (errno == ENOENT) return true;
+        perror(chemin);
+        return false;
+    }
+
+    char *buf = NULL;
+    size_t cap = 0;
+    size_t numero = 0;
+    bool ok = true;
+    while (getline(&buf, &cap, f) != -1) {
+        numero++;
+        buf[strcspn(buf, "\r\n")] = '\0';
+        if (buf[0] == '\0' || buf[0] == '#') continue;
+
+        char *suite, *fin;
+        unsigned long long tests = strtoull(buf, &suite, 10);
+        unsigned long long vrais = strtoull(suite, &fin, 10);
+        bool lu = suite != buf && fin != suite;
+        while (*fin == ' ' || *fin == '\t') fin++;
+        if (!lu || *fin == '\0' || vrais > tests) {
+            fprintf(stderr, "%s : ligne %zu invalide (attendu : <requêtes> <vraie> <proposition>).\n", chemin,
+                    numero);
+            ok = false;
+            break;
+        }
+
+        PropId id = indice(P, fin);
+        P->tests[id] += tests;
+        P->vrais[id] += vrais;
+    }
+    free(buf);
+    fclose(f);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trier_rangs
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Tri par insertion stable des rangs 0..n-1 selon des clés
+ *  croissantes (les listes de prémisses sont courtes).
+ *
+ * Paramètres :
+ *  - cle  : clé de chaque rang
+ *  - rang : permutation produite (n éléments)
+ *  - n    : nombre d’éléments
+ *
+ * Valeur de retour :
+ *  - true si l’ordre a changé
+ */
+static bool trier_rangs(const double *cle, uint32_t *rang, size_t n) {
+    bool change = false;
+    for (size_t i = 0; i < n; i++) rang[i] = (uint32_t)i;
+    for (size_t i = 1; i < n; i++) {
+        uint32_t r = rang[i];
+        size_t j = i;
+        while (j > 0 && cle[rang[j - 1]] > cle[r]) {
+            rang[j] = rang[j - 1];
+            j--;
+        }
+        if (j != i) change = true;
+        rang[j] = r;
+    }
+    return change;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_ordonner_bc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Réordonne les prémisses de chaque règle par fréquence
+ *  croissante (ordre d’origine conservé à fréquence égale). La
+ *  sémantique des règles est inchangée ; toutes_premisses_vraies,
+ *  l’affichage et une compilation ultérieure suivent le nouvel
+ *  ordre.
+ *
+ * Paramètres :
+ *  - BC : base de connaissances à modifier
+ *  - P  : profil
+ *
+ * Valeur de retour :
+ *  - nombre de règles dont l’ordre a changé
+ *
+ * Variables locales :
+ *  - cle  : fréquence de chaque prémisse de la règle courante
+ *  - rang : ordre trié des prémisses
+ */
+size_t profil_ordonner_bc(BaseConnaissances *BC, const ProfilPremisses *P) {
+    size_t max = 0, modifiees = 0;
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        size_t n = bc_regle(BC, id)->premisses.size;
+        if (n > max) max = n;
+    }
+
+    TRACE_DEBUT("ordonner_premisses");
+    double *cle = (double *)mem_allouer(BC->alloc, (max ? max : 1) * sizeof(double));
+    uint32_t *rang = (uint32_t *)mem_allouer(BC->alloc, (max ? max : 1) * sizeof(uint32_t));
+
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        Liste *L = &bc_regle(BC, id)->premisses;
+
+        for (size_t i = 0; i < L->size; i++) cle[i] = profil_frequence(P, liste_element(L, i));
+        if (!trier_rangs(cle, rang, L->size)) continue;
+
+        liste_permuter(L, rang);
+        modifiees++;
+    }
+
+    mem_liberer(BC->alloc, rang);
+    mem_liberer(BC->alloc, cle);
+    TRACE_FIN("ordonner_premisses");
+    return modifiees;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_ordonner_bcc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Comme profil_ordonner_bc, sur une BC déjà compilée (recompilation
+ *  guidée par le profil). Seul l’ordre à l’intérieur de chaque
+ *  règle change : l’index proposition -> règles reste valide.
+ *
+ * Paramètres :
+ *  - C : BC compilée à modifier
+ *  - P : profil
+ *
+ * Valeur de retour :
+ *  - nombre de règles dont l’ordre a changé
+ *
+ * Variables locales :
+ *  - freq : fréquence de chaque proposition de C
+ */
+size_t profil_ordonner_bcc(BCCompilee *C, const ProfilPremisses *P) {
+    const Allocateur *A = C->symboles.alloc;
+    size_t np = bcc_nb_propositions(C), max = 0, modifiees = 0;
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        if (C->regles[r].nb > max) max = C->regles[r].nb;
+    }
+
+    double *freq = (double *)mem_allouer(A, np * sizeof(double));
+    for (PropId p = 0; p < np; p++) freq[p] = profil_frequence(P, symboles_nom(&C->symboles, p));
+    double *cle = (double *)mem_allouer(A, max * sizeof(double));
+    uint32_t *rang = (uint32_t *)mem_allouer(A, max * sizeof(uint32_t));
+    PropId *copie = (PropId *)mem_allouer(A, max * sizeof(PropId));
+
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        PropId *prem = C->premisses + C->regles[r].debut;
+        uint32_t n = C->regles[r].nb;
+
+        for (uint32_t i = 0; i < n; i++) cle[i] = freq[prem[i]];
+        if (!trier_rangs(cle, rang, n)) continue;
+
+        memcpy(copie, prem, n * sizeof(PropId));
+        for (uint32_t i = 0; i < n; i++) prem[i] = copie[rang[i]];
+        modifiees++;
+    }
+
+    mem_liberer(A, copie);
+    mem_liberer(A, rang);
+    mem_liberer(A, cle);
+    mem_liberer(A, freq);
+    return modifiees;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : profil_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère la mémoire du profil.
+ *
+ * Paramètres :
+ *  - P : profil à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void profil_detruire(ProfilPremisses *P) {
+    const Allocateur *A = P->noms.alloc;
+    mem_liberer(A, P->tests);
+    mem_liberer(A, P->vrais);
+    mem_liberer(A, P->vue);
+    symboles_detruire(&P->noms);
+    P->tests = P->vrais = P->vue = NULL;
+    P->cap = 0;
+}
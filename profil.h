@@ -0,0 +1,50 @@
+#ifndef PROFIL_H
+#define PROFIL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+#include "kb.h"
+#include "symbols.h"
+
+/*
+ * Profil de sélectivité des prémisses. Pour chaque proposition
+ * utilisée en prémisse, le profil compte les requêtes qui l’ont
+ * observée et celles où elle était vraie (état final de chaque
+ * inférence). Les prémisses d’une règle peuvent ensuite être
+ * réordonnées par fréquence croissante : la plus sélective est
+ * testée en premier, si bien qu’une règle qui échoue échoue le plus
+ * souvent dès le premier test (et qu’une SessionVeille surveille
+ * d’emblée la prémisse la plus rarement vraie).
+ *
+ * Format texte persistant : une proposition par ligne,
+ * "<requêtes> <vraie> <nom>", '#' pour les commentaires. Le
+ * chargement cumule les compteurs avec ceux déjà présents.
+ */
+
+typedef struct {
+    TableSymboles noms;
+    uint64_t *tests;      // par proposition : requêtes qui l’ont observée
+    uint64_t *vrais;      // par proposition : requêtes où elle était vraie
+    uint64_t *vue;        // par proposition : dernière requête qui l’a notée
+    size_t cap;
+    uint64_t requetes;    // requêtes commencées depuis l’initialisation
+} ProfilPremisses;
+
+void profil_init(ProfilPremisses *P);
+void profil_commencer(ProfilPremisses *P);
+void profil_noter(ProfilPremisses *P, const char *prop, bool vrai);
+double profil_frequence(const ProfilPremisses *P, const char *prop);
+size_t profil_taille(const ProfilPremisses *P);
+
+bool profil_enregistrer(const ProfilPremisses *P, const char *chemin);
+bool profil_charger(ProfilPremisses *P, const char *chemin);
+
+/* Réordonnancement des prémisses (retournent le nombre de règles modifiées) */
+size_t profil_ordonner_bc(BaseConnaissances *BC, const ProfilPremisses *P);
+size_t profil_ordonner_bcc(BCCompilee *C, const ProfilPremisses *P);
+
+void profil_detruire(ProfilPremisses *P);
+
+#endif
@@ -5,72 +5,39 @@
 
 /*
  * ------------------------------------------------------------
- * Fonction : xmalloc
- * ------------------------------------------------------------
- * Rôle :
- *  Alloue dynamiquement un bloc mémoire de taille donnée.
- *  En cas d’échec de l’allocation, le programme est arrêté
- *  avec un message d’erreur explicite.
- *
- * Paramètres :
- *  - n : taille (en octets) de la mémoire à allouer
- *
- * Valeur de retour :
- *  - pointeur vers la zone mémoire allouée
- *
- * Variables locales :
- *  - p : pointeur vers la mémoire allouée
- */
-static void *xmalloc(size_t n) {
-    void *p = malloc(n);
-    if (!p) {
-        perror("malloc");
-        exit(EXIT_FAILURE);
-    }
-    return p;
-}
-
-/*
- * ------------------------------------------------------------
- * Fonction : xstrdup
+ * Fonction : regle_init
  * ------------------------------------------------------------
  * Rôle :
- *  Duplique une chaîne de caractères en allouant
- *  dynamiquement la mémoire nécessaire.
+ *  Initialise une règle vide en préparant la liste
+ *  de prémisses et en mettant la conclusion à NULL.
  *
  * Paramètres :
- *  - s : chaîne de caractères à dupliquer
+ *  - R : pointeur vers la règle à initialiser
  *
  * Valeur de retour :
- *  - pointeur vers la nouvelle chaîne copiée
- *
- * Variables locales :
- *  - n : taille de la chaîne (caractère nul inclus)
- *  - p : pointeur vers la chaîne allouée
+ *  - Aucune (void)
  */
-static char *xstrdup(const char *s) {
-    size_t n = strlen(s) + 1;
-    char *p = (char *)xmalloc(n);
-    memcpy(p, s, n);
-    return p;
+void regle_init(Regle *R) {
+    regle_init_avec(R, NULL);
 }
 
 /*
  * ------------------------------------------------------------
- * Fonction : regle_init
+ * Fonction : regle_init_avec
  * ------------------------------------------------------------
  * Rôle :
- *  Initialise une règle vide en préparant la liste
- *  de prémisses et en mettant la conclusion à NULL.
+ *  Initialise une règle vide dont les prémisses et la conclusion
+ *  seront allouées par l’allocateur donné.
  *
  * Paramètres :
  *  - R : pointeur vers la règle à initialiser
+ *  - A : allocateur (NULL : allocateur système)
  *
  * Valeur de retour :
  *  - Aucune (void)
  */
-void regle_init(Regle *R) {
-    liste_init(&R->premisses);
+void regle_init_avec(Regle *R, const Allocateur *A) {
+    liste_init_avec(&R->premisses, A);
     R->conclusion = NULL;
 }
 
@@ -147,10 +114,10 @@ bool regle_premisses_vide(const Regle *R) {
  */
 void regle_definir_conclusion(Regle *R, const char *c) {
     // Libération de l’ancienne conclusion si elle existe
-    free(R->conclusion);
+    mem_liberer(R->premisses.alloc, R->conclusion);
 
     // Duplication et affectation de la nouvelle conclusion
-    R->conclusion = xstrdup(c);
+    R->conclusion = mem_dupliquer(R->premisses.alloc, c);
 }
 
 /*
@@ -190,7 +157,7 @@ void regle_detruire(Regle *R) {
     liste_vider(&R->premisses);
 
     // Libération de la conclusion
-    free(R->conclusion);
+    mem_liberer(R->premisses.alloc, R->conclusion);
     R->conclusion = NULL;
 }
 
@@ -209,17 +176,35 @@ void regle_detruire(Regle *R) {
  *  - Aucune (void)
  *
  * Variables locales :
- *  - p : pointeur pour parcourir les prémisses
+ *  - i : position de la prémisse affichée
  */
 void regle_afficher(const Regle *R) {
     printf("IF ");
 
     // Affichage de toutes les prémisses
-    for (ListNode *p = R->premisses.head; p; p = p->next) {
-        printf("%s", p->s);
-        if (p->next) printf(" AND ");
+    for (size_t i = 0; i < R->premisses.size; i++) {
+        printf("%s", liste_element(&R->premisses, i));
+        if (i + 1 < R->premisses.size) printf(" AND ");
     }
 
     // Affichage de la conclusion
     printf(" THEN %s\n", R->conclusion ? R->conclusion : "(aucune)");
 }
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : regle_octets
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule la mémoire allouée par une règle (liste des prémisses
+ *  et copie de la conclusion), hors structure Regle.
+ *
+ * Paramètres :
+ *  - R : pointeur constant vers la règle
+ *
+ * Valeur de retour :
+ *  - nombre d’octets
+ */
+size_t regle_octets(const Regle *R) {
+    return liste_octets(&R->premisses) + (R->conclusion ? strlen(R->conclusion) + 1 : 0);
+}
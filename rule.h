@@ -10,6 +10,7 @@ typedef struct {
 } Regle;
 
 void regle_init(Regle *R);
+void regle_init_avec(Regle *R, const Allocateur *A);
 void regle_ajouter_premisse(Regle *R, const char *p);
 bool regle_supprimer_premisse(Regle *R, const char *p);
 bool regle_premisses_vide(const Regle *R);
@@ -19,5 +20,6 @@ const char *regle_obtenir_conclusion(const Regle *R);
 
 void regle_detruire(Regle *R);
 void regle_afficher(const Regle *R);
+size_t regle_octets(const Regle *R);
 
 #endif
@@ -0,0 +1,852 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "shard.h"
+#include "trace.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+ * Messages échangés sur la socket de chaque ouvrier : un octet de
+ * type, la longueur de la charge (uint32_t) puis la charge.
+ *  - 'R' (coordinateur -> ouvrier) : règle "p1\0p2\0...\0c\0"
+ *  - 'F' (coordinateur -> ouvrier) : nom d’un fait
+ *  - 'D' (ouvrier -> coordinateur) : rang (uint32_t) de la règle
+ *    dans le shard, puis nom du fait qu’elle a déduit
+ *  - 'L' : fin de lot (vers l’ouvrier), lot traité (vers le coordinateur)
+ * La fermeture de la socket par le coordinateur arrête l’ouvrier.
+ */
+#define MSG_REGLE 'R'
+#define MSG_FAIT 'F'
+#define MSG_DEDUIT 'D'
+#define MSG_LOT 'L'
+#define ENTETE (1 + sizeof(uint32_t))
+
+/* Tampon d’octets (messages à envoyer ou reçus incomplets) */
+typedef struct {
+    char *octets;
+    size_t nb;
+    size_t cap;
+    size_t envoyes;   // octets déjà transmis (tampons de sortie)
+} Tampon;
+
+/* État du coordinateur */
+typedef struct {
+    const BCCompilee *C;
+    const Allocateur *alloc;
+    size_t n;
+    int *sockets;
+    pid_t *pids;
+    uint64_t *consommateurs;   // par proposition : shards l’ayant en prémisse
+    uint8_t *vrai;             // par proposition : fait connu du coordinateur
+    PropId *deduits;           // faits déduits, dans l’ordre d’arrivée
+    uint32_t *regles;          // parallèle à deduits : règle (de C) qui l’a déduit
+    size_t nb_deduits;
+    uint32_t *par_shard;       // règles de C regroupées par shard, dans l’ordre envoyé
+    size_t *debut;             // par shard : début dans par_shard (n + 1 entrées)
+    Tampon *sorties;
+    Tampon *entrees;
+    size_t *en_cours;          // par shard : lots envoyés non acquittés
+    bool *ouverts;             // par shard : lot en cours de remplissage
+    BilanShards *bilan;
+} Coordination;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tampon_ecrire_message
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un message (type, longueur, charge) à un tampon.
+ *
+ * Paramètres :
+ *  - A       : allocateur
+ *  - T       : tampon
+ *  - type    : type du message
+ *  - donnees : charge (peut être NULL si n vaut 0)
+ *  - n       : taille de la charge
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void tampon_ecrire_message(const Allocateur *A, Tampon *T, char type, const void *donnees, size_t n) {
+    if (T->nb + ENTETE + n > T->cap) {
+        size_t cap = T->cap ? T->cap : 4096;
+        while (cap < T->nb + ENTETE + n) cap *= 2;
+        T->octets = (char *)mem_reallouer(A, T->octets, cap);
+        T->cap = cap;
+    }
+
+    uint32_t longueur = (uint32_t)n;
+    T->octets[T->nb] = type;
+    memcpy(T->octets + T->nb + 1, &longueur, sizeof(longueur));
+    if (n) memcpy(T->octets + T->nb + ENTETE, donnees, n);
+    T->nb += ENTETE + n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : racine
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Représentant d’une proposition dans l’union-find (avec
+ *  compression de chemin par division).
+ *
+ * Paramètres :
+ *  - parent : forêt union-find
+ *  - p      : proposition
+ *
+ * Valeur de retour :
+ *  - représentant de la composante
+ */
+static uint32_t racine(uint32_t *parent, uint32_t p) {
+    while (parent[p] != p) {
+        parent[p] = parent[parent[p]];
+        p = parent[p];
+    }
+    return p;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : calculer_masques
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule, pour chaque proposition, les shards qui l’utilisent
+ *  en prémisse et ceux qui la produisent.
+ *
+ * Paramètres :
+ *  - C             : BC compilée
+ *  - shard         : shard de chaque règle
+ *  - consommateurs : reçoit les masques des prémisses (par proposition)
+ *  - producteurs   : reçoit les masques des conclusions (par proposition)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void calculer_masques(const BCCompilee *C, const uint32_t *shard,
+                             uint64_t *consommateurs, uint64_t *producteurs) {
+    memset(consommateurs, 0, bcc_nb_propositions(C) * sizeof(uint64_t));
+    memset(producteurs, 0, bcc_nb_propositions(C) * sizeof(uint64_t));
+
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        const RegleCompilee *R = &C->regles[r];
+        uint64_t bit = UINT64_C(1) << shard[r];
+        for (uint32_t k = R->debut; k < R->debut + R->nb; k++) consommateurs[C->premisses[k]] |= bit;
+        producteurs[R->conclusion] |= bit;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : comparer_composantes
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ordre de qsort : composantes par taille décroissante puis par
+ *  représentant (résultat déterministe).
+ *
+ * Paramètres :
+ *  - a, b : paires (taille, représentant)
+ *
+ * Valeur de retour :
+ *  - entier négatif, nul ou positif
+ */
+static int comparer_composantes(const void *a, const void *b) {
+    const uint32_t *x = (const uint32_t *)a, *y = (const uint32_t *)b;
+    if (x[0] != y[0]) return x[0] > y[0] ? -1 : 1;
+    return (x[1] > y[1]) - (x[1] < y[1]);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : moins_charge
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Shard ayant reçu le moins de règles (le premier en cas
+ *  d’égalité).
+ *
+ * Paramètres :
+ *  - charge : règles placées par shard
+ *  - n      : nombre de shards
+ *
+ * Valeur de retour :
+ *  - indice du shard
+ */
+static size_t moins_charge(const size_t *charge, size_t n) {
+    size_t t = 0;
+    for (size_t s = 1; s < n; s++) {
+        if (charge[s] < charge[t]) t = s;
+    }
+    return t;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : shards_partitionner
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Répartit les règles en n shards d’au plus ceil(R / n) règles.
+ *  Les règles reliées par une proposition (composante connexe du
+ *  graphe de dépendances) restent ensemble autant que possible :
+ *  les composantes sont placées de la plus grande à la plus
+ *  petite sur le shard le moins chargé, et une composante trop
+ *  grande est coupée dans l’ordre topologique, de sorte que les
+ *  faits traversent les frontières dans un seul sens hors cycles.
+ *
+ * Paramètres :
+ *  - C     : BC compilée
+ *  - n     : nombre de shards (1 .. SHARDS_MAX)
+ *  - shard : reçoit le shard de chaque règle (C->nb_regles entrées)
+ *
+ * Valeur de retour :
+ *  - nombre de propositions produites par un shard et utilisées
+ *    par un autre (à échanger pendant l’inférence)
+ *
+ * Variables locales :
+ *  - parent     : union-find sur les propositions
+ *  - ordre      : règles dans l’ordre des dépendances
+ *  - composantes: paires (taille, représentant)
+ *  - rang       : par représentant, rang de sa composante
+ *  - charge     : règles déjà placées par shard
+ */
+size_t shards_partitionner(const BCCompilee *C, size_t n, uint32_t *shard) {
+    const Allocateur *A = C->symboles.alloc;
+    size_t np = bcc_nb_propositions(C);
+    size_t nr = C->nb_regles;
+
+    // Composantes connexes : une règle relie ses prémisses et sa conclusion
+    uint32_t *parent = (uint32_t *)mem_allouer(A, (np + 1) * sizeof(uint32_t));
+    for (size_t p = 0; p < np; p++) parent[p] = (uint32_t)p;
+    for (size_t r = 0; r < nr; r++) {
+        const RegleCompilee *R = &C->regles[r];
+        for (uint32_t k = R->debut; k < R->debut + R->nb; k++) {
+            uint32_t a = racine(parent, C->premisses[k]), b = racine(parent, R->conclusion);
+            if (a != b) parent[a] = b;
+        }
+    }
+
+    // Taille de chaque composante, puis rang par taille décroissante
+    uint32_t *taille = (uint32_t *)mem_allouer_zero(A, (np + 1) * sizeof(uint32_t));
+    size_t nb_composantes = 0;
+    for (size_t r = 0; r < nr; r++) {
+        if (taille[racine(parent, C->regles[r].conclusion)]++ == 0) nb_composantes++;
+    }
+
+    uint32_t *composantes = (uint32_t *)mem_allouer(A, (2 * nb_composantes + 1) * sizeof(uint32_t));
+    size_t k = 0;
+    for (size_t p = 0; p < np; p++) {
+        if (parent[p] == p && taille[p] > 0) {
+            composantes[2 * k] = taille[p];
+            composantes[2 * k + 1] = (uint32_t)p;
+            k++;
+        }
+    }
+    qsort(composantes, nb_composantes, 2 * sizeof(uint32_t), comparer_composantes);
+
+    uint32_t *rang = taille;   // réutilisé : représentant -> rang
+    for (size_t c = 0; c < nb_composantes; c++) rang[composantes[2 * c + 1]] = (uint32_t)c;
+
+    // Tri stable (par dénombrement) de l’ordre topologique par composante
+    uint32_t *ordre = (uint32_t *)mem_allouer(A, (nr + 1) * sizeof(uint32_t));
+    uint32_t *groupe = (uint32_t *)mem_allouer(A, (nr + 1) * sizeof(uint32_t));
+    size_t *debut = (size_t *)mem_allouer_zero(A, (nb_composantes + 1) * sizeof(size_t));
+    bcc_ordre_dependances(C, ordre);
+
+    for (size_t c = 0; c < nb_composantes; c++) debut[c + 1] = debut[c] + composantes[2 * c];
+    for (size_t i = 0; i < nr; i++) {
+        uint32_t c = rang[racine(parent, C->regles[ordre[i]].conclusion)];
+        groupe[debut[c]++] = ordre[i];
+    }
+
+    // Placement : chaque composante démarre sur le shard le moins chargé
+    size_t capacite = (nr + n - 1) / n;
+    size_t charge[SHARDS_MAX] = {0};
+    size_t t = 0;
+    uint32_t courante = UINT32_MAX;
+    for (size_t i = 0; i < nr; i++) {
+        uint32_t c = rang[racine(parent, C->regles[groupe[i]].conclusion)];
+        if (c != courante || charge[t] == capacite) {
+            t = moins_charge(charge, n);
+            courante = c;
+        }
+        shard[groupe[i]] = (uint32_t)t;
+        charge[t]++;
+    }
+
+    // Propositions à échanger
+    uint64_t *consommateurs = (uint64_t *)mem_allouer(A, (np + 1) * sizeof(uint64_t));
+    uint64_t *producteurs = (uint64_t *)mem_allouer(A, (np + 1) * sizeof(uint64_t));
+    calculer_masques(C, shard, consommateurs, producteurs);
+    size_t frontiere = 0;
+    for (size_t p = 0; p < np; p++) {
+        uint64_t tous = consommateurs[p] | producteurs[p];
+        if (consommateurs[p] && producteurs[p] && (tous & (tous - 1))) frontiere++;
+    }
+
+    mem_liberer(A, consommateurs);
+    mem_liberer(A, producteurs);
+    mem_liberer(A, parent);
+    mem_liberer(A, taille);
+    mem_liberer(A, composantes);
+    mem_liberer(A, ordre);
+    mem_liberer(A, groupe);
+    mem_liberer(A, debut);
+    return frontiere;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lire_message
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit un message complet côté ouvrier (lecture bloquante). La
+ *  charge est terminée par un '\0' supplémentaire.
+ *
+ * Paramètres :
+ *  - f       : socket du coordinateur
+ *  - type    : reçoit le type
+ *  - charge  : tampon de la charge (agrandi au besoin)
+ *  - cap     : capacité du tampon
+ *  - n       : reçoit la taille de la charge
+ *
+ * Valeur de retour :
+ *  - true  : message lu
+ *  - false : fin du flux (arrêt demandé) ou message tronqué
+ */
+static bool lire_message(FILE *f, char *type, char **charge, size_t *cap, size_t *n) {
+    char entete[ENTETE];
+    if (fread(entete, 1, ENTETE, f) != ENTETE) return false;
+
+    uint32_t longueur;
+    *type = entete[0];
+    memcpy(&longueur, entete + 1, sizeof(longueur));
+    if (longueur + 1 > *cap) {
+        *cap = longueur + 1;
+        *charge = (char *)mem_reallouer(&allocateur_systeme, *charge, *cap);
+    }
+    if (fread(*charge, 1, longueur, f) != longueur) return false;
+    (*charge)[longueur] = '\0';
+    *n = longueur;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : envoyer_fait
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit un message 'D' côté ouvrier (tamponné jusqu’à la fin du
+ *  lot).
+ *
+ * Paramètres :
+ *  - f     : socket du coordinateur
+ *  - regle : rang dans le shard de la règle qui a déduit le fait
+ *  - nom   : fait à envoyer
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void envoyer_fait(FILE *f, uint32_t regle, const char *nom) {
+    char entete[ENTETE];
+    uint32_t longueur = (uint32_t)(sizeof(regle) + strlen(nom));
+    entete[0] = MSG_DEDUIT;
+    memcpy(entete + 1, &longueur, sizeof(longueur));
+    fwrite(entete, 1, ENTETE, f);
+    fwrite(&regle, sizeof(regle), 1, f);
+    fwrite(nom, 1, longueur - sizeof(regle), f);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : executer_ouvrier
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Boucle d’un processus ouvrier : reçoit ses règles, les compile
+ *  dans sa propre BC, puis traite des lots de faits. À chaque fin
+ *  de lot, il sature sa session, renvoie les faits qu’il a déduits
+ *  (avec la règle qui les a déduits) puis acquitte le lot. Les pages héritées du coordinateur par
+ *  fork ne sont pas utilisées (elles restent partagées).
+ *
+ * Paramètres :
+ *  - fd : socket vers le coordinateur
+ *
+ * Valeur de retour :
+ *  - code de sortie du processus
+ *
+ * Variables locales :
+ *  - BC, C, S  : règles du shard, compilées, et leur session
+ *  - initiaux  : conclusions des règles sans prémisse (envoyées au premier lot)
+ *  - entrees   : fin des faits reçus dans l’agenda pour le lot courant
+ */
+static int executer_ouvrier(int fd) {
+    FILE *in = fdopen(fd, "r");
+    FILE *out = fdopen(dup(fd), "w");
+    if (!in || !out) return 1;
+
+    BaseConnaissances BC;
+    BCCompilee C;
+    Session S;
+    bc_init(&BC);
+    bool compilee = false;
+    size_t initiaux = 0, entrees = 0;
+
+    char type;
+    char *charge = NULL;
+    size_t cap = 0, n;
+    int code = 0;
+
+    while (lire_message(in, &type, &charge, &cap, &n)) {
+        if (type == MSG_REGLE) {
+            // "p1\0p2\0...\0c\0" : la dernière chaîne est la conclusion
+            Regle R;
+            regle_init(&R);
+            const char *c = charge;
+            for (const char *s = charge; s < charge + n; s += strlen(s) + 1) {
+                if (s != c) regle_ajouter_premisse(&R, c);
+                c = s;
+            }
+            regle_definir_conclusion(&R, c);
+            bc_ajouter_regle_en_queue(&BC, &R);
+            regle_detruire(&R);
+            continue;
+        }
+
+        if (!compilee) {
+            bcc_compiler(&C, &BC);
+            session_init(&S, &C);
+            session_activer_provenance(&S);
+            initiaux = entrees = S.nb_faits;
+            compilee = true;
+        }
+
+        if (type == MSG_FAIT) {
+            PropId p = symboles_chercher(&C.symboles, charge);
+            if (p != PROP_AUCUNE) session_affirmer(&S, p);
+            entrees = S.nb_faits;
+        } else if (type == MSG_LOT) {
+            session_saturer(&S);
+            for (size_t i = 0; i < initiaux; i++) envoyer_fait(out, S.regle[i], symboles_nom(&C.symboles, S.faits[i]));
+            for (size_t i = entrees; i < S.nb_faits; i++) envoyer_fait(out, S.regle[i], symboles_nom(&C.symboles, S.faits[i]));
+            initiaux = 0;
+            entrees = S.nb_faits;
+
+            char fin[ENTETE] = {MSG_LOT, 0, 0, 0, 0};
+            fwrite(fin, 1, ENTETE, out);
+            if (fflush(out) != 0) {
+                code = 1;
+                break;
+            }
+        } else {
+            code = 1;
+            break;
+        }
+    }
+
+    if (compilee) {
+        session_detruire(&S);
+        bcc_detruire(&C);
+    }
+    bc_vider(&BC);
+    mem_liberer(&allocateur_systeme, charge);
+    fclose(in);
+    fclose(out);
+    return code;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : router
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Enregistre un fait au coordinateur et le transmet, dans leur
+ *  lot en cours, aux shards qui l’utilisent en prémisse (sauf au
+ *  shard qui l’a produit).
+ *
+ * Paramètres :
+ *  - K      : coordination
+ *  - p      : fait
+ *  - source : shard d’origine (SIZE_MAX pour un fait initial)
+ *
+ * Valeur de retour :
+ *  - true si le fait était nouveau pour le coordinateur
+ */
+static bool router(Coordination *K, PropId p, size_t source) {
+    if (K->vrai[p]) return false;
+    K->vrai[p] = 1;
+
+    uint64_t cibles = K->consommateurs[p];
+    if (source != SIZE_MAX) cibles &= ~(UINT64_C(1) << source);
+
+    const char *nom = symboles_nom(&K->C->symboles, p);
+    size_t n = strlen(nom);
+    for (size_t w = 0; w < K->n; w++) {
+        if (!(cibles & (UINT64_C(1) << w))) continue;
+        tampon_ecrire_message(K->alloc, &K->sorties[w], MSG_FAIT, nom, n);
+        K->ouverts[w] = true;
+        K->bilan->messages++;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : fermer_lots
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Termine les lots en cours de remplissage (message 'L').
+ *
+ * Paramètres :
+ *  - K : coordination
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void fermer_lots(Coordination *K) {
+    for (size_t w = 0; w < K->n; w++) {
+        if (!K->ouverts[w]) continue;
+        tampon_ecrire_message(K->alloc, &K->sorties[w], MSG_LOT, NULL, 0);
+        K->ouverts[w] = false;
+        K->en_cours[w]++;
+        K->bilan->lots++;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : recevoir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit ce qui est disponible sur la socket d’un ouvrier et traite
+ *  les messages complets : faits déduits (routés, leur règle est
+ *  ramenée à sa place dans C) et acquittements de lots.
+ *
+ * Paramètres :
+ *  - K : coordination
+ *  - w : shard
+ *
+ * Valeur de retour :
+ *  - true  : lecture effectuée
+ *  - false : ouvrier terminé ou message invalide
+ */
+static bool recevoir(Coordination *K, size_t w) {
+    Tampon *T = &K->entrees[w];
+    if (T->cap - T->nb < 4096) {
+        T->cap = T->cap ? 2 * T->cap : 8192;
+        T->octets = (char *)mem_reallouer(K->alloc, T->octets, T->cap);
+    }
+
+    ssize_t lus = recv(K->sockets[w], T->octets + T->nb, T->cap - T->nb - 1, MSG_DONTWAIT);
+    if (lus < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    if (lus == 0) return false;
+    T->nb += (size_t)lus;
+
+    size_t pos = 0;
+    while (T->nb - pos >= ENTETE) {
+        uint32_t longueur;
+        memcpy(&longueur, T->octets + pos + 1, sizeof(longueur));
+        if (T->nb - pos < ENTETE + longueur) break;
+
+        char type = T->octets[pos];
+        char *charge = T->octets + pos + ENTETE;
+        if (type == MSG_LOT) {
+            if (K->en_cours[w] == 0) return false;
+            K->en_cours[w]--;
+        } else if (type == MSG_DEDUIT && longueur >= sizeof(uint32_t)) {
+            uint32_t regle;
+            memcpy(&regle, charge, sizeof(regle));
+            if (regle != SESSION_SANS_REGLE) {
+                if (regle >= K->debut[w + 1] - K->debut[w]) return false;
+                regle = K->par_shard[K->debut[w] + regle];
+            }
+            // Terminaison temporaire du nom (l’octet suivant est relu après)
+            char suivant = charge[longueur];
+            charge[longueur] = '\0';
+            PropId p = symboles_chercher(&K->C->symboles, charge + sizeof(regle));
+            charge[longueur] = suivant;
+            if (p == PROP_AUCUNE) return false;
+            if (router(K, p, w)) {
+                K->regles[K->nb_deduits] = regle;
+                K->deduits[K->nb_deduits++] = p;
+            }
+        } else {
+            return false;
+        }
+        pos += ENTETE + longueur;
+    }
+
+    memmove(T->octets, T->octets + pos, T->nb - pos);
+    T->nb -= pos;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : envoyer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit sans bloquer la suite du tampon de sortie d’un ouvrier.
+ *
+ * Paramètres :
+ *  - K : coordination
+ *  - w : shard
+ *
+ * Valeur de retour :
+ *  - true  : écriture effectuée (éventuellement partielle)
+ *  - false : socket fermée par l’ouvrier
+ */
+static bool envoyer(Coordination *K, size_t w) {
+    Tampon *T = &K->sorties[w];
+    ssize_t ecrits = send(K->sockets[w], T->octets + T->envoyes, T->nb - T->envoyes,
+                          MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (ecrits < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+    T->envoyes += (size_t)ecrits;
+    if (T->envoyes == T->nb) T->nb = T->envoyes = 0;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : coordonner
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Boucle du coordinateur : écrit les tampons de sortie, lit les
+ *  réponses et ferme les lots formés par le routage, jusqu’à ce
+ *  qu’aucun lot ne soit en cours (tous les shards sont au repos
+ *  et toutes les files sont vides).
+ *
+ * Paramètres :
+ *  - K : coordination
+ *
+ * Valeur de retour :
+ *  - true  : point fixe global atteint
+ *  - false : un ouvrier s’est arrêté ou a envoyé un message invalide
+ *
+ * Variables locales :
+ *  - attente : descripteurs surveillés par poll
+ */
+static bool coordonner(Coordination *K) {
+    struct pollfd attente[SHARDS_MAX];
+
+    for (;;) {
+        bool actif = false;
+        for (size_t w = 0; w < K->n; w++) {
+            if (K->en_cours[w] > 0) actif = true;
+            attente[w].fd = K->sockets[w];
+            attente[w].events = POLLIN | (K->sorties[w].nb > K->sorties[w].envoyes ? POLLOUT : 0);
+            attente[w].revents = 0;
+        }
+        if (!actif) return true;
+
+        if (poll(attente, (nfds_t)K->n, -1) < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        for (size_t w = 0; w < K->n; w++) {
+            if ((attente[w].revents & POLLOUT) && !envoyer(K, w)) return false;
+            if ((attente[w].revents & (POLLIN | POLLHUP | POLLERR)) && !recevoir(K, w)) return false;
+        }
+        fermer_lots(K);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : shards_executer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule la fermeture de BF par la BC avec n processus ouvriers
+ *  (fork) reliés au coordinateur par des sockets locales. Chaque
+ *  ouvrier reçoit les règles de son shard et les faits initiaux
+ *  utiles à ses prémisses ; les faits déduits sont ajoutés à BF
+ *  dans leur ordre d’arrivée au coordinateur, avec la règle qui
+ *  les a déduits.
+ *
+ * Paramètres :
+ *  - BC    : base de connaissances
+ *  - BF    : base de faits enrichie
+ *  - n     : nombre de processus (1 .. SHARDS_MAX)
+ *  - bilan : reçoit la répartition et les compteurs (peut être NULL)
+ *
+ * Valeur de retour :
+ *  - true  : inférence terminée
+ *  - false : processus impossible à créer ou arrêté (message sur
+ *            stderr, BF n’est pas modifiée)
+ *
+ * Variables locales :
+ *  - C     : BC compilée (partitionnement et routage)
+ *  - shard : shard de chaque règle
+ *  - K     : état du coordinateur
+ */
+bool shards_executer(const BaseConnaissances *BC, BaseFaits *BF, size_t n, BilanShards *bilan) {
+    if (n == 0 || n > SHARDS_MAX) {
+        fprintf(stderr, "Nombre de shards invalide (1 à %d).\n", SHARDS_MAX);
+        return false;
+    }
+
+    TRACE_DEBUT("shards");
+    BilanShards local;
+    if (!bilan) bilan = &local;
+    memset(bilan, 0, sizeof(*bilan));
+    bilan->nb_shards = n;
+
+    BCCompilee C;
+    bcc_compiler(&C, BC);
+    const Allocateur *A = C.symboles.alloc;
+    size_t np = bcc_nb_propositions(&C);
+
+    uint32_t *shard = (uint32_t *)mem_allouer(A, (C.nb_regles + 1) * sizeof(uint32_t));
+    bilan->frontiere = shards_partitionner(&C, n, shard);
+
+    Coordination K;
+    memset(&K, 0, sizeof(K));
+    K.C = &C;
+    K.alloc = A;
+    K.n = n;
+    K.bilan = bilan;
+    K.sockets = (int *)mem_allouer(A, n * sizeof(int));
+    K.pids = (pid_t *)mem_allouer(A, n * sizeof(pid_t));
+    K.consommateurs = (uint64_t *)mem_allouer(A, (np + 1) * sizeof(uint64_t));
+    K.vrai = (uint8_t *)mem_allouer_zero(A, np + 1);
+    K.deduits = (PropId *)mem_allouer(A, (np + 1) * sizeof(PropId));
+    K.regles = (uint32_t *)mem_allouer(A, (np + 1) * sizeof(uint32_t));
+    K.par_shard = (uint32_t *)mem_allouer(A, (C.nb_regles + 1) * sizeof(uint32_t));
+    K.debut = (size_t *)mem_allouer_zero(A, (n + 1) * sizeof(size_t));
+    K.sorties = (Tampon *)mem_allouer_zero(A, n * sizeof(Tampon));
+    K.entrees = (Tampon *)mem_allouer_zero(A, n * sizeof(Tampon));
+    K.en_cours = (size_t *)mem_allouer_zero(A, n * sizeof(size_t));
+    K.ouverts = (bool *)mem_allouer_zero(A, n * sizeof(bool));
+
+    uint64_t *producteurs = (uint64_t *)mem_allouer(A, (np + 1) * sizeof(uint64_t));
+    calculer_masques(&C, shard, K.consommateurs, producteurs);
+    for (size_t p = 0; p < np; p++) {
+        for (size_t w = 0; w < n; w++) {
+            if ((K.consommateurs[p] | producteurs[p]) & (UINT64_C(1) << w)) bilan->propositions[w]++;
+        }
+    }
+    mem_liberer(A, producteurs);
+
+    // Règles de chaque shard : "p1\0...\0c\0"
+    char *regle = NULL;
+    size_t cap = 0;
+    for (size_t r = 0; r < C.nb_regles; r++) {
+        const RegleCompilee *R = &C.regles[r];
+        size_t taille = strlen(symboles_nom(&C.symboles, R->conclusion)) + 1;
+        for (uint32_t k = R->debut; k < R->debut + R->nb; k++) taille += strlen(symboles_nom(&C.symboles, C.premisses[k])) + 1;
+        if (taille > cap) {
+            cap = 2 * taille;
+            regle = (char *)mem_reallouer(A, regle, cap);
+        }
+
+        size_t pos = 0;
+        for (uint32_t k = R->debut; k <= R->debut + R->nb; k++) {
+            const char *nom = symboles_nom(&C.symboles, k < R->debut + R->nb ? C.premisses[k] : R->conclusion);
+            size_t l = strlen(nom) + 1;
+            memcpy(regle + pos, nom, l);
+            pos += l;
+        }
+        tampon_ecrire_message(A, &K.sorties[shard[r]], MSG_REGLE, regle, pos);
+        bilan->regles[shard[r]]++;
+    }
+    mem_liberer(A, regle);
+
+    // Rang de chaque règle dans son shard -> règle de C (tri par comptage, ordre d’envoi)
+    for (size_t w = 0; w < n; w++) K.debut[w + 1] = K.debut[w] + bilan->regles[w];
+    size_t *suivant = (size_t *)mem_allouer(A, (n + 1) * sizeof(size_t));
+    memcpy(suivant, K.debut, n * sizeof(size_t));
+    for (size_t r = 0; r < C.nb_regles; r++) K.par_shard[suivant[shard[r]]++] = (uint32_t)r;
+    mem_liberer(A, suivant);
+
+    // Faits initiaux, puis un premier lot pour chaque shard
+    for (size_t i = 0; i < bf_nb_emplacements(BF); i++) {
+        const char *fait = bf_emplacement(BF, i);
+        PropId p = fait ? symboles_chercher(&C.symboles, fait) : PROP_AUCUNE;
+        if (p != PROP_AUCUNE) router(&K, p, SIZE_MAX);
+    }
+    for (size_t w = 0; w < n; w++) K.ouverts[w] = true;
+    fermer_lots(&K);
+
+    // Création des ouvriers (les sockets des autres ouvriers sont fermées dans chaque fils)
+    fflush(stdout);
+    fflush(stderr);
+    size_t lances = 0;
+    bool ok = true;
+    for (; lances < n; lances++) {
+        int paire[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, paire) != 0) {
+            perror("socketpair");
+            ok = false;
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            close(paire[0]);
+            close(paire[1]);
+            ok = false;
+            break;
+        }
+        if (pid == 0) {
+            for (size_t w = 0; w < lances; w++) close(K.sockets[w]);
+            close(paire[0]);
+            _exit(executer_ouvrier(paire[1]));
+        }
+
+        close(paire[1]);
+        K.sockets[lances] = paire[0];
+        K.pids[lances] = pid;
+    }
+
+    if (ok && !coordonner(&K)) {
+        fprintf(stderr, "Inférence répartie : un processus ouvrier s’est arrêté.\n");
+        ok = false;
+    }
+
+    // Arrêt : fermeture des sockets (fin de flux pour les ouvriers)
+    for (size_t w = 0; w < lances; w++) {
+        if (!ok) kill(K.pids[w], SIGKILL);
+        close(K.sockets[w]);
+    }
+    for (size_t w = 0; w < lances; w++) {
+        int statut;
+        if (waitpid(K.pids[w], &statut, 0) < 0 || !WIFEXITED(statut) || WEXITSTATUS(statut) != 0) ok = false;
+    }
+
+    if (ok) {
+        bf_reserver(BF, K.nb_deduits);
+        for (size_t i = 0; i < K.nb_deduits; i++) {
+            uint32_t r = K.regles[i];
+            uint64_t origine = r == SESSION_SANS_REGLE ? BF_ORIGINE_INCONNUE : bc_version(BC, C.emplacements[r]);
+            if (bf_deduire(BF, symboles_nom(&C.symboles, K.deduits[i]), origine)) bilan->deduits++;
+        }
+    }
+
+    for (size_t w = 0; w < n; w++) {
+        mem_liberer(A, K.sorties[w].octets);
+        mem_liberer(A, K.entrees[w].octets);
+    }
+    mem_liberer(A, K.sorties);
+    mem_liberer(A, K.entrees);
+    mem_liberer(A, K.en_cours);
+    mem_liberer(A, K.ouverts);
+    mem_liberer(A, K.sockets);
+    mem_liberer(A, K.pids);
+    mem_liberer(A, K.consommateurs);
+    mem_liberer(A, K.vrai);
+    mem_liberer(A, K.deduits);
+    mem_liberer(A, K.regles);
+    mem_liberer(A, K.par_shard);
+    mem_liberer(A, K.debut);
+    mem_liberer(A, shard);
+    bcc_detruire(&C);
+    TRACE_FIN("shards");
+    return ok;
+}
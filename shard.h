@@ -0,0 +1,38 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+#include "facts.h"
+#include "kb.h"
+
+/*
+ * Inférence répartie sur plusieurs processus locaux.
+ * La BC compilée est découpée selon son graphe de dépendances
+ * (composantes connexes, coupées dans l’ordre topologique si elles
+ * dépassent la part d’un shard). Chaque processus ouvrier reçoit
+ * ses seules règles et ne reçoit que les faits utilisés par ses
+ * prémisses ; le coordinateur route les faits déduits d’un shard
+ * vers les shards qui en ont besoin. La terminaison est détectée
+ * quand aucun lot n’est en cours et que toutes les files sont vides.
+ */
+
+/* Nombre maximal de shards (un bit par shard dans les masques de routage) */
+#define SHARDS_MAX 64
+
+typedef struct {
+    size_t nb_shards;
+    size_t regles[SHARDS_MAX];        // règles par shard
+    size_t propositions[SHARDS_MAX];  // propositions connues par shard
+    size_t frontiere;                 // propositions produites par un shard et utilisées par un autre
+    size_t messages;                  // faits transmis aux shards
+    size_t lots;                      // lots traités par les shards
+    size_t deduits;                   // faits déduits ajoutés à la base de faits
+} BilanShards;
+
+size_t shards_partitionner(const BCCompilee *C, size_t n, uint32_t *shard);
+bool shards_executer(const BaseConnaissances *BC, BaseFaits *BF, size_t n, BilanShards *bilan);
+
+#endif
@@ -0,0 +1,356 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "stream.h"
+#include "trace.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/*
+ * File bornée à un producteur et un consommateur, sans verrou :
+ * le producteur est seul à écrire "queue", le consommateur seul
+ * à écrire "tete". Une file pleine bloque le producteur
+ * (contre-pression) au lieu de grossir.
+ */
+typedef struct {
+    PropId cases[FLUX_CAPACITE];
+    _Atomic size_t tete;    // prochaine case à lire
+    _Atomic size_t queue;   // prochaine case à écrire
+} FileSPSC;
+
+typedef struct {
+    const BCCompilee *bc;
+    FILE *entree;
+    FILE *sortie;
+    FileSPSC lus;           // lecteur -> moteur
+    FileSPSC deduits;       // moteur -> écrivain
+    BilanFlux bilan;
+} Pipeline;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : patienter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Attente active courte puis sommeil bref lorsque la file reste
+ *  vide ou pleine, afin de ne pas monopoliser un cœur quand le
+ *  flux est au repos.
+ *
+ * Paramètres :
+ *  - essais : nombre d’attentes consécutives (mis à jour)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void patienter(unsigned *essais) {
+    if (++*essais < 1000) {
+        sched_yield();
+    } else {
+        struct timespec ts = {0, 10000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : file_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une file vide.
+ *
+ * Paramètres :
+ *  - F : file à initialiser
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void file_init(FileSPSC *F) {
+    atomic_init(&F->tete, 0);
+    atomic_init(&F->queue, 0);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : file_pousser
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un identifiant dans la file, en attendant qu’une case
+ *  se libère si elle est pleine.
+ *
+ * Paramètres :
+ *  - F : file (côté producteur)
+ *  - p : identifiant à transmettre
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - q      : position d’écriture
+ *  - essais : compteur d’attente
+ */
+static void file_pousser(FileSPSC *F, PropId p) {
+    size_t q = atomic_load_explicit(&F->queue, memory_order_relaxed);
+    unsigned essais = 0;
+
+    while (q - atomic_load_explicit(&F->tete, memory_order_acquire) == FLUX_CAPACITE) {
+        patienter(&essais);
+    }
+
+    F->cases[q & (FLUX_CAPACITE - 1)] = p;
+    atomic_store_explicit(&F->queue, q + 1, memory_order_release);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : file_retirer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire l’identifiant le plus ancien de la file si elle n’est
+ *  pas vide.
+ *
+ * Paramètres :
+ *  - F   : file (côté consommateur)
+ *  - out : identifiant retiré
+ *
+ * Valeur de retour :
+ *  - true  : un identifiant a été retiré
+ *  - false : la file est vide
+ */
+static bool file_retirer(FileSPSC *F, PropId *out) {
+    size_t t = atomic_load_explicit(&F->tete, memory_order_relaxed);
+    if (t == atomic_load_explicit(&F->queue, memory_order_acquire)) return false;
+
+    *out = F->cases[t & (FLUX_CAPACITE - 1)];
+    atomic_store_explicit(&F->tete, t + 1, memory_order_release);
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : file_attendre
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire un identifiant de la file en attendant qu’il y en ait un.
+ *
+ * Paramètres :
+ *  - F : file (côté consommateur)
+ *
+ * Valeur de retour :
+ *  - identifiant retiré
+ */
+static PropId file_attendre(FileSPSC *F) {
+    PropId p;
+    unsigned essais = 0;
+    while (!file_retirer(F, &p)) patienter(&essais);
+    return p;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : thread_lecteur
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit les faits ligne par ligne sur le flux d’entrée, les
+ *  traduit en identifiants (lecture seule de la table des
+ *  symboles) et les transmet au moteur. PROP_AUCUNE signale la
+ *  fin du flux.
+ *
+ * Paramètres :
+ *  - arg : pipeline partagé
+ *
+ * Valeur de retour :
+ *  - NULL
+ *
+ * Variables locales :
+ *  - buf : tampon de lecture d’une ligne (agrandi par getline)
+ *  - cap : taille allouée de buf
+ *  - s   : fait sans les espaces de bord
+ */
+static void *thread_lecteur(void *arg) {
+    Pipeline *P = (Pipeline *)arg;
+    char *buf = NULL;
+    size_t cap = 0;
+    trace_nommer_thread("lecteur");
+
+    while (getline(&buf, &cap, P->entree) != -1) {
+        char *s = buf;
+        while (*s && isspace((unsigned char)*s)) s++;
+        size_t n = strlen(s);
+        while (n > 0 && isspace((unsigned char)s[n - 1])) s[--n] = '\0';
+        if (*s == '\0') continue;
+
+        P->bilan.lus++;
+        TRACE_DEBUT("recherche_symbole");
+        PropId p = symboles_chercher(&P->bc->symboles, s);
+        TRACE_FIN("recherche_symbole");
+        if (p == PROP_AUCUNE) {
+            // Aucune règle n’utilise ce fait : rien à déduire
+            P->bilan.inconnus++;
+            continue;
+        }
+        file_pousser(&P->lus, p);
+    }
+    free(buf);
+
+    file_pousser(&P->lus, PROP_AUCUNE);
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : thread_moteur
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Affirme chaque fait reçu dans une session incrémentale et
+ *  transmet à l’écrivain les faits déduits en conséquence.
+ *
+ * Paramètres :
+ *  - arg : pipeline partagé
+ *
+ * Valeur de retour :
+ *  - NULL
+ *
+ * Variables locales :
+ *  - S     : session de chaînage avant
+ *  - debut : position dans l’agenda des premiers faits déduits
+ */
+static void *thread_moteur(void *arg) {
+    Pipeline *P = (Pipeline *)arg;
+    Session S;
+    session_init(&S, P->bc);
+    trace_nommer_thread("moteur");
+
+    // Conclusions des règles sans prémisse
+    session_saturer(&S);
+    for (size_t i = 0; i < S.nb_faits; i++) file_pousser(&P->deduits, S.faits[i]);
+
+    for (;;) {
+        PropId p = file_attendre(&P->lus);
+        if (p == PROP_AUCUNE) break;
+
+        if (!session_affirmer(&S, p)) continue;
+        size_t debut = S.nb_faits;
+        TRACE_DEBUT("saturation");
+        session_saturer(&S);
+        TRACE_FIN("saturation");
+
+        for (size_t i = debut; i < S.nb_faits; i++) file_pousser(&P->deduits, S.faits[i]);
+    }
+
+    file_pousser(&P->deduits, PROP_AUCUNE);
+    session_detruire(&S);
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : thread_ecrivain
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit les faits déduits sur le flux de sortie. Le tampon de
+ *  sortie est vidé dès que la file est vide : les écritures sont
+ *  regroupées en rafale, sans retarder le dernier fait produit.
+ *
+ * Paramètres :
+ *  - arg : pipeline partagé
+ *
+ * Valeur de retour :
+ *  - NULL
+ *
+ * Variables locales :
+ *  - p      : identifiant reçu
+ *  - essais : compteur d’attente
+ */
+static void *thread_ecrivain(void *arg) {
+    Pipeline *P = (Pipeline *)arg;
+    unsigned essais = 0;
+    trace_nommer_thread("ecrivain");
+
+    for (;;) {
+        PropId p;
+        if (!file_retirer(&P->deduits, &p)) {
+            if (essais == 0) {
+                TRACE_DEBUT("vidage_sortie");
+                fflush(P->sortie);
+                TRACE_FIN("vidage_sortie");
+            }
+            patienter(&essais);
+            continue;
+        }
+        essais = 0;
+        if (p == PROP_AUCUNE) break;
+
+        fputs(symboles_nom(&P->bc->symboles, p), P->sortie);
+        fputc('\n', P->sortie);
+        P->bilan.deduits++;
+    }
+
+    fflush(P->sortie);
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : flux_executer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Mode flux : lit des faits (un par ligne) au fil de l’eau et
+ *  écrit les faits déduits dès qu’ils sont produits. Lecture,
+ *  inférence et écriture tournent sur trois threads reliés par
+ *  deux files bornées. S’arrête à la fin du flux d’entrée.
+ *
+ * Paramètres :
+ *  - C      : BC compilée (lue en parallèle, non modifiée)
+ *  - entree : flux de faits (stdin, fichier, tube…)
+ *  - sortie : flux des faits déduits
+ *  - bilan  : compteurs de fin d’exécution (peut être NULL)
+ *
+ * Valeur de retour :
+ *  - true  : flux traité jusqu’au bout
+ *  - false : impossible de créer les threads
+ *
+ * Variables locales :
+ *  - P             : état partagé du pipeline
+ *  - lecteur, ...  : threads du pipeline
+ */
+bool flux_executer(const BCCompilee *C, FILE *entree, FILE *sortie, BilanFlux *bilan) {
+    Pipeline *P = (Pipeline *)calloc(1, sizeof(Pipeline));
+    if (!P) return false;
+
+    P->bc = C;
+    P->entree = entree;
+    P->sortie = sortie;
+    file_init(&P->lus);
+    file_init(&P->deduits);
+
+    pthread_t lecteur, moteur, ecrivain;
+    if (pthread_create(&ecrivain, NULL, thread_ecrivain, P) != 0) {
+        free(P);
+        return false;
+    }
+    if (pthread_create(&moteur, NULL, thread_moteur, P) != 0) {
+        file_pousser(&P->deduits, PROP_AUCUNE);
+        pthread_join(ecrivain, NULL);
+        free(P);
+        return false;
+    }
+    if (pthread_create(&lecteur, NULL, thread_lecteur, P) != 0) {
+        file_pousser(&P->lus, PROP_AUCUNE);
+        pthread_join(moteur, NULL);
+        pthread_join(ecrivain, NULL);
+        free(P);
+        return false;
+    }
+
+    pthread_join(lecteur, NULL);
+    pthread_join(moteur, NULL);
+    pthread_join(ecrivain, NULL);
+
+    if (bilan) *bilan = P->bilan;
+    free(P);
+    return true;
+}
@@ -0,0 +1,20 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "compile.h"
+
+/* Capacité de chaque file entre threads (puissance de 2) */
+#define FLUX_CAPACITE 1024
+
+typedef struct {
+    size_t lus;        // lignes de faits lues
+    size_t inconnus;   // faits absents du vocabulaire de la BC (ignorés)
+    size_t deduits;    // faits déduits écrits en sortie
+} BilanFlux;
+
+bool flux_executer(const BCCompilee *C, FILE *entree, FILE *sortie, BilanFlux *bilan);
+
+#endif
@@ -0,0 +1,238 @@
+#include "symbols.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : hacher
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Calcule l’empreinte FNV-1a d’une chaîne de caractères.
+ *
+ * Paramètres :
+ *  - s : chaîne à hacher
+ *
+ * Valeur de retour :
+ *  - empreinte sur 32 bits
+ */
+static uint32_t hacher(const char *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)(*s++);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trouver_alveole
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Sonde linéairement la table à partir de l’empreinte du nom
+ *  jusqu’à trouver l’alvéole qui contient ce nom ou la première
+ *  alvéole libre.
+ *
+ * Paramètres :
+ *  - T   : table des symboles (au moins une alvéole libre)
+ *  - nom : nom recherché
+ *
+ * Valeur de retour :
+ *  - indice de l’alvéole trouvée
+ *
+ * Variables locales :
+ *  - masque : nb_alveoles - 1 (réduction modulo puissance de 2)
+ *  - i      : alvéole sondée
+ */
+static size_t trouver_alveole(const TableSymboles *T, const char *nom) {
+    size_t masque = T->nb_alveoles - 1;
+    size_t i = hacher(nom) & masque;
+
+    while (T->alveoles[i] != 0 &&
+           strcmp(T->noms[T->alveoles[i] - 1], nom) != 0) {
+        i = (i + 1) & masque;
+    }
+    return i;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : agrandir_alveoles
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Double le nombre d’alvéoles et y réinsère tous les
+ *  identifiants existants.
+ *
+ * Paramètres :
+ *  - T : table des symboles
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void agrandir_alveoles(TableSymboles *T) {
+    mem_liberer(T->alloc, T->alveoles);
+    T->nb_alveoles *= 2;
+    T->alveoles = (uint32_t *)mem_allouer_zero(T->alloc, T->nb_alveoles * sizeof(uint32_t));
+
+    for (size_t id = 0; id < T->nb; id++) {
+        T->alveoles[trouver_alveole(T, T->noms[id])] = (uint32_t)id + 1;
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une table des symboles vide.
+ *
+ * Paramètres :
+ *  - T : table à initialiser
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void symboles_init(TableSymboles *T) {
+    symboles_init_avec(T, NULL);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Initialise une table des symboles vide utilisant l’allocateur
+ *  donné pour les noms et les tableaux.
+ *
+ * Paramètres :
+ *  - T : table à initialiser
+ *  - A : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void symboles_init_avec(TableSymboles *T, const Allocateur *A) {
+    T->alloc = A ? A : &allocateur_systeme;
+    T->noms = NULL;
+    T->nb = 0;
+    T->cap = 0;
+    T->nb_alveoles = 16;
+    T->alveoles = (uint32_t *)mem_allouer_zero(T->alloc, T->nb_alveoles * sizeof(uint32_t));
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_interner
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne l’identifiant d’une proposition, en lui attribuant
+ *  le prochain identifiant libre si elle est nouvelle.
+ *
+ * Paramètres :
+ *  - T   : table des symboles
+ *  - nom : texte de la proposition
+ *
+ * Valeur de retour :
+ *  - identifiant de la proposition
+ *
+ * Variables locales :
+ *  - i : alvéole du nom dans la table
+ */
+PropId symboles_interner(TableSymboles *T, const char *nom) {
+    size_t i = trouver_alveole(T, nom);
+    if (T->alveoles[i] != 0) return T->alveoles[i] - 1;
+
+    // Nouveau symbole : copie du nom
+    if (T->nb == T->cap) {
+        T->cap = T->cap ? T->cap * 2 : 16;
+        T->noms = (char **)mem_reallouer(T->alloc, T->noms, T->cap * sizeof(char *));
+    }
+    T->noms[T->nb] = mem_dupliquer(T->alloc, nom);
+    T->alveoles[i] = (uint32_t)T->nb + 1;
+    T->nb++;
+
+    // Facteur de charge maximal : 1/2
+    if (2 * T->nb > T->nb_alveoles) agrandir_alveoles(T);
+
+    return (PropId)(T->nb - 1);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_chercher
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Recherche l’identifiant d’une proposition sans modifier la
+ *  table (utilisable en lecture depuis plusieurs threads).
+ *
+ * Paramètres :
+ *  - T   : table des symboles
+ *  - nom : texte de la proposition
+ *
+ * Valeur de retour :
+ *  - identifiant de la proposition
+ *  - PROP_AUCUNE si elle n’a jamais été internée
+ */
+PropId symboles_chercher(const TableSymboles *T, const char *nom) {
+    size_t i = trouver_alveole(T, nom);
+    return T->alveoles[i] ? T->alveoles[i] - 1 : PROP_AUCUNE;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_nom
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne le texte associé à un identifiant.
+ *
+ * Paramètres :
+ *  - T  : table des symboles
+ *  - id : identifiant de la proposition
+ *
+ * Valeur de retour :
+ *  - nom de la proposition
+ *  - NULL si l’identifiant est inconnu
+ */
+const char *symboles_nom(const TableSymboles *T, PropId id) {
+    return id < T->nb ? T->noms[id] : NULL;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_taille
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique le nombre de propositions internées.
+ *
+ * Paramètres :
+ *  - T : table des symboles
+ *
+ * Valeur de retour :
+ *  - nombre d’identifiants attribués
+ */
+size_t symboles_taille(const TableSymboles *T) {
+    return T->nb;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : symboles_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère tous les noms et les tableaux de la table.
+ *
+ * Paramètres :
+ *  - T : table à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void symboles_detruire(TableSymboles *T) {
+    for (size_t id = 0; id < T->nb; id++) mem_liberer(T->alloc, T->noms[id]);
+    mem_liberer(T->alloc, T->noms);
+    mem_liberer(T->alloc, T->alveoles);
+    T->noms = NULL;
+    T->alveoles = NULL;
+    T->nb = T->cap = T->nb_alveoles = 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "alloc.h"
+
+/* Identifiant entier d’une proposition internée (0, 1, 2, ...) */
+typedef uint32_t PropId;
+
+#define PROP_AUCUNE UINT32_MAX
+
+typedef struct {
+    char **noms;          // identifiant -> nom
+    size_t nb;
+    size_t cap;
+    uint32_t *alveoles;   // adressage ouvert : identifiant + 1, 0 si libre
+    size_t nb_alveoles;   // puissance de 2
+    const Allocateur *alloc;
+} TableSymboles;
+
+void symboles_init(TableSymboles *T);
+void symboles_init_avec(TableSymboles *T, const Allocateur *A);
+PropId symboles_interner(TableSymboles *T, const char *nom);
+PropId symboles_chercher(const TableSymboles *T, const char *nom);
+const char *symboles_nom(const TableSymboles *T, PropId id);
+size_t symboles_taille(const TableSymboles *T);
+void symboles_detruire(TableSymboles *T);
+
+#endif
@@ -4,10 +4,29 @@
 #include "hash.h"
 #include "kb.h"
 #include "inference.h"
+#include "compile.h"
+#include "stream.h"
+#include "codegen.h"
+#include "datalog.h"
+#include "shard.h"
+#include "ensemble.h"
+#include "journal.h"
+#include "fermeture.h"
+#include "veille.h"
+#include "profil.h"
+#include "abduction.h"
+#include "diagramme.h"
+#include "lot.h"
+#include "trace.h"
+#include "alloc.h"
 #include "utils.h"
+#include <setjmp.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+BC_GENEREE_DECLARER(voiture);
+
 /*
  * ------------------------------------------------------------
  * Variable globale : tests_echoues
@@ -93,9 +112,34 @@ void tests_liste(void) {
     test_result("suppression A", liste_supprimer_premiere(&L, "A"));
     test_result("suppression -> taille = 1", L.size == 1);
 
+    // Dépassement du stockage interne
+    char nom[8];
+    for (int i = 0; i < 10; i++) {
+        snprintf(nom, sizeof(nom), "E%d", i);
+        liste_ajouter_en_queue(&L, nom);
+    }
+    test_result("croissance -> taille = 11", L.size == 11);
+    test_result("croissance -> contient E9", liste_contient_rec(&L, "E9"));
+    test_result("suppression E0 -> ordre conserve", liste_supprimer_premiere(&L, "E0") &&
+                strcmp(liste_element(&L, 1), "E1") == 0 && strcmp(liste_tete(&L), "B") == 0);
+
+    // Permutation (ordre inversé) du tableau alloué, puis du stockage interne
+    uint32_t ordre[10];
+    for (uint32_t i = 0; i < 10; i++) ordre[i] = 9 - i;
+    liste_permuter(&L, ordre);
+    test_result("permuter -> ordre inverse", L.size == 10 && strcmp(liste_tete(&L), "E9") == 0 &&
+                strcmp(liste_element(&L, 9), "B") == 0);
+
     // Vidage complet de la liste
     liste_vider(&L);
     test_result("vider -> liste vide", liste_est_vide(&L));
+
+    liste_ajouter_en_queue(&L, "X");
+    liste_ajouter_en_queue(&L, "Y");
+    liste_permuter(&L, ordre + 8);
+    test_result("permuter -> stockage interne", strcmp(liste_tete(&L), "Y") == 0 &&
+                strcmp(liste_element(&L, 1), "X") == 0);
+    liste_vider(&L);
 }
 
 /*
@@ -147,6 +191,89 @@ void tests_regle(void) {
     regle_detruire(&R);
 }
 
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_bc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie la base de connaissances et ses identifiants stables :
+ *   - accès, suppression et édition par identifiant
+ *   - rejet des identifiants périmés
+ *   - réutilisation des emplacements et ordre de parcours
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Structures testées :
+ *  - BaseConnaissances
+ */
+void tests_bc(void) {
+    printf("\n--- Tests BC ---\n");
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+
+    // Trois règles : X1 => Y1, X2 => Y2, X3 AND Z => Y3
+    RegleId ids[3];
+    char p[8], c[8];
+    for (int i = 0; i < 3; i++) {
+        Regle R;
+        regle_init(&R);
+        snprintf(p, sizeof(p), "X%d", i + 1);
+        snprintf(c, sizeof(c), "Y%d", i + 1);
+        regle_ajouter_premisse(&R, p);
+        if (i == 2) regle_ajouter_premisse(&R, "Z");
+        regle_definir_conclusion(&R, c);
+        ids[i] = bc_ajouter_regle_en_queue(&BC, &R);
+        regle_detruire(&R);
+    }
+    test_result("ajout -> 3 regles", BC.size == 3);
+    test_result("acces par id", strcmp(regle_obtenir_conclusion(bc_regle(&BC, ids[1])), "Y2") == 0);
+
+    // Suppression : l’identifiant devient périmé
+    test_result("supprimer par id", bc_supprimer_regle(&BC, ids[1]));
+    test_result("id perime -> NULL", bc_regle(&BC, ids[1]) == NULL);
+    test_result("id perime -> suppression refusee", !bc_supprimer_regle(&BC, ids[1]));
+
+    // Réutilisation de l’emplacement avec une nouvelle génération
+    Regle R;
+    regle_init(&R);
+    regle_definir_conclusion(&R, "Y4");
+    RegleId id4 = bc_ajouter_regle_en_queue(&BC, &R);
+    regle_detruire(&R);
+    test_result("emplacement reutilise", (id4 & 0xffffffffu) == (ids[1] & 0xffffffffu) && id4 != ids[1]);
+    test_result("id perime toujours invalide", bc_regle(&BC, ids[1]) == NULL);
+
+    // Ordre de parcours : Y1, Y3, Y4
+    const char *attendu[] = {"Y1", "Y3", "Y4"};
+    bool ordre = true;
+    int k = 0;
+    for (RegleId id = bc_premiere(&BC); id != REGLE_ID_INVALIDE; id = bc_suivante(&BC, id), k++) {
+        if (k >= 3 || strcmp(regle_obtenir_conclusion(bc_regle(&BC, id)), attendu[k]) != 0) ordre = false;
+    }
+    test_result("ordre d'insertion conserve", ordre && k == 3);
+
+    // Statistiques : X1 => Y1, X3 AND Z => Y3, => Y4 (17 octets de chaînes)
+    StatsBC sc;
+    bc_stats(&BC, &sc);
+    test_result("stats BC", sc.nb_regles == 3 && sc.nb_premisses == 3 && sc.octets_regles == 17 &&
+                sc.octets_emplacements == sc.cap * sizeof(BCEmplacement));
+
+    // Édition de prémisse par identifiant
+    test_result("supprimer premisse par id", bc_supprimer_premisse(&BC, ids[2], "Z") &&
+                bc_regle(&BC, ids[2])->premisses.size == 1);
+
+    // Compatibilité : suppression par position
+    test_result("supprimer index 0", bc_supprimer_regle_index(&BC, 0) && bc_regle(&BC, ids[0]) == NULL);
+    test_result("index hors limites", !bc_supprimer_regle_index(&BC, 5));
+
+    bc_vider(&BC);
+    test_result("vider -> vide", bc_est_vide(&BC));
+}
+
 /*
  * ------------------------------------------------------------
  * Fonction : tests_hash
@@ -186,9 +313,207 @@ void tests_hash(void) {
     test_result("contient B", hash_table_contains(&ht, "B"));
     test_result("absent C", !hash_table_contains(&ht, "C"));
 
+    // Insertion sans doublon et suppression
+    hash_table_insert(&ht, "A");
+    test_result("insertion doublon ignoree", ht.nb_elements == 2);
+    test_result("supprimer A", hash_table_supprimer(&ht, "A") && !hash_table_contains(&ht, "A"));
+    test_result("supprimer A (absent)", !hash_table_supprimer(&ht, "A"));
+
+    // Agrandissement au-delà de la taille initiale
+    char nom[16];
+    for (int i = 0; i < 100; i++) {
+        snprintf(nom, sizeof(nom), "P%d", i);
+        hash_table_insert(&ht, nom);
+    }
+    test_result("agrandissement -> P99 present", hash_table_contains(&ht, "P99") &&
+                ht.nb_alveoles >= ht.nb_elements);
+
+    // Statistiques : B et P0..P99
+    StatsHash s;
+    hash_table_stats(&ht, &s);
+    size_t chaines = 0;
+    for (size_t i = 0; i < ht.nb_alveoles; i++) {
+        size_t l = 0;
+        for (HashNode *n = ht.table[i]; n; n = n->next) l++;
+        chaines += l * (l + 1) / 2;
+    }
+    test_result("stats -> occupation", s.nb_elements == 101 && s.alveoles_occupees <= 101 &&
+                s.chaine_max >= 1 && s.charge <= 1.0 && s.octets > 101 * sizeof(HashNode));
+    test_result("stats -> sondage moyen", s.sondes_presente >= 1.0 &&
+                s.sondes_presente * 101 > (double)chaines - 0.5 && s.sondes_presente * 101 < (double)chaines + 0.5);
+
     // Nettoyage de la table
     hash_table_clear(&ht);
     test_result("clear -> A absent", !hash_table_contains(&ht, "A"));
+    test_result("clear -> B absent", !hash_table_contains(&ht, "B") && !hash_table_contains(&ht, "P99"));
+    hash_table_stats(&ht, &s);
+    test_result("stats apres clear", s.nb_elements == 0 && s.alveoles_occupees == 0 && s.sondes_presente == 0.0);
+    hash_table_detruire(&ht);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_faits
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste la base de faits :
+ *   - ajout sans doublon et recherche hachée
+ *   - suppression en conservant l’ordre d’insertion
+ *   - compactage après de nombreuses suppressions
+ *   - union de deux bases
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Structures testées :
+ *  - BaseFaits
+ */
+void tests_faits(void) {
+    printf("\n--- Tests FAITS ---\n");
+
+    BaseFaits BF;
+    bf_init(&BF);
+    test_result("init -> vide", bf_est_vide(&BF));
+
+    test_result("ajouter A", bf_ajouter(&BF, "A"));
+    test_result("ajouter A (doublon)", !bf_ajouter(&BF, "A"));
+    bf_ajouter(&BF, "B");
+    bf_ajouter(&BF, "C");
+    test_result("contient B", bf_contient(&BF, "B"));
+
+    // Suppression : l’ordre des faits restants est conservé
+    test_result("supprimer B", bf_supprimer(&BF, "B") && !bf_contient(&BF, "B"));
+    test_result("supprimer B (absent)", !bf_supprimer(&BF, "B"));
+    const char *restants[2];
+    size_t n = 0;
+    for (size_t i = 0; i < bf_nb_emplacements(&BF); i++) {
+        if (bf_emplacement(&BF, i) && n < 2) restants[n++] = bf_emplacement(&BF, i);
+    }
+    test_result("ordre conserve (A, C)", n == 2 && strcmp(restants[0], "A") == 0 &&
+                strcmp(restants[1], "C") == 0);
+
+    // Nombreuses suppressions : compactage et index cohérent
+    char nom[16];
+    for (int i = 0; i < 200; i++) {
+        snprintf(nom, sizeof(nom), "F%d", i);
+        bf_ajouter(&BF, nom);
+    }
+    for (int i = 0; i < 190; i++) {
+        snprintf(nom, sizeof(nom), "F%d", i);
+        bf_supprimer(&BF, nom);
+    }
+    bool coherent = bf_taille(&BF) == 12 && bf_nb_emplacements(&BF) < 200;
+    for (size_t i = 0; i < bf_nb_emplacements(&BF); i++) {
+        const char *f = bf_emplacement(&BF, i);
+        if (f && hash_table_chercher(&BF.index, f)->valeur != i) coherent = false;
+    }
+    test_result("compactage -> index coherent", coherent);
+
+    // Union
+    BaseFaits autre;
+    bf_init(&autre);
+    bf_ajouter(&autre, "A");
+    bf_ajouter(&autre, "Z");
+    test_result("union -> 1 ajout", bf_union(&BF, &autre) == 1 && bf_contient(&BF, "Z"));
+
+    bf_vider(&BF);
+    test_result("vider -> vide", bf_est_vide(&BF) && !bf_contient(&BF, "A"));
+
+    // Ajout en lot : doublons dans le lot et avec la base
+    bf_ajouter(&BF, "B");
+    static const char *const lot[] = {"A", "B", "C", "A", "D"};
+    size_t alveoles = BF.index.nb_alveoles;
+    test_result("lot -> 3 ajouts", bf_affirmer_lot(&BF, lot, 5) == 3 && bf_taille(&BF) == 4);
+    test_result("lot -> ordre B A C D", strcmp(bf_emplacement(&BF, 0), "B") == 0 &&
+                strcmp(bf_emplacement(&BF, 1), "A") == 0 && strcmp(bf_emplacement(&BF, 3), "D") == 0);
+    hash_table_reserver(&BF.index, 1000);
+    test_result("reserver -> alveoles", BF.index.nb_alveoles >= 1000 && alveoles < 1000 &&
+                bf_contient(&BF, "C") && bf_contient(&BF, "D"));
+
+    // Chargement d’un fichier de faits
+    FILE *f = tmpfile();
+    fputs("  E  \n# commentaire\n\nA\nF", f);
+    rewind(f);
+    size_t ajoutes = 0;
+    test_result("charger -> E et F", bf_charger_flux(&BF, f, &ajoutes) && ajoutes == 2 &&
+                bf_contient(&BF, "E") && bf_contient(&BF, "F") && bf_taille(&BF) == 6);
+    fclose(f);
+
+    // Provenance : suit les faits à travers le compactage
+    bf_activer_provenance(&BF);
+    test_result("provenance -> deduire", bf_deduire(&BF, "G", 7) && !bf_deduire(&BF, "G", 8) &&
+                bf_origine(&BF, "G") == 7 && bf_origine(&BF, "A") == BF_ORIGINE_AUCUNE);
+    static const char *const retires[] = {"A", "B", "C", "D", "E"};
+    for (int i = 0; i < 5; i++) bf_supprimer(&BF, retires[i]);
+    test_result("provenance -> apres compactage", bf_nb_emplacements(&BF) < 7 && bf_origine(&BF, "G") == 7 &&
+                bf_origine(&BF, "F") == BF_ORIGINE_AUCUNE && bf_origine(&BF, "X") == BF_ORIGINE_AUCUNE);
+
+    // Points de retour imbriqués : état exact (emplacements, provenance) rétabli
+    static const char *const etat[] = {"F", "G"};
+    size_t emplacements = bf_nb_emplacements(&BF);
+    size_t p1 = bf_point(&BF);
+    bf_ajouter(&BF, "H1");
+    bf_supprimer(&BF, "F");
+    size_t p2 = bf_point(&BF);
+    bf_deduire(&BF, "H2", 3);
+    bf_supprimer(&BF, "G");
+    bf_ajouter(&BF, "F");
+    bf_supprimer(&BF, "H1");
+    bf_ajouter(&BF, "G");
+    test_result("retour -> modifications visibles", bf_taille(&BF) == 3 && !bf_contient(&BF, "H1") &&
+                bf_origine(&BF, "G") == BF_ORIGINE_AUCUNE);
+    bf_revenir(&BF, p2);
+    test_result("retour -> point interne", bf_taille(&BF) == 2 && bf_contient(&BF, "H1") &&
+                !bf_contient(&BF, "F") && !bf_contient(&BF, "H2") && bf_origine(&BF, "G") == 7);
+    bf_vider(&BF);
+    bf_revenir(&BF, p1);
+    bool exact = bf_taille(&BF) == 2 && bf_nb_emplacements(&BF) == emplacements;
+    for (size_t i = 0, k = 0; exact && i < bf_nb_emplacements(&BF); i++) {
+        const char *f = bf_emplacement(&BF, i);
+        if (f) exact = k < 2 && strcmp(f, etat[k++]) == 0;
+    }
+    test_result("retour -> point initial (apres vider)", exact && bf_origine(&BF, "G") == 7 &&
+                bf_origine(&BF, "F") == BF_ORIGINE_AUCUNE);
+    bf_ajouter(&BF, "H3");
+    bf_valider(&BF);
+    test_result("valider -> modifications gardees", !BF.retour_actif && BF.nb_retour == 0 && bf_contient(&BF, "H3"));
+
+    // Couches : deux sessions privées au-dessus d’une base partagée
+    BaseFaits partagee, s1, s2;
+    bf_init(&partagee);
+    bf_activer_provenance(&partagee);
+    bf_ajouter(&partagee, "P1");
+    bf_deduire(&partagee, "P2", 4);
+    bf_init_sur(&s1, &partagee, NULL);
+    bf_init_sur(&s2, &partagee, NULL);
+    test_result("couche -> base visible", bf_contient(&s1, "P2") && bf_taille(&s1) == 2 && !bf_est_vide(&s1) &&
+                !bf_ajouter(&s1, "P1") && s1.size == 0);
+    bf_ajouter(&s1, "Q1");
+    static const char *const lot_couche[] = {"P2", "Q2"};
+    test_result("couche -> lot sans les faits de la base", bf_affirmer_lot(&s2, lot_couche, 2) == 1 &&
+                bf_contient(&s2, "Q2") && !bf_contient(&s1, "Q2") && !bf_contient(&partagee, "Q1"));
+    test_result("couche -> base non modifiable", !bf_supprimer(&s1, "P1") && bf_contient(&s1, "P1") &&
+                bf_origine(&s1, "P2") == 4);
+    bool parcours = bf_nb_emplacements(&s1) == 3 && strcmp(bf_emplacement(&s1, 0), "P1") == 0 &&
+                    strcmp(bf_emplacement(&s1, 2), "Q1") == 0;
+    test_result("couche -> parcours base puis couche", parcours);
+    bf_vider(&s1);
+    test_result("couche -> vider la couche seule", bf_taille(&s1) == 2 && bf_taille(&partagee) == 2);
+    bf_detruire(&s2);
+    bf_detruire(&s1);
+    bf_detruire(&partagee);
+
+    // Statistiques : tableaux (ordre et provenance) et index
+    StatsFaits sf;
+    bf_stats(&BF, &sf);
+    test_result("stats -> faits et index", sf.nb_faits == bf_taille(&BF) && sf.index.nb_elements == sf.nb_faits &&
+                sf.octets_ordre == sf.cap * (sizeof(char *) + sizeof(uint64_t)));
+
+    bf_detruire(&autre);
+    bf_detruire(&BF);
 }
 
 /*
@@ -217,11 +542,9 @@ void tests_inference(void) {
     // Initialisation des structures
     BaseConnaissances BC;
     BaseFaits BF;
-    HashTable ht;
 
     bc_init(&BC);
-    liste_init(&BF);
-    hash_table_init(&ht);
+    bf_init(&BF);
 
     // Création d’une règle : IF A THEN B
     Regle R;
@@ -232,18 +555,1998 @@ void tests_inference(void) {
     regle_detruire(&R);
 
     // Ajout du fait initial A
-    liste_ajouter_en_queue(&BF, "A");
+    bf_ajouter(&BF, "A");
 
     // Lancement du moteur d’inférence
-    moteur_inference(&BC, &BF, &ht);
+    moteur_inference(&BC, &BF);
 
     // Vérification de la déduction
-    test_result("inference -> B deduit", liste_contient_rec(&BF, "B"));
+    test_result("inference -> B deduit", bf_contient(&BF, "B"));
+
+    // Chaîne C => D, B => C, A => B : une déduction par tour
+    bc_vider(&BC);
+    FILE *f = tmpfile();
+    fputs("C => D\nB => C\nA => B\n", f);
+    rewind(f);
+    bc_charger_flux(&BC, f);
+    fclose(f);
+
+    OptionsInference O;
+    options_inference_init(&O);
+    O.silencieux = true;
+    static const char *const cibles[] = {"X", "C"};
+
+    bf_vider(&BF);
+    bf_ajouter(&BF, "A");
+    O.cibles = cibles;
+    O.nb_cibles = 2;
+    ResultatInference r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> arret sur cible C", r.arret == INFERENCE_CIBLE && !r.complete &&
+                strcmp(r.cible, "C") == 0 && !bf_contient(&BF, "D"));
+    r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> cible deja connue", r.arret == INFERENCE_CIBLE && r.tours == 0);
+    O.nb_cibles = 0;
+
+    bf_vider(&BF);
+    bf_ajouter(&BF, "A");
+    O.max_tours = 1;
+    r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> limite de tours", r.arret == INFERENCE_TOURS && r.deduits == 1 &&
+                bf_contient(&BF, "B") && !bf_contient(&BF, "C"));
+    O.max_tours = 0;
+
+    bf_vider(&BF);
+    bf_ajouter(&BF, "A");
+    O.max_deduits = 2;
+    r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> limite de deductions", r.arret == INFERENCE_DEDUITS && bf_taille(&BF) == 3);
+    O.max_deduits = 0;
+
+    bf_vider(&BF);
+    bf_ajouter(&BF, "A");
+    O.delai_us = 60000000u;
+    r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> saturation complete", r.complete && r.arret == INFERENCE_SATUREE &&
+                r.tours == 4 && r.deduits == 3 && r.declenchements == 3);
+    O.delai_us = 0;
+
+    // Élagage : seules les règles atteignables depuis les faits de base possibles
+    FILE *g = tmpfile();
+    fputs("X => Y\nY AND B => Z\n", g);
+    rewind(g);
+    bc_charger_flux(&BC, g);
+    fclose(g);
+    static const char *const base[] = {"A", "inconnu"};
+    bf_vider(&BF);
+    bf_ajouter(&BF, "A");
+    O.base_possible = base;
+    O.nb_base_possible = 2;
+    r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> elagage (2 regles)", r.complete && r.elaguees == 2 && r.deduits == 3 &&
+                bf_contient(&BF, "D"));
+    bf_ajouter(&BF, "X");
+    r = moteur_inference_opts(&BC, &BF, &O);
+    test_result("opts -> faits connus jamais elagues", r.elaguees == 0 && bf_contient(&BF, "Z"));
+    O.base_possible = NULL;
+    O.nb_base_possible = 0;
+
+    // Explication d’après la provenance, sans relancer l’inférence
+    bc_vider(&BC);
+    g = tmpfile();
+    fputs("A => B\nA AND B => C\nB AND C => D\n", g);
+    rewind(g);
+    bc_charger_flux(&BC, g);
+    fclose(g);
+    bf_vider(&BF);
+    bf_activer_provenance(&BF);
+    bf_ajouter(&BF, "A");
+    moteur_inference_opts(&BC, &BF, &O);
+    g = tmpfile();
+    size_t etapes = inference_expliquer(&BC, &BF, "D", g);
+    char preuve[512] = "";
+    rewind(g);
+    size_t lus = fread(preuve, 1, sizeof(preuve) - 1, g);
+    preuve[lus] = '\0';
+    fclose(g);
+    test_result("expliquer -> 4 faits", etapes == 4 && (uint32_t)bf_origine(&BF, "D") == 2);
+    test_result("expliquer -> arbre", strstr(preuve, "D <= [2] B AND C => D\n") &&
+                strstr(preuve, "    A (fait initial)\n") && strstr(preuve, "  B (voir plus haut)\n"));
+    test_result("expliquer -> fait inconnu", inference_expliquer(&BC, &BF, "X", stdout) == 0);
+    bc_supprimer_regle(&BC, bc_id_emplacement(&BC, 0));
+    g = tmpfile();
+    inference_expliquer(&BC, &BF, "B", g);
+    rewind(g);
+    lus = fread(preuve, 1, sizeof(preuve) - 1, g);
+    preuve[lus] = '\0';
+    fclose(g);
+    test_result("expliquer -> regle supprimee", strstr(preuve, "modifiée ou supprimée") != NULL);
+
+    // Prémisse retirée (B => D reste vraie) puis emplacement réutilisé par une règle identique
+    bc_supprimer_premisse(&BC, bc_id_emplacement(&BC, 2), "C");
+    bc_supprimer_regle(&BC, bc_id_emplacement(&BC, 1));
+    Regle copie;
+    regle_init(&copie);
+    regle_ajouter_premisse(&copie, "A");
+    regle_ajouter_premisse(&copie, "B");
+    regle_definir_conclusion(&copie, "C");
+    bool reutilise = (uint32_t)bc_ajouter_regle_en_queue(&BC, &copie) == 1;
+    regle_detruire(&copie);
+    g = tmpfile();
+    inference_expliquer(&BC, &BF, "D", g);
+    inference_expliquer(&BC, &BF, "C", g);
+    rewind(g);
+    lus = fread(preuve, 1, sizeof(preuve) - 1, g);
+    preuve[lus] = '\0';
+    fclose(g);
+    test_result("expliquer -> premisse retiree, emplacement reutilise", reutilise &&
+                strstr(preuve, "D (règle [2] modifiée ou supprimée depuis)") &&
+                strstr(preuve, "C (règle [1] modifiée ou supprimée depuis)"));
+
+    // Hypothèses sous points de retour : seules les déductions sont défaites
+    g = tmpfile();
+    fputs("H => I\nI AND A => J\nK AND J => L\n", g);
+    rewind(g);
+    bc_charger_flux(&BC, g);
+    fclose(g);
+    size_t taille = bf_taille(&BF), emplacements = bf_nb_emplacements(&BF);
+    size_t hypothese = bf_point(&BF);
+    bool alternatives = true;
+    for (int essai = 0; essai < 1000 && alternatives; essai++) {
+        bf_revenir(&BF, hypothese);
+        bf_ajouter(&BF, "H");
+        moteur_inference_opts(&BC, &BF, &O);
+        size_t imbrique = bf_point(&BF);
+        bf_ajouter(&BF, "K");
+        moteur_inference_opts(&BC, &BF, &O);
+        alternatives = bf_contient(&BF, "L");
+        bf_revenir(&BF, imbrique);
+        alternatives = alternatives && bf_contient(&BF, "J") && !bf_contient(&BF, "K") && !bf_contient(&BF, "L");
+    }
+    test_result("hypotheses -> 1000 alternatives", alternatives && BF.nb_retour <= 3);
+    bf_revenir(&BF, hypothese);
+    bf_valider(&BF);
+    // Couche au-dessus de la base saturée : déductions privées
+    BaseFaits couche;
+    bf_init_sur(&couche, &BF, NULL);
+    bf_activer_provenance(&couche);
+    bf_ajouter(&couche, "H");
+    moteur_inference_opts(&BC, &couche, &O);
+    test_result("couche -> deductions privees", bf_contient(&couche, "J") && couche.size == 3 &&
+                !bf_contient(&BF, "H") && bf_origine(&couche, "J") != BF_ORIGINE_AUCUNE &&
+                (uint32_t)bf_origine(&couche, "D") == 2);
+    bf_detruire(&couche);
+    test_result("hypotheses -> base retablie", bf_taille(&BF) == taille && bf_nb_emplacements(&BF) == emplacements &&
+                !bf_contient(&BF, "H") && !bf_contient(&BF, "J") && (uint32_t)bf_origine(&BF, "D") == 2);
 
     // Nettoyage des structures
     bc_vider(&BC);
-    liste_vider(&BF);
-    hash_table_clear(&ht);
+    bf_detruire(&BF);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_compilation
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie le chargement texte d’une BC, sa compilation et le
+ *  chaînage avant incrémental d’une session :
+ *   - internement des propositions
+ *   - déduction en chaîne (A -> B -> C)
+ *   - prémisses en double et règle sans prémisse
+ *   - élagage des règles inatteignables
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Structures testées :
+ *  - BCCompilee, Session
+ */
+void tests_compilation(void) {
+    printf("\n--- Tests COMPILATION ---\n");
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+
+    // Chargement depuis un flux texte
+    FILE *f = tmpfile();
+    fputs("# exemple\nA => B\nB AND A AND B => C\n=> Z\n", f);
+    rewind(f);
+    test_result("charger flux -> 3 regles", bc_charger_flux(&BC, f) && BC.size == 3);
+    fclose(f);
+
+    f = tmpfile();
+    fputs("A AND => B\n", f);
+    rewind(f);
+    test_result("charger flux -> ligne invalide", !bc_charger_flux(&BC, f));
+    fclose(f);
+
+    // Ligne plus longue que tout tampon fixe : 150 prémisses
+    f = tmpfile();
+    for (int i = 0; i < 150; i++) fprintf(f, "%spremisse_longue_%03d", i ? " AND " : "", i);
+    fputs(" => Y\n", f);
+    rewind(f);
+    BaseConnaissances longue;
+    bc_init(&longue);
+    test_result("charger flux -> regle de 150 premisses", bc_charger_flux(&longue, f) && longue.size == 1 &&
+                bc_tete(&longue)->premisses.size == 150);
+    bc_vider(&longue);
+    fclose(f);
+
+    // Compilation
+    BCCompilee C;
+    bcc_compiler(&C, &BC);
+    PropId a = symboles_chercher(&C.symboles, "A");
+    PropId c = symboles_chercher(&C.symboles, "C");
+    test_result("compiler -> 4 propositions", bcc_nb_propositions(&C) == 4);
+    test_result("compiler -> premisses dedoublonnees", C.regles[1].nb == 2);
+    test_result("symbole inconnu", symboles_chercher(&C.symboles, "X") == PROP_AUCUNE);
+
+    // Session incrémentale
+    Session S;
+    session_init(&S, &C);
+    test_result("session -> regle sans premisse", session_saturer(&S) == 0 &&
+                session_est_vrai(&S, symboles_chercher(&C.symboles, "Z")));
+    test_result("session -> affirmer A", session_affirmer(&S, a));
+    test_result("session -> A deja vrai", !session_affirmer(&S, a));
+    test_result("session -> 2 deductions", session_saturer(&S) == 2);
+    test_result("session -> C deduit", session_est_vrai(&S, c));
+
+    session_reinitialiser(&S);
+    test_result("reinitialiser -> C faux", !session_est_vrai(&S, c));
+
+    PropId lot[] = {a, PROP_AUCUNE, a, symboles_chercher(&C.symboles, "Z")};
+    test_result("session -> lot (1 nouveau)", session_affirmer_lot(&S, lot, 4) == 1);
+    test_result("session -> lot sature", session_saturer(&S) == 2 && session_est_vrai(&S, c));
+    session_detruire(&S);
+    bcc_detruire(&C);
+
+    // Élagage des règles inatteignables (D n’est jamais affirmé)
+    f = tmpfile();
+    fputs("D => E\nE AND A => F\nC AND D => G\n", f);
+    rewind(f);
+    bc_charger_flux(&BC, f);
+    fclose(f);
+    bcc_compiler(&C, &BC);
+    a = symboles_chercher(&C.symboles, "A");
+    uint8_t atteignables[6];
+    test_result("atteignables -> 3 regles sur 6", bcc_atteignables(&C, &a, 1, atteignables) == 3 &&
+                atteignables[1] && !atteignables[3] && !atteignables[5]);
+    test_result("elaguer -> 3 regles retirees", bcc_elaguer(&C, &a, 1) == 3 && C.nb_regles == 3);
+    session_init(&S, &C);
+    session_affirmer(&S, a);
+    test_result("elaguer -> session identique", session_saturer(&S) == 2 && session_est_vrai(&S, c) &&
+                !session_est_vrai(&S, symboles_chercher(&C.symboles, "G")));
+    PropId d = symboles_chercher(&C.symboles, "D");
+    test_result("elaguer -> regles retirees inactives", session_affirmer(&S, d) && session_saturer(&S) == 0);
+    const uint32_t *producteurs;
+    c = symboles_chercher(&C.symboles, "C");
+    test_result("elaguer -> producteurs renumerotes", bcc_producteurs(&C, c, &producteurs) == 1 &&
+                C.regles[producteurs[0]].conclusion == c && bcc_producteurs(&C, d, &producteurs) == 0);
+
+    session_detruire(&S);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // Producteurs et ordre des dépendances (règles groupées par conclusion)
+    f = tmpfile();
+    fputs("C => D\nA => B\nB AND A => C\nX => B\n", f);
+    rewind(f);
+    bc_charger_flux(&BC, f);
+    fclose(f);
+    bcc_compiler(&C, &BC);
+    uint32_t ordre[5];
+    PropId b = symboles_chercher(&C.symboles, "B");
+    test_result("producteurs -> ordre de la BC", bcc_producteurs(&C, b, &producteurs) == 2 &&
+                producteurs[0] == 1 && producteurs[1] == 3 &&
+                bcc_producteurs(&C, symboles_chercher(&C.symboles, "A"), &producteurs) == 0);
+    test_result("ordre des dependances", bcc_ordre_dependances(&C, ordre) && ordre[0] == 1 && ordre[1] == 3 &&
+                ordre[2] == 2 && ordre[3] == 0);
+    bcc_detruire(&C);
+    f = tmpfile();
+    fputs("D => A\n", f);
+    rewind(f);
+    bc_charger_flux(&BC, f);
+    fclose(f);
+    bcc_compiler(&C, &BC);
+    test_result("ordre des dependances -> cycle en fin", !bcc_ordre_dependances(&C, ordre) && ordre[0] == 0 &&
+                ordre[1] == 1 && ordre[2] == 2 && ordre[3] == 3 && ordre[4] == 4);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_flux
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie le mode flux de bout en bout sur des fichiers
+ *  temporaires : faits inconnus ignorés, doublons sans effet et
+ *  déductions écrites dans l’ordre.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Mode flux (threads et files bornées)
+ */
+void tests_flux(void) {
+    printf("\n--- Tests FLUX ---\n");
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+    FILE *f = tmpfile();
+    fputs("A => B\nB AND C => D\n", f);
+    rewind(f);
+    bc_charger_flux(&BC, f);
+    fclose(f);
+
+    BCCompilee C;
+    bcc_compiler(&C, &BC);
+
+    FILE *entree = tmpfile();
+    FILE *sortie = tmpfile();
+    fputs("A\ninconnu\nA\n  C  \n", entree);
+    for (int i = 0; i < 3000; i++) fputc('x', entree);  // un seul fait, inconnu
+    fputc('\n', entree);
+    rewind(entree);
+
+    BilanFlux bilan;
+    bool ok = flux_executer(&C, entree, sortie, &bilan);
+    test_result("flux -> termine", ok);
+    test_result("flux -> 5 lus, 2 inconnus", bilan.lus == 5 && bilan.inconnus == 2);
+
+    char buf[64] = "";
+    rewind(sortie);
+    size_t n = fread(buf, 1, sizeof(buf) - 1, sortie);
+    buf[n] = '\0';
+    test_result("flux -> sortie B puis D", strcmp(buf, "B\nD\n") == 0);
+
+    fclose(entree);
+    fclose(sortie);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_codegen
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Compare la BC voiture générée par kb2c à l’interpréteur sur
+ *  toutes les combinaisons des faits d’entrée de l’exemple.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - kb2c (code généré), moteur_inference_generee
+ */
+void tests_codegen(void) {
+    printf("\n--- Tests CODEGEN ---\n");
+
+    static const char *const entrees[] = {
+        "¬reservoirVide", "pharesFonctionnent", "¬moteurDemarre", "¬pharesFonctionnent"
+    };
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+    test_result("charger voiture.kb", bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb"));
+    test_result("recherche nom genere", bcg_chercher(&voiture_bc, "problemeStarter") != UINT32_MAX &&
+                bcg_chercher(&voiture_bc, "inconnu") == UINT32_MAX);
+
+    bool identiques = true;
+    for (unsigned combo = 0; combo < 16; combo++) {
+        BaseFaits BF1, BF2;
+        bf_init(&BF1);
+        bf_init(&BF2);
+
+        for (unsigned i = 0; i < 4; i++) {
+            if (combo & (1u << i)) {
+                bf_ajouter(&BF1, entrees[i]);
+                bf_ajouter(&BF2, entrees[i]);
+            }
+        }
+
+        moteur_inference(&BC, &BF1);
+        moteur_inference_generee(&voiture_bc, &BF2);
+
+        // Mêmes faits (l’ordre peut différer)
+        if (bf_taille(&BF1) != bf_taille(&BF2)) identiques = false;
+        for (size_t i = 0; i < bf_nb_emplacements(&BF1); i++) {
+            const char *f = bf_emplacement(&BF1, i);
+            if (f && !bf_contient(&BF2, f)) identiques = false;
+        }
+
+        bf_detruire(&BF1);
+        bf_detruire(&BF2);
+    }
+    test_result("genere == interpreteur (16 cas)", identiques);
+
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : charger_bc_texte
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Charge une BC depuis un texte (via un fichier temporaire).
+ *
+ * Paramètres :
+ *  - BC    : base de connaissances (initialisée)
+ *  - texte : règles, une par ligne
+ *
+ * Valeur de retour :
+ *  - true si toutes les lignes sont valides
+ */
+static bool charger_bc_texte(BaseConnaissances *BC, const char *texte) {
+    FILE *f = tmpfile();
+    if (!f) return false;
+    fputs(texte, f);
+    rewind(f);
+    bool ok = bc_charger_flux(BC, f);
+    fclose(f);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : expliquer_texte
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Récupère dans un tampon l’explication d’un fait (via un
+ *  fichier temporaire).
+ *
+ * Paramètres :
+ *  - BC     : base de connaissances
+ *  - BF     : base de faits (provenance activée)
+ *  - fait   : fait à expliquer
+ *  - texte  : reçoit l’explication (tronquée si besoin)
+ *  - taille : taille du tampon
+ *
+ * Valeur de retour :
+ *  - texte
+ */
+static const char *expliquer_texte(const BaseConnaissances *BC, const BaseFaits *BF, const char *fait, char *texte,
+                                   size_t taille) {
+    texte[0] = '\0';
+    FILE *f = tmpfile();
+    if (!f) return texte;
+    inference_expliquer(BC, BF, fait, f);
+    rewind(f);
+    texte[fread(texte, 1, taille - 1, f)] = '\0';
+    fclose(f);
+    return texte;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_datalog
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste l’évaluation semi-naïve des règles à variables :
+ *  jointures, fermeture transitive, constantes et variables
+ *  répétées, règles non sûres et BC propositionnelles.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - datalog_compiler, datalog_evaluer
+ */
+void tests_datalog(void) {
+    printf("\n--- Tests DATALOG ---\n");
+
+    BaseConnaissances BC;
+    BaseFaits BF;
+    ProgrammeDatalog P;
+    bc_init(&BC);
+    bf_init(&BF);
+    bf_activer_provenance(&BF);
+
+    // Jointure sur une variable partagée
+    charger_bc_texte(&BC, "panne(V) AND phares(V) => starter(V)\nstarter(V) => remplacer(V, demarreur)\n");
+    bf_ajouter(&BF, "panne(clio)");
+    bf_ajouter(&BF, "panne(golf)");
+    bf_ajouter(&BF, "phares(golf)");
+    bf_ajouter(&BF, "phares(polo)");
+    test_result("compiler regles a variables", datalog_compiler(&P, &BC));
+    test_result("jointure -> 2 deductions", datalog_evaluer(&P, &BF) == 2);
+    test_result("starter(golf) deduit", bf_contient(&BF, "starter(golf)") && !bf_contient(&BF, "starter(clio)"));
+    test_result("constante en conclusion", bf_contient(&BF, "remplacer(golf,demarreur)"));
+    test_result("deduit sans regle enregistree", bf_origine(&BF, "starter(golf)") == BF_ORIGINE_INCONNUE &&
+                bf_origine(&BF, "panne(golf)") == BF_ORIGINE_AUCUNE);
+    datalog_detruire(&P);
+    bc_vider(&BC);
+    bf_vider(&BF);
+
+    // Fermeture transitive d’une chaîne de 30 liens : 30 * 31 / 2 chemins
+    charger_bc_texte(&BC, "lien(X, Y) => chemin(X, Y)\nlien(X, Y) AND chemin(Y, Z) => chemin(X, Z)\n");
+    char fait[32];
+    for (int i = 0; i < 30; i++) {
+        snprintf(fait, sizeof(fait), "lien(n%d,n%d)", i, i + 1);
+        bf_ajouter(&BF, fait);
+    }
+    datalog_compiler(&P, &BC);
+    test_result("fermeture transitive -> 465 chemins", datalog_evaluer(&P, &BF) == 465);
+    test_result("chemin(n0,n30) deduit", bf_contient(&BF, "chemin(n0,n30)"));
+    test_result("iterations semi-naives (<= 31)", P.iterations <= 31);
+
+    // Réévaluation : mêmes relations, aucun fait nouveau
+    test_result("reevaluation -> 0 deduction", datalog_evaluer(&P, &BF) == 0);
+    datalog_detruire(&P);
+    bc_vider(&BC);
+    bf_vider(&BF);
+
+    // Variables répétées et constantes dans le corps
+    charger_bc_texte(&BC, "arc(X, X) => boucle(X)\narc(a, Y) => depuis_a(Y)\n");
+    bf_ajouter(&BF, "arc(a,a)");
+    bf_ajouter(&BF, "arc(a,b)");
+    bf_ajouter(&BF, "arc(c,c)");
+    bf_ajouter(&BF, "arc(b,c)");
+    datalog_compiler(&P, &BC);
+    datalog_evaluer(&P, &BF);
+    test_result("variable repetee", bf_contient(&BF, "boucle(a)") && bf_contient(&BF, "boucle(c)") &&
+                !bf_contient(&BF, "boucle(b)"));
+    test_result("constante dans le corps", bf_contient(&BF, "depuis_a(a)") && bf_contient(&BF, "depuis_a(b)") &&
+                !bf_contient(&BF, "depuis_a(c)"));
+    datalog_detruire(&P);
+    bc_vider(&BC);
+    bf_vider(&BF);
+
+    // Règle non sûre : variable de la conclusion absente du corps
+    charger_bc_texte(&BC, "p(X) => q(X, Y)\n");
+    test_result("regle non sure refusee", !datalog_compiler(&P, &BC));
+    bc_vider(&BC);
+
+    // Une BC propositionnelle donne les mêmes faits que moteur_inference
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+    BaseFaits BF2;
+    bf_init(&BF2);
+    static const char *const entrees[] = {"¬reservoirVide", "pharesFonctionnent", "¬moteurDemarre"};
+    bf_affirmer_lot(&BF, entrees, 3);
+    bf_affirmer_lot(&BF2, entrees, 3);
+    moteur_inference(&BC, &BF2);
+    datalog_compiler(&P, &BC);
+    datalog_evaluer(&P, &BF);
+    bool identiques = bf_taille(&BF) == bf_taille(&BF2);
+    for (size_t i = 0; i < bf_nb_emplacements(&BF2); i++) {
+        const char *f = bf_emplacement(&BF2, i);
+        if (f && !bf_contient(&BF, f)) identiques = false;
+    }
+    test_result("voiture.kb : datalog == moteur", identiques);
+    datalog_detruire(&P);
+
+    bf_detruire(&BF2);
+    bf_detruire(&BF);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : memes_faits
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si deux bases de faits contiennent les mêmes faits
+ *  (quel que soit leur ordre).
+ *
+ * Paramètres :
+ *  - a, b : bases comparées
+ *
+ * Valeur de retour :
+ *  - true si les ensembles sont égaux
+ */
+static bool memes_faits(const BaseFaits *a, const BaseFaits *b) {
+    if (bf_taille(a) != bf_taille(b)) return false;
+    for (size_t i = 0; i < bf_nb_emplacements(a); i++) {
+        const char *f = bf_emplacement(a, i);
+        if (f && !bf_contient(b, f)) return false;
+    }
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_shards
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste le découpage de la BC selon son graphe de dépendances
+ *  et l’inférence répartie sur plusieurs processus, comparée au
+ *  moteur d’inférence.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - shards_partitionner, shards_executer
+ */
+void tests_shards(void) {
+    printf("\n--- Tests SHARDS ---\n");
+
+    BaseConnaissances BC;
+    BCCompilee C;
+    bc_init(&BC);
+
+    // Deux chaînes indépendantes : une par shard, aucun échange
+    charger_bc_texte(&BC, "A1 => A2\nB1 => B2\nA2 => A3\nB2 => B3\nA3 => A4\nB3 => B4\n");
+    bcc_compiler(&C, &BC);
+    uint32_t shard[6];
+    test_result("2 composantes -> frontiere 0", shards_partitionner(&C, 2, shard) == 0);
+    test_result("composantes non coupees", shard[0] == shard[2] && shard[2] == shard[4] &&
+                shard[1] == shard[3] && shard[3] == shard[5] && shard[0] != shard[1]);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // Chaîne coupée en 3 : l’ordre topologique limite la frontière à 2 propositions
+    charger_bc_texte(&BC, "C => D\nB => C\nA => B\nE => F\nD => E\nF => G\n");
+    bcc_compiler(&C, &BC);
+    test_result("chaine en 3 shards -> frontiere 2", shards_partitionner(&C, 3, shard) == 2);
+    bcc_detruire(&C);
+
+    BaseFaits BF1, BF2;
+    bf_init(&BF1);
+    bf_init(&BF2);
+    bf_ajouter(&BF1, "A");
+    bf_ajouter(&BF2, "A");
+    BilanShards bilan;
+    moteur_inference(&BC, &BF1);
+    test_result("chaine repartie -> 6 deduits", shards_executer(&BC, &BF2, 3, &bilan) && bilan.deduits == 6);
+    test_result("chaine repartie == moteur", memes_faits(&BF1, &BF2));
+    test_result("faits echanges entre shards", bilan.messages >= 2 && bilan.regles[0] + bilan.regles[1] + bilan.regles[2] == 6);
+    test_result("nombre de shards invalide", !shards_executer(&BC, &BF2, 0, NULL));
+
+    // Provenance : la règle d’un autre shard est ramenée à son emplacement dans la BC
+    char preuve[512];
+    bf_vider(&BF2);
+    bf_activer_provenance(&BF2);
+    bf_ajouter(&BF2, "A");
+    shards_executer(&BC, &BF2, 3, NULL);
+    test_result("shards -> provenance", (uint32_t)bf_origine(&BF2, "G") == 5 && (uint32_t)bf_origine(&BF2, "C") == 1 &&
+                strstr(expliquer_texte(&BC, &BF2, "G", preuve, sizeof(preuve)), "G <= [5] F => G\n") &&
+                strstr(preuve, " B <= [2] A => B\n") && !strstr(preuve, "B (fait initial)"));
+    bf_vider(&BF1);
+    bf_vider(&BF2);
+    bc_vider(&BC);
+
+    // BC pseudo-aléatoire (cycles, prémisses partagées) répartie sur 4 processus
+    unsigned graine = 12345;
+    char regle[96];
+    for (int r = 0; r < 300; r++) {
+        int n = 0;
+        int nb = (int)((graine = graine * 1103515245u + 12345u) >> 16) % 3 + 1;
+        for (int k = 0; k < nb; k++) {
+            int p = (int)((graine = graine * 1103515245u + 12345u) >> 16) % 80;
+            n += snprintf(regle + n, sizeof(regle) - (size_t)n, "%sP%d", k ? " AND " : "", p);
+        }
+        int c = (int)((graine = graine * 1103515245u + 12345u) >> 16) % 80;
+        snprintf(regle + n, sizeof(regle) - (size_t)n, " => P%d\n", c);
+        charger_bc_texte(&BC, regle);
+    }
+    static const char *const initiaux[] = {"P0", "P1", "P2", "P3", "P4", "P5"};
+    bf_affirmer_lot(&BF1, initiaux, 6);
+    bf_affirmer_lot(&BF2, initiaux, 6);
+    moteur_inference_opts(&BC, &BF1, NULL);
+    test_result("300 regles, 4 processus", shards_executer(&BC, &BF2, 4, &bilan));
+    test_result("BC aleatoire : repartie == moteur", memes_faits(&BF1, &BF2));
+    bf_detruire(&BF1);
+    bf_detruire(&BF2);
+    bc_vider(&BC);
+
+    // Exemple voiture, un processus par règle
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+    static const char *const entrees[] = {"¬reservoirVide", "pharesFonctionnent", "¬moteurDemarre"};
+    bf_init(&BF1);
+    bf_init(&BF2);
+    bf_affirmer_lot(&BF1, entrees, 3);
+    bf_affirmer_lot(&BF2, entrees, 3);
+    moteur_inference(&BC, &BF1);
+    shards_executer(&BC, &BF2, 6, NULL);
+    test_result("voiture.kb : 6 processus == moteur", memes_faits(&BF1, &BF2));
+    bf_detruire(&BF1);
+    bf_detruire(&BF2);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_ensemble
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste l’ensemble compressé d’identifiants : les trois formes
+ *  de conteneurs et leurs conversions, intersection, inclusion,
+ *  test groupé des prémisses et chaînage avant sur l’ensemble.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Structures testées :
+ *  - EnsembleFaits
+ */
+void tests_ensemble(void) {
+    printf("\n--- Tests ENSEMBLE ---\n");
+
+    EnsembleFaits E;
+    ensemble_init(&E);
+
+    // Conteneurs tableaux, clés distinctes
+    test_result("ajouter 3 ids", ensemble_ajouter(&E, 7) && ensemble_ajouter(&E, 70000) &&
+                ensemble_ajouter(&E, 99999999));
+    test_result("ajouter doublon", !ensemble_ajouter(&E, 70000));
+    test_result("contient", ensemble_contient(&E, 7) && ensemble_contient(&E, 99999999) &&
+                !ensemble_contient(&E, 8) && !ensemble_contient(&E, 65536 + 7));
+    test_result("cardinal == 3", ensemble_cardinal(&E) == 3);
+    test_result("retirer", ensemble_retirer(&E, 70000) && !ensemble_retirer(&E, 70000) &&
+                ensemble_cardinal(&E) == 2 && E.nb == 2);
+
+    // Au-delà de ENSEMBLE_TABLEAU_MAX valeurs : bitmap, puis séquences après optimisation
+    for (PropId id = 1000; id < 11000; id++) ensemble_ajouter(&E, id);
+    test_result("tableau plein -> bitmap", E.conteneurs[0].type == CONTENEUR_BITMAP &&
+                ensemble_cardinal(&E) == 10002);
+    ensemble_optimiser(&E);
+    test_result("optimiser -> sequences", E.conteneurs[0].type == CONTENEUR_SEQUENCES &&
+                E.conteneurs[0].taille == 2);
+    test_result("sequences : contient", ensemble_contient(&E, 7) && ensemble_contient(&E, 1000) &&
+                ensemble_contient(&E, 10999) && !ensemble_contient(&E, 11000) && !ensemble_contient(&E, 999));
+    test_result("sequences : retirer", ensemble_retirer(&E, 5000) && !ensemble_contient(&E, 5000) &&
+                ensemble_cardinal(&E) == 10001);
+
+    // Ensemble épars sur un vocabulaire de 100M propositions
+    EnsembleFaits epars, inter;
+    ensemble_init(&epars);
+    ensemble_init(&inter);
+    unsigned graine = 42;
+    for (int i = 0; i < 3000; i++) {
+        graine = graine * 1103515245u + 12345u;
+        ensemble_ajouter(&epars, (PropId)(graine % 100000000u));
+    }
+    ensemble_ajouter(&epars, 1000);
+    ensemble_ajouter(&epars, 5000);
+    test_result("3000 faits epars < 64 Kio", ensemble_octets(&epars) < 64 * 1024);
+
+    // Intersection, inclusion, prémisses
+    ensemble_intersection(&inter, &E, &epars);
+    test_result("intersection", ensemble_contient(&inter, 1000) && !ensemble_contient(&inter, 5000) &&
+                ensemble_cardinal(&inter) == ensemble_cardinal_intersection(&E, &epars));
+    test_result("inclusion", ensemble_inclus(&inter, &E) && ensemble_inclus(&inter, &epars) &&
+                !ensemble_inclus(&epars, &E));
+    PropId premisses[] = {1000, 10998, 7, 1001};
+    test_result("contient_tous", ensemble_contient_tous(&E, premisses, 4));
+    premisses[3] = 5000;
+    test_result("contient_tous (un absent)", !ensemble_contient_tous(&E, premisses, 4));
+
+    ensemble_detruire(&inter);
+    ensemble_detruire(&epars);
+    ensemble_detruire(&E);
+
+    // Chaînage avant sur l’ensemble == session
+    BaseConnaissances BC;
+    BCCompilee C;
+    Session S;
+    bc_init(&BC);
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+    bcc_compiler(&C, &BC);
+    session_init(&S, &C);
+    ensemble_init(&E);
+
+    static const char *const entrees[] = {"¬reservoirVide", "pharesFonctionnent", "¬moteurDemarre"};
+    for (int i = 0; i < 3; i++) {
+        PropId p = symboles_chercher(&C.symboles, entrees[i]);
+        session_affirmer(&S, p);
+        ensemble_ajouter(&E, p);
+    }
+    size_t deduits = session_saturer(&S);
+    bool identiques = ensemble_saturer(&E, &C) == deduits && ensemble_cardinal(&E) == S.nb_faits;
+    for (size_t i = 0; i < S.nb_faits; i++) {
+        if (!ensemble_contient(&E, S.faits[i])) identiques = false;
+    }
+    test_result("saturer ensemble == session", identiques);
+
+    ensemble_detruire(&E);
+    session_detruire(&S);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : journaliser_bc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Journalise toutes les règles d’une BC (ordre d’insertion).
+ *
+ * Paramètres :
+ *  - J  : journal
+ *  - BC : base de connaissances
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void journaliser_bc(Journal *J, const BaseConnaissances *BC) {
+    for (RegleId id = bc_premiere(BC); id != REGLE_ID_INVALIDE; id = bc_suivante(BC, id)) {
+        journal_regle_ajoutee(J, bc_regle(BC, id));
+    }
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_journal
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste le journal d’écriture anticipée : reprise de l’état
+ *  après réouverture, validation groupée, instantané suivi des
+ *  modifications plus récentes, fin de journal tronquée et
+ *  enregistrement corrompu.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Structures testées :
+ *  - Journal
+ */
+void tests_journal(void) {
+    printf("\n--- Tests JOURNAL ---\n");
+
+    static const char *const chemin = "lo21_tests_journal.wal";
+    static const char *const chemin_instantane = "lo21_tests_journal.wal.snap";
+    remove(chemin);
+    remove(chemin_instantane);
+
+    BaseConnaissances BC;
+    BaseFaits BF;
+    Journal J;
+    BilanReprise reprise;
+    bc_init(&BC);
+    bf_init(&BF);
+
+    test_result("ouvrir journal neuf", journal_ouvrir(&J, chemin, &BC, &BF, &reprise) &&
+                !reprise.instantane && reprise.rejoues == 0 && J.numero == 0);
+
+    // Une action = plusieurs modifications, une seule synchronisation
+    charger_bc_texte(&BC, "A AND B => C\nC => D\nD AND E => F\n");
+    journaliser_bc(&J, &BC);
+    static const char *const faits[] = {"A", "B", "E"};
+    for (int i = 0; i < 3; i++) {
+        bf_ajouter(&BF, faits[i]);
+        journal_fait_ajoute(&J, faits[i]);
+    }
+    RegleId deuxieme = bc_suivante(&BC, bc_premiere(&BC));
+    RegleId troisieme = bc_suivante(&BC, deuxieme);
+    journal_premisse_supprimee(&J, &BC, troisieme, "E");
+    bc_supprimer_premisse(&BC, troisieme, "E");
+    journal_regle_supprimee(&J, &BC, deuxieme);
+    bc_supprimer_regle(&BC, deuxieme);
+    journal_fait_supprime(&J, "B");
+    bf_supprimer(&BF, "B");
+    test_result("validation groupee", journal_valider(&J) && J.validations == 1 && journal_valider(&J) &&
+                J.validations == 1);
+    journal_fermer(&J);
+
+    // Réouverture : l’état est rejoué depuis le journal
+    bc_vider(&BC);
+    bf_vider(&BF);
+    bool ok = journal_ouvrir(&J, chemin, &BC, &BF, &reprise);
+    const Regle *r2 = BC.size == 2 ? bc_regle(&BC, bc_suivante(&BC, bc_premiere(&BC))) : NULL;
+    test_result("reprise : journal rejoue", ok && reprise.rejoues == 9 && !reprise.tronque);
+    test_result("reprise : etat restaure", r2 && r2->premisses.size == 1 &&
+                strcmp(liste_element(&r2->premisses, 0), "D") == 0 && strcmp(r2->conclusion, "F") == 0 &&
+                bf_taille(&BF) == 2 && bf_contient(&BF, "A") && bf_contient(&BF, "E") && !bf_contient(&BF, "B"));
+
+    // Instantané, puis modifications plus récentes dans le journal
+    test_result("instantane", ok && journal_instantane(&J, &BC, &BF) && J.depuis_instantane == 0);
+    bf_ajouter(&BF, "G");
+    journal_fait_ajoute(&J, "G");
+    journal_regles_videes(&J);
+    bc_vider(&BC);
+    journal_fermer(&J);
+
+    bf_vider(&BF);
+    ok = journal_ouvrir(&J, chemin, &BC, &BF, &reprise);
+    test_result("instantane + fin du journal", ok && reprise.instantane && reprise.rejoues == 2 &&
+                BC.size == 0 && bf_taille(&BF) == 3 && bf_contient(&BF, "G"));
+    journal_fermer(&J);
+
+    // Écriture interrompue : des octets parasites en fin de journal
+    FILE *f = fopen(chemin, "ab");
+    if (f) {
+        fwrite("\x20\x00\x00\x00garbage", 1, 11, f);
+        fclose(f);
+    }
+    bf_vider(&BF);
+    ok = journal_ouvrir(&J, chemin, &BC, &BF, &reprise);
+    test_result("fin tronquee ignoree", ok && reprise.tronque && reprise.rejoues == 2 && bf_taille(&BF) == 3);
+    journal_fait_ajoute(&J, "H");
+    journal_fermer(&J);
+
+    // Enregistrement corrompu : la reprise s’arrête avant lui
+    f = fopen(chemin, "r+b");
+    if (f) {
+        fseek(f, -1, SEEK_END);
+        fputc('X', f);
+        fclose(f);
+    }
+    bf_vider(&BF);
+    ok = journal_ouvrir(&J, chemin, &BC, &BF, &reprise);
+    test_result("crc invalide detecte", ok && reprise.tronque && !bf_contient(&BF, "H") && bf_taille(&BF) == 3);
+    journal_fermer(&J);
+
+    bf_detruire(&BF);
+    bc_vider(&BC);
+    remove(chemin);
+    remove(chemin_instantane);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_fermeture
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste la fermeture matérialisée : premier calcul, réutilisation
+ *  à l’identique, reprise incrémentale après ajout d’entrées,
+ *  recalcul après retrait d’une entrée, changement de BC et
+ *  fichier corrompu, toujours comparés au moteur d’inférence.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - fermeture_inferer, session_restaurer
+ */
+void tests_fermeture(void) {
+    printf("\n--- Tests FERMETURE ---\n");
+
+    static const char *const chemin = "lo21_tests_fermeture.clo";
+    remove(chemin);
+
+    BaseConnaissances BC;
+    BaseFaits BF, attendu;
+    BilanFermeture bilan;
+    bc_init(&BC);
+    bf_init(&BF);
+    bf_init(&attendu);
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+
+    static const char *const entrees[] = {"¬moteurDemarre", "pharesFonctionnent", "¬reservoirVide"};
+    for (int i = 0; i < 2; i++) {
+        bf_ajouter(&BF, entrees[i]);
+        bf_ajouter(&attendu, entrees[i]);
+    }
+    moteur_inference(&BC, &attendu);
+    test_result("premier calcul", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_CALCULEE && bilan.entrees == 2 && memes_faits(&BF, &attendu));
+
+    // Mêmes entrées : relue sans propagation
+    bf_vider(&BF);
+    for (int i = 0; i < 2; i++) bf_ajouter(&BF, entrees[i]);
+    bf_ajouter(&BF, "inconnuDeLaBC");
+    bf_ajouter(&attendu, "inconnuDeLaBC");
+    test_result("reutilisation", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_REUTILISEE && memes_faits(&BF, &attendu));
+    test_result("reutilisation (faits deja deduits)", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_REUTILISEE && bilan.entrees == 4 && memes_faits(&BF, &attendu));
+
+    // Une entrée de plus : reprise depuis la fermeture enregistrée
+    bf_ajouter(&BF, entrees[2]);
+    bf_ajouter(&attendu, entrees[2]);
+    moteur_inference(&BC, &attendu);
+    test_result("reprise incrementale", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_REPRISE && bilan.deduits == 2 && memes_faits(&BF, &attendu) &&
+                bf_contient(&BF, "appelerGarage"));
+
+    // Une entrée de moins : recalcul
+    bf_vider(&BF);
+    bf_vider(&attendu);
+    bf_ajouter(&BF, entrees[0]);
+    bf_ajouter(&attendu, entrees[0]);
+    moteur_inference(&BC, &attendu);
+    test_result("entree retiree -> recalcul", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_CALCULEE && memes_faits(&BF, &attendu));
+
+    // BC modifiée : l’empreinte ne correspond plus
+    charger_bc_texte(&BC, "¬moteurDemarre => verifierDemarreur\n");
+    bf_ajouter(&attendu, "verifierDemarreur");
+    test_result("bc modifiee -> recalcul", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_CALCULEE && memes_faits(&BF, &attendu));
+
+    // Fichier corrompu : ignoré puis remplacé
+    FILE *f = fopen(chemin, "r+b");
+    if (f) {
+        fseek(f, -1, SEEK_END);
+        fputc(0x7F, f);
+        fclose(f);
+    }
+    test_result("fichier corrompu -> recalcul", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_CALCULEE && memes_faits(&BF, &attendu));
+    test_result("fichier remplace", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_REUTILISEE && bilan.deduits == 0);
+
+    // Provenance : règle notée au calcul, fait déduit sans règle à la relecture
+    char preuve[512];
+    bc_vider(&BC);
+    charger_bc_texte(&BC, "A => B\nB => C\n");
+    bf_vider(&BF);
+    bf_activer_provenance(&BF);
+    bf_ajouter(&BF, "A");
+    test_result("provenance -> calcul", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_CALCULEE && (uint32_t)bf_origine(&BF, "C") == 1 &&
+                strstr(expliquer_texte(&BC, &BF, "C", preuve, sizeof(preuve)), "C <= [1] B => C\n") &&
+                strstr(preuve, "  B <= [0] A => B\n"));
+    bf_vider(&BF);
+    bf_ajouter(&BF, "A");
+    test_result("provenance -> relecture", fermeture_inferer(&BC, &BF, chemin, &bilan) &&
+                bilan.origine == FERMETURE_REUTILISEE && bf_origine(&BF, "B") == BF_ORIGINE_INCONNUE &&
+                strstr(expliquer_texte(&BC, &BF, "B", preuve, sizeof(preuve)), "règle non enregistrée") &&
+                !strstr(preuve, "fait initial"));
+
+    // État restauré non clos : c est ajouté, d attend encore b
+    charger_bc_texte(&BC, "a => c\nc AND b => d\n");
+    BCCompilee C;
+    Session S;
+    bcc_compiler(&C, &BC);
+    session_init(&S, &C);
+    PropId pa = symboles_chercher(&C.symboles, "a");
+    PropId pb = symboles_chercher(&C.symboles, "b");
+    PropId pc = symboles_chercher(&C.symboles, "c");
+    PropId pd = symboles_chercher(&C.symboles, "d");
+    session_restaurer(&S, &pa, 1);
+    test_result("restaurer non clos -> c seul", session_saturer(&S) == 0 &&
+                session_est_vrai(&S, pc) && !session_est_vrai(&S, pd));
+    session_affirmer(&S, pb);
+    test_result("restaurer non clos -> d apres b", session_saturer(&S) == 1 && session_est_vrai(&S, pd));
+    session_detruire(&S);
+    bcc_detruire(&C);
+
+    bf_detruire(&attendu);
+    bf_detruire(&BF);
+    bc_vider(&BC);
+    remove(chemin);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_veille
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Teste la propagation par prémisse surveillée sur des règles à
+ *  150 prémisses enchaînées : mêmes faits que Session pour des
+ *  jeux d’entrées successifs, retour arrière sans réinitialisation
+ *  et nombre de déplacements de surveillance borné.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Structures testées :
+ *  - SessionVeille
+ */
+void tests_veille(void) {
+    printf("\n--- Tests VEILLE ---\n");
+
+    // Règle r : 150 des 200 faits de base B*, plus C(r-1), => C(r)
+    BaseConnaissances BC;
+    bc_init(&BC);
+    char nom[32];
+    for (int r = 0; r < 40; r++) {
+        Regle R;
+        regle_init(&R);
+        for (int k = 0; k < 150; k++) {
+            snprintf(nom, sizeof(nom), "B%d", (r * 5 + k) % 200);
+            regle_ajouter_premisse(&R, nom);
+        }
+        if (r > 0) {
+            snprintf(nom, sizeof(nom), "C%d", r - 1);
+            regle_ajouter_premisse(&R, nom);
+        }
+        snprintf(nom, sizeof(nom), "C%d", r);
+        regle_definir_conclusion(&R, nom);
+        bc_ajouter_regle_en_queue(&BC, &R);
+        regle_detruire(&R);
+    }
+    Regle axiome;
+    regle_init(&axiome);
+    regle_definir_conclusion(&axiome, "B7");
+    bc_ajouter_regle_en_queue(&BC, &axiome);
+    regle_detruire(&axiome);
+
+    BCCompilee C;
+    Session S;
+    SessionVeille V;
+    bcc_compiler(&C, &BC);
+    session_init(&S, &C);
+    veille_init(&V, &C);
+    size_t np = bcc_nb_propositions(&C);
+
+    test_result("axiome au fond de la pile", V.base == 1 && veille_saturer(&V) == 0 &&
+                veille_est_vrai(&V, symboles_chercher(&C.symboles, "B7")));
+    size_t niveau = veille_niveau(&V);
+
+    // Jeux d’entrées : tous les B* sauf un trou qui coupe la chaîne
+    bool identiques = true;
+    size_t total = 0;
+    for (int essai = 0; essai <= 20; essai++) {
+        session_reinitialiser(&S);
+        veille_revenir(&V, niveau);
+        for (int b = 0; b < 200; b++) {
+            if (essai > 0 && b == essai * 9) continue;
+            snprintf(nom, sizeof(nom), "B%d", b);
+            PropId p = symboles_chercher(&C.symboles, nom);
+            session_affirmer(&S, p);
+            veille_affirmer(&V, p);
+        }
+        size_t d = session_saturer(&S);
+        if (veille_saturer(&V) != d) identiques = false;
+        total += d;
+        for (PropId p = 0; p < np; p++) {
+            if (session_est_vrai(&S, p) != veille_est_vrai(&V, p)) identiques = false;
+        }
+    }
+    test_result("veille == session (21 jeux)", identiques && total > 40);
+    test_result("veille -> deplacements bornes", V.deplacements < 21 * 40 * 151);
+
+    // Hypothèse puis retour arrière : seuls les faits dépilés redeviennent faux
+    veille_revenir(&V, niveau);
+    for (int b = 0; b < 200; b++) {
+        snprintf(nom, sizeof(nom), "B%d", b);
+        if (b != 100) veille_affirmer(&V, symboles_chercher(&C.symboles, nom));
+    }
+    veille_saturer(&V);
+    size_t avant = veille_niveau(&V);
+    PropId b100 = symboles_chercher(&C.symboles, "B100");
+    PropId c39 = symboles_chercher(&C.symboles, "C39");
+    veille_affirmer(&V, b100);
+    test_result("hypothese -> chaine complete", veille_saturer(&V) > 0 && veille_est_vrai(&V, c39));
+    veille_revenir(&V, avant);
+    test_result("retour -> hypothese retiree", !veille_est_vrai(&V, b100) && !veille_est_vrai(&V, c39) &&
+                veille_niveau(&V) == avant);
+    veille_affirmer(&V, b100);
+    test_result("hypothese rejouee", veille_saturer(&V) > 0 && veille_est_vrai(&V, c39));
+
+    veille_detruire(&V);
+    session_detruire(&S);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_profil
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie la collecte des fréquences des prémisses pendant
+ *  l’inférence, le réordonnancement (BC et BC compilée) sans
+ *  changement des déductions, et la persistance du profil.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Profil des prémisses (profil.c) et moteur d’inférence
+ */
+void tests_profil(void) {
+    printf("\n--- Tests PROFIL ---\n");
+
+    static const char *const chemin = "lo21_tests_profil.txt";
+    static const char *const texte = "A AND B AND C => X\nB AND D => Y\n";
+    remove(chemin);
+
+    BaseConnaissances BC;
+    ProfilPremisses P;
+    bc_init(&BC);
+    profil_init(&P);
+    charger_bc_texte(&BC, texte);
+
+    // Requêtes : A toujours vrai, B souvent, C rarement, D jamais
+    static const char *const requetes[][3] = {{"A", "B", NULL}, {"A", NULL, NULL}, {"A", "B", "C"}};
+    OptionsInference O;
+    options_inference_init(&O);
+    O.silencieux = true;
+    O.profil = &P;
+    for (size_t q = 0; q < 3; q++) {
+        BaseFaits BF;
+        bf_init(&BF);
+        for (size_t i = 0; i < 3 && requetes[q][i]; i++) bf_ajouter(&BF, requetes[q][i]);
+        moteur_inference_opts(&BC, &BF, &O);
+        bf_detruire(&BF);
+    }
+    test_result("collecte -> une observation par requete", profil_taille(&P) == 4 &&
+                P.tests[symboles_chercher(&P.noms, "B")] == 3 && P.vrais[symboles_chercher(&P.noms, "B")] == 2);
+    test_result("frequences lissees", profil_frequence(&P, "A") > profil_frequence(&P, "B") &&
+                profil_frequence(&P, "B") > profil_frequence(&P, "C") &&
+                profil_frequence(&P, "C") > profil_frequence(&P, "D") &&
+                profil_frequence(&P, "inconnue") == 0.5);
+
+    // Réordonnancement : la prémisse la plus rare en tête
+    test_result("reordonnancement BC", profil_ordonner_bc(&BC, &P) == 2);
+    const Regle *R = bc_regle(&BC, bc_premiere(&BC));
+    test_result("premisses triees", strcmp(liste_element(&R->premisses, 0), "C") == 0 &&
+                strcmp(liste_element(&R->premisses, 1), "B") == 0 &&
+                strcmp(liste_element(&R->premisses, 2), "A") == 0);
+    test_result("deja ordonnee -> inchangee", profil_ordonner_bc(&BC, &P) == 0);
+
+    BaseConnaissances origine;
+    BaseFaits a, b;
+    bc_init(&origine);
+    bf_init(&a);
+    bf_init(&b);
+    charger_bc_texte(&origine, texte);
+    static const char *const base[] = {"A", "B", "C", "D"};
+    for (size_t i = 0; i < 4; i++) {
+        bf_ajouter(&a, base[i]);
+        bf_ajouter(&b, base[i]);
+    }
+    options_inference_init(&O);
+    O.silencieux = true;
+    moteur_inference_opts(&origine, &a, &O);
+    moteur_inference_opts(&BC, &b, &O);
+    test_result("memes deductions", memes_faits(&a, &b) && bf_contient(&b, "X") && bf_contient(&b, "Y"));
+
+    // BC compilée : même ordre, index inchangé
+    BCCompilee C;
+    bcc_compiler(&C, &origine);
+    test_result("reordonnancement BC compilee", profil_ordonner_bcc(&C, &P) == 2 &&
+                C.premisses[C.regles[0].debut] == symboles_chercher(&C.symboles, "C"));
+    Session S;
+    session_init(&S, &C);
+    for (size_t i = 0; i < 3; i++) session_affirmer(&S, symboles_chercher(&C.symboles, base[i]));
+    session_saturer(&S);
+    test_result("session sur BC compilee reordonnee", session_est_vrai(&S, symboles_chercher(&C.symboles, "X")) &&
+                !session_est_vrai(&S, symboles_chercher(&C.symboles, "Y")));
+    session_detruire(&S);
+    bcc_detruire(&C);
+
+    // Persistance : relu à l’identique, puis cumulé
+    ProfilPremisses relu;
+    profil_init(&relu);
+    test_result("fichier absent -> profil vide", profil_charger(&relu, chemin) && profil_taille(&relu) == 0);
+    test_result("enregistrement", profil_enregistrer(&P, chemin));
+    test_result("relecture", profil_charger(&relu, chemin) && profil_taille(&relu) == 4 &&
+                profil_frequence(&relu, "C") == profil_frequence(&P, "C"));
+    test_result("cumul", profil_charger(&relu, chemin) && relu.tests[symboles_chercher(&relu.noms, "A")] == 6);
+    FILE *f = fopen(chemin, "w");
+    if (f) {
+        fputs("3 x A\n", f);
+        fclose(f);
+    }
+    test_result("ligne invalide refusee", !profil_charger(&relu, chemin));
+
+    // Proposition plus longue qu’un tampon de ligne classique
+    char longue[1501];
+    memset(longue, 'p', sizeof(longue) - 1);
+    longue[sizeof(longue) - 1] = '\0';
+    ProfilPremisses L1, L2;
+    profil_init(&L1);
+    profil_init(&L2);
+    profil_commencer(&L1);
+    profil_noter(&L1, longue, true);
+    test_result("proposition de 1500 caracteres relue", profil_enregistrer(&L1, chemin) &&
+                profil_charger(&L2, chemin) && profil_taille(&L2) == 1 &&
+                profil_frequence(&L2, longue) == profil_frequence(&L1, longue));
+    profil_detruire(&L1);
+    profil_detruire(&L2);
+    remove(chemin);
+
+    profil_detruire(&relu);
+    bf_detruire(&a);
+    bf_detruire(&b);
+    bc_vider(&origine);
+    profil_detruire(&P);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : masque_explication
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Code une explication en masque sur une liste de faits de base
+ *  (comparaison avec l’énumération exhaustive).
+ *
+ * Paramètres :
+ *  - x     : explication
+ *  - base  : faits de base
+ *  - nb    : nombre de faits de base
+ *
+ * Valeur de retour :
+ *  - masque (bit i : base[i] dans l’explication)
+ */
+static uint32_t masque_explication(const Explication *x, const PropId *base, size_t nb) {
+    uint32_t m = 0;
+    for (uint32_t j = 0; j < x->nb; j++)
+        for (size_t i = 0; i < nb; i++)
+            if (base[i] == x->faits[j]) m |= 1u << i;
+    return m;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_abduction
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie les explications minimales : comparaison exhaustive
+ *  sur voiture.kb (chaque proposition, tous les sous-ensembles de
+ *  faits de base), règles redondantes, cycles, faits connus et
+ *  limites de taille et de nombre.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Abduction (abduction.c) et BC compilée
+ */
+void tests_abduction(void) {
+    printf("\n--- Tests ABDUCTION ---\n");
+
+    BaseConnaissances BC;
+    BCCompilee C;
+    Explications E;
+    OptionsAbduction O;
+    bc_init(&BC);
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+    bcc_compiler(&C, &BC);
+
+    // Faits de base : propositions qu’aucune règle ne conclut
+    size_t np = bcc_nb_propositions(&C);
+    uint8_t *conclue = (uint8_t *)calloc(np, 1);
+    PropId base[16];
+    size_t nb_base = 0;
+    for (size_t r = 0; r < C.nb_regles; r++) conclue[C.regles[r].conclusion] = 1;
+    for (PropId p = 0; p < np; p++)
+        if (!conclue[p] && nb_base < 16) base[nb_base++] = p;
+
+    // Chaque sous-ensemble de la base : propositions déduites
+    size_t nb_masques = (size_t)1 << nb_base;
+    uint8_t *deduit = (uint8_t *)calloc(nb_masques * np, 1);
+    Session S;
+    session_init(&S, &C);
+    for (size_t m = 0; m < nb_masques; m++) {
+        session_reinitialiser(&S);
+        for (size_t i = 0; i < nb_base; i++)
+            if (m & ((size_t)1 << i)) session_affirmer(&S, base[i]);
+        session_saturer(&S);
+        for (PropId p = 0; p < np; p++) deduit[m * np + p] = session_est_vrai(&S, p);
+    }
+
+    bool conforme = true;
+    for (PropId g = 0; g < np; g++) {
+        size_t attendues = 0;
+        for (size_t m = 0; m < nb_masques; m++) {
+            bool minimal = deduit[m * np + g];
+            for (size_t i = 0; i < nb_base && minimal; i++)
+                if ((m & ((size_t)1 << i)) && deduit[(m & ~((size_t)1 << i)) * np + g]) minimal = false;
+            if (minimal) attendues++;
+        }
+        if (abduire(&C, g, NULL, &E) != attendues || !E.complet) conforme = false;
+        for (size_t i = 0; i < E.nb; i++) {
+            uint32_t m = masque_explication(&E.e[i], base, nb_base);
+            if (!deduit[m * np + g] || (i > 0 && E.e[i].nb < E.e[i - 1].nb)) conforme = false;
+            for (size_t k = 0; k < nb_base; k++)
+                if ((m & (1u << k)) && deduit[(m & ~(1u << k)) * np + g]) conforme = false;
+        }
+        explications_detruire(&E);
+    }
+    test_result("voiture.kb -> explications == enumeration", conforme && nb_base == 4);
+
+    PropId garage = symboles_chercher(&C.symboles, "appelerGarage");
+    test_result("appelerGarage -> 1 explication de 3 faits",
+                abduire(&C, garage, NULL, &E) == 1 && E.e[0].nb == 3);
+    explications_detruire(&E);
+
+    // Faits connus : seuls les faits manquants sont proposés
+    uint8_t *connus = (uint8_t *)calloc(np, 1);
+    connus[symboles_chercher(&C.symboles, "¬moteurDemarre")] = 1;
+    abduction_options_init(&O);
+    O.connus = connus;
+    test_result("faits connus -> exclus de l'explication",
+                abduire(&C, garage, &O, &E) == 1 && E.e[0].nb == 2);
+    explications_detruire(&E);
+    connus[symboles_chercher(&C.symboles, "¬reservoirVide")] = 1;
+    connus[symboles_chercher(&C.symboles, "pharesFonctionnent")] = 1;
+    test_result("observation deja deductible -> explication vide",
+                abduire(&C, garage, &O, &E) == 1 && E.e[0].nb == 0);
+    explications_detruire(&E);
+    O.max_taille = 2;
+    O.connus = NULL;
+    test_result("taille max -> aucune explication", abduire(&C, garage, &O, &E) == 0);
+    explications_detruire(&E);
+
+    free(connus);
+    session_detruire(&S);
+    free(deduit);
+    free(conclue);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // Règle redondante, cycle A <-> B, trois causes directes de H
+    charger_bc_texte(&BC, "A => G\nA AND B => G\nA => B\nB => A\nC => A\n"
+                          "B AND D => K\nE => H\nF => H\nI => H\n");
+    bcc_compiler(&C, &BC);
+    PropId g = symboles_chercher(&C.symboles, "G");
+    test_result("regle redondante -> {C} seul",
+                abduire(&C, g, NULL, &E) == 1 && E.e[0].nb == 1 &&
+                E.e[0].faits[0] == symboles_chercher(&C.symboles, "C"));
+    explications_detruire(&E);
+    test_result("cycle -> {C, D}",
+                abduire(&C, symboles_chercher(&C.symboles, "K"), NULL, &E) == 1 && E.e[0].nb == 2);
+    explications_detruire(&E);
+
+    abduction_options_init(&O);
+    PropId h = symboles_chercher(&C.symboles, "H");
+    test_result("sans limite -> 3 explications", abduire(&C, h, &O, &E) == 3 && E.complet);
+    explications_detruire(&E);
+    O.max_explications = 2;
+    test_result("max 2 -> liste tronquee", abduire(&C, h, &O, &E) == 2 && !E.complet);
+    explications_detruire(&E);
+
+    // Prémisses supposables explicitement : A lui-même devient une cause
+    uint8_t *abductibles = (uint8_t *)calloc(bcc_nb_propositions(&C), 1);
+    abductibles[symboles_chercher(&C.symboles, "A")] = 1;
+    abductibles[symboles_chercher(&C.symboles, "C")] = 1;
+    abduction_options_init(&O);
+    O.abductibles = abductibles;
+    test_result("abductibles -> {A} et {C}", abduire(&C, g, &O, &E) == 2);
+    explications_detruire(&E);
+    free(abductibles);
+
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : compter_occurrences
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Compte les occurrences (sans chevauchement) d’un motif.
+ *
+ * Paramètres :
+ *  - texte : chaîne parcourue
+ *  - motif : sous-chaîne recherchée
+ *
+ * Valeur de retour :
+ *  - nombre d’occurrences
+ */
+static size_t compter_occurrences(const char *texte, const char *motif) {
+    size_t n = 0;
+    for (const char *p = strstr(texte, motif); p; p = strstr(p + strlen(motif), motif)) n++;
+    return n;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : diagramme_conforme
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Compare diagramme_deduire au chaînage avant d’une Session sur
+ *  tous les sous-ensembles des entrées (au plus 16) du diagramme,
+ *  ou des propositions données, et vérifie que les conclusions
+ *  d’une feuille sont rangées par identifiant croissant.
+ *
+ * Paramètres :
+ *  - D     : diagramme (éligible ou non)
+ *  - ids   : propositions combinées
+ *  - nb    : nombre de propositions (au plus 16)
+ *
+ * Valeur de retour :
+ *  - true si les faits vrais sont identiques pour chaque jeu (et
+ *    les feuilles rangées)
+ */
+static bool diagramme_conforme(const Diagramme *D, const PropId *ids, size_t nb) {
+    const BCCompilee *C = D->bc;
+    size_t np = bcc_nb_propositions(C);
+    Session S, R;
+    session_init(&S, C);
+    session_init(&R, C);
+
+    bool ok = true;
+    for (size_t m = 0; m < ((size_t)1 << nb) && ok; m++) {
+        session_reinitialiser(&S);
+        session_reinitialiser(&R);
+        for (size_t i = 0; i < nb; i++) {
+            if (!(m & ((size_t)1 << i))) continue;
+            session_affirmer(&S, ids[i]);
+            session_affirmer(&R, ids[i]);
+        }
+        if (diagramme_deduire(D, &S) != session_saturer(&R)) ok = false;
+        for (PropId p = 0; p < np; p++)
+            if (session_est_vrai(&S, p) != session_est_vrai(&R, p)) ok = false;
+        if (D->motif == DIAG_ELIGIBLE) {
+            const PropId *c;
+            size_t n = diagramme_evaluer(D, S.vrai, &c);
+            for (size_t i = 1; i < n; i++)
+                if (c[i - 1] >= c[i]) ok = false;
+        }
+    }
+
+    session_detruire(&R);
+    session_detruire(&S);
+    return ok;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_diagramme
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie le diagramme de décision : mêmes conclusions que le
+ *  chaînage avant pour chaque jeu d’entrées (voiture.kb et BC de
+ *  classification à deux niveaux), réduction, conclusions
+ *  toujours vraies, et retour au moteur général (cycle, taille,
+ *  conclusion affirmée, faits ajoutés après coup).
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Diagramme de décision (diagramme.c) et BC compilée
+ */
+void tests_diagramme(void) {
+    printf("\n--- Tests DIAGRAMME ---\n");
+
+    BaseConnaissances BC;
+    BCCompilee C;
+    Diagramme D;
+    bc_init(&BC);
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+    bcc_compiler(&C, &BC);
+
+    test_result("voiture.kb eligible", diagramme_compiler(&D, &C, 1000) && D.nb_entrees == 4);
+    test_result("voiture.kb -> diagramme == session (16 jeux)", diagramme_conforme(&D, D.entrees, D.nb_entrees));
+    // 6 ensembles de conclusions distincts ; un arbre complet aurait 31 nœuds
+    test_result("diagramme reduit", D.nb_feuilles == 6 && D.nb_noeuds == 15);
+
+    // Une seule feuille pour ¬moteurDemarre, pharesFonctionnent, ¬reservoirVide
+    uint8_t *vrai = (uint8_t *)calloc(bcc_nb_propositions(&C), 1);
+    vrai[symboles_chercher(&C.symboles, "¬moteurDemarre")] = 1;
+    vrai[symboles_chercher(&C.symboles, "pharesFonctionnent")] = 1;
+    vrai[symboles_chercher(&C.symboles, "¬reservoirVide")] = 1;
+    const PropId *c;
+    test_result("un chemin -> 4 conclusions", diagramme_evaluer(&D, vrai, &c) == 4);
+    free(vrai);
+
+    // Conclusion affirmée par la requête : moteur général
+    PropId tous[6] = {D.entrees[0], D.entrees[1], D.entrees[2], D.entrees[3],
+                      symboles_chercher(&C.symboles, "problemeStarter"),
+                      symboles_chercher(&C.symboles, "problemeBougie")};
+    test_result("conclusion affirmee -> repli conforme", diagramme_conforme(&D, tous, 6));
+
+    // Faits ajoutés après le diagramme : la session reste exacte
+    Session S, R;
+    session_init(&S, &C);
+    session_init(&R, &C);
+    session_affirmer(&S, symboles_chercher(&C.symboles, "¬moteurDemarre"));
+    session_affirmer(&R, symboles_chercher(&C.symboles, "¬moteurDemarre"));
+    diagramme_deduire(&D, &S);
+    session_saturer(&R);
+    session_affirmer(&S, symboles_chercher(&C.symboles, "pharesFonctionnent"));
+    session_affirmer(&R, symboles_chercher(&C.symboles, "pharesFonctionnent"));
+    session_saturer(&S);
+    session_saturer(&R);
+    bool memes = true;
+    for (PropId p = 0; p < bcc_nb_propositions(&C); p++)
+        if (session_est_vrai(&S, p) != session_est_vrai(&R, p)) memes = false;
+    test_result("faits ajoutes apres coup -> session exacte", memes);
+    session_detruire(&R);
+    session_detruire(&S);
+    diagramme_detruire(&D);
+
+    test_result("taille max -> non eligible", !diagramme_compiler(&D, &C, 6) && D.motif == DIAG_TROP_GRAND);
+    test_result("trop grand -> repli conforme", diagramme_conforme(&D, tous, 4));
+    diagramme_detruire(&D);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // Cycle : non éligible, repli
+    charger_bc_texte(&BC, "A => B\nB AND E => A\nB => G\n");
+    bcc_compiler(&C, &BC);
+    test_result("cycle -> non eligible", !diagramme_compiler(&D, &C, 1000) && D.motif == DIAG_CYCLE);
+    PropId ae[2] = {symboles_chercher(&C.symboles, "A"), symboles_chercher(&C.symboles, "E")};
+    test_result("cycle -> repli conforme", diagramme_conforme(&D, ae, 2));
+    diagramme_detruire(&D);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // Classification à deux niveaux sur 10 entrées, plus une conclusion sans prémisse
+    char nom[32];
+    for (int r = 0; r < 40; r++) {
+        Regle R;
+        regle_init(&R);
+        int k = r < 30 ? 2 + r % 3 : 2;
+        for (int j = 0; j < k; j++) {
+            if (r < 30) snprintf(nom, sizeof(nom), "E%d", (r * 7 + j * 3) % 10);
+            else snprintf(nom, sizeof(nom), "M%d", (r * 5 + j * 11) % 30);
+            regle_ajouter_premisse(&R, nom);
+        }
+        snprintf(nom, sizeof(nom), r < 30 ? "M%d" : "D%d", r < 30 ? r : r % 6);
+        regle_definir_conclusion(&R, nom);
+        bc_ajouter_regle_en_queue(&BC, &R);
+        regle_detruire(&R);
+    }
+    Regle axiome, avec_axiome;
+    regle_init(&axiome);
+    regle_definir_conclusion(&axiome, "Z");
+    bc_ajouter_regle_en_queue(&BC, &axiome);
+    regle_detruire(&axiome);
+    regle_init(&avec_axiome);
+    regle_ajouter_premisse(&avec_axiome, "Z");
+    regle_ajouter_premisse(&avec_axiome, "E4");
+    regle_definir_conclusion(&avec_axiome, "D9");
+    bc_ajouter_regle_en_queue(&BC, &avec_axiome);
+    regle_detruire(&avec_axiome);
+
+    bcc_compiler(&C, &BC);
+    test_result("classification eligible", diagramme_compiler(&D, &C, 100000) && D.nb_entrees == 10 &&
+                D.conclue[symboles_chercher(&C.symboles, "Z")] == 2);
+    test_result("classification -> diagramme == session (1024 jeux)",
+                diagramme_conforme(&D, D.entrees, D.nb_entrees));
+    diagramme_detruire(&D);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : lot_conforme
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Sature LOT_TAILLE requêtes tirées au hasard parmi des faits de
+ *  base, en un lot et une à une avec une Session, et compare.
+ *
+ * Paramètres :
+ *  - C    : BC compilée
+ *  - base : faits de base possibles
+ *  - nb   : nombre de faits de base (au plus 64)
+ *  - L    : session par lots (réinitialisée ici)
+ *
+ * Valeur de retour :
+ *  - true si chaque requête a les mêmes faits vrais
+ */
+static bool lot_conforme(const BCCompilee *C, const PropId *base, size_t nb, SessionLot *L) {
+    size_t np = bcc_nb_propositions(C);
+    uint64_t *jeux = (uint64_t *)malloc(LOT_TAILLE * sizeof(uint64_t));
+    uint64_t etat = 0x2545F4914F6CDD1Dull;
+    Session S;
+    session_init(&S, C);
+
+    lot_reinitialiser(L);
+    for (size_t q = 0; q < LOT_TAILLE; q++) {
+        etat ^= etat << 13;
+        etat ^= etat >> 7;
+        etat ^= etat << 17;
+        jeux[q] = etat;
+        for (size_t i = 0; i < nb; i++)
+            if ((jeux[q] >> i) & 1u) lot_affirmer(L, q, base[i]);
+    }
+    size_t deduits = lot_saturer(L), attendus = 0;
+
+    bool ok = true;
+    for (size_t q = 0; q < LOT_TAILLE && ok; q++) {
+        // Faits vrais non affirmés (conclusions sans prémisse comprises)
+        session_reinitialiser(&S);
+        size_t affirmes = 0;
+        for (size_t i = 0; i < nb; i++)
+            if ((jeux[q] >> i) & 1u) affirmes += session_affirmer(&S, base[i]);
+        session_saturer(&S);
+        attendus += S.nb_faits - affirmes;
+        for (PropId p = 0; p < np; p++)
+            if (session_est_vrai(&S, p) != lot_est_vrai(L, q, p)) ok = false;
+    }
+
+    session_detruire(&S);
+    free(jeux);
+    return ok && deduits == attendus;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_lot
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie l’évaluation par lots en tranches de bits : mêmes
+ *  faits qu’une Session pour chaque requête (voiture.kb, BC
+ *  cyclique, BC aléatoire), un seul passage sans cycle, requêtes
+ *  indépendantes et réinitialisation.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Sessions par lots (lot.c) et BC compilée
+ */
+void tests_lot(void) {
+    printf("\n--- Tests LOT ---\n");
+
+    BaseConnaissances BC;
+    BCCompilee C;
+    SessionLot L;
+    bc_init(&BC);
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+    bcc_compiler(&C, &BC);
+    lot_init(&L, &C);
+
+    const char *entrees[4] = {"¬reservoirVide", "pharesFonctionnent", "¬moteurDemarre", "¬pharesFonctionnent"};
+    PropId base[4];
+    for (int i = 0; i < 4; i++) base[i] = symboles_chercher(&C.symboles, entrees[i]);
+    test_result("voiture.kb -> lot == session", lot_conforme(&C, base, 4, &L));
+    test_result("sans cycle -> un passage", !L.cyclique && L.passages == 1);
+
+    // Requêtes voisines indépendantes
+    PropId garage = symboles_chercher(&C.symboles, "appelerGarage");
+    lot_reinitialiser(&L);
+    size_t q = LOT_TAILLE / 2;
+    for (int i = 0; i < 3; i++) lot_affirmer(&L, q, base[i]);
+    lot_affirmer(&L, q + 1, base[2]);
+    lot_affirmer(&L, q + 1, base[3]);
+    test_result("requetes independantes", lot_saturer(&L) == 4 + 2 && lot_est_vrai(&L, q, garage) &&
+                !lot_est_vrai(&L, q + 1, garage) && !lot_est_vrai(&L, q - 1, base[2]));
+    lot_reinitialiser(&L);
+    test_result("reinitialiser -> lot vide", !lot_est_vrai(&L, q, base[0]) && lot_saturer(&L) == 0);
+    lot_detruire(&L);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // Cycle : A <-> B, règle en aval déclarée avant
+    charger_bc_texte(&BC, "B AND D => G\nA => B\nB AND E => A\nC => A\n");
+    bcc_compiler(&C, &BC);
+    lot_init(&L, &C);
+    PropId abcde[5];
+    for (int i = 0; i < 5; i++) {
+        char nom[2] = {(char)('A' + i), '\0'};
+        abcde[i] = symboles_chercher(&C.symboles, nom);
+    }
+    test_result("cycle -> lot == session", L.cyclique && lot_conforme(&C, abcde, 5, &L));
+    lot_detruire(&L);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+
+    // BC aléatoire : 300 règles sur 80 propositions, 40 faits de base, plus un axiome
+    char nom[32];
+    uint64_t etat = 88172645463325252ull;
+    for (int r = 0; r < 300; r++) {
+        Regle R;
+        regle_init(&R);
+        etat ^= etat << 13;
+        etat ^= etat >> 7;
+        etat ^= etat << 17;
+        for (int k = 0; k < 1 + (int)(etat % 3); k++) {
+            snprintf(nom, sizeof(nom), "P%d", (int)((etat >> (8 * k + 8)) % 80));
+            regle_ajouter_premisse(&R, nom);
+        }
+        snprintf(nom, sizeof(nom), "P%d", 40 + (int)((etat >> 40) % 40));
+        regle_definir_conclusion(&R, nom);
+        bc_ajouter_regle_en_queue(&BC, &R);
+        regle_detruire(&R);
+    }
+    Regle axiome;
+    regle_init(&axiome);
+    regle_definir_conclusion(&axiome, "P79");
+    bc_ajouter_regle_en_queue(&BC, &axiome);
+    regle_detruire(&axiome);
+
+    bcc_compiler(&C, &BC);
+    lot_init(&L, &C);
+    PropId aleatoires[40];
+    size_t nb = 0;
+    for (int i = 0; i < 40; i++) {
+        snprintf(nom, sizeof(nom), "P%d", i);
+        PropId p = symboles_chercher(&C.symboles, nom);
+        if (p != PROP_AUCUNE) aleatoires[nb++] = p;
+    }
+    test_result("BC aleatoire -> lot == session", lot_conforme(&C, aleatoires, nb, &L));
+    lot_detruire(&L);
+    bcc_detruire(&C);
+    bc_vider(&BC);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_trace
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Active le traceur, exécute chargement, compilation, inférence
+ *  et mode flux, puis vérifie le JSON exporté : phases présentes,
+ *  débuts et fins appariés, threads du flux nommés.
+ *  Ignoré si une trace est déjà en cours (option --trace).
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Traceur (anneaux par thread, export Chrome trace)
+ */
+void tests_trace(void) {
+    printf("\n--- Tests TRACE ---\n");
+    if (atomic_load(&trace_actif)) {
+        printf("Trace en cours : tests ignorés.\n");
+        return;
+    }
+
+    trace_activer();
+
+    BaseConnaissances BC;
+    bc_init(&BC);
+    bc_charger_fichier(&BC, LO21_EXEMPLES "/voiture.kb");
+
+    BaseFaits BF;
+    bf_init(&BF);
+    bf_ajouter(&BF, "¬moteurDemarre");
+    bf_ajouter(&BF, "¬reservoirVide");
+    moteur_inference(&BC, &BF);
+
+    BCCompilee C;
+    bcc_compiler(&C, &BC);
+    FILE *entree = tmpfile();
+    FILE *sortie = tmpfile();
+    fputs("¬moteurDemarre\n", entree);
+    rewind(entree);
+    flux_executer(&C, entree, sortie, NULL);
+    fclose(entree);
+    fclose(sortie);
+
+    const char *chemin = "lo21_tests_trace.json";
+    test_result("trace -> export", trace_exporter(chemin));
+    trace_liberer();
+
+    FILE *f = fopen(chemin, "r");
+    char *json = (char *)calloc(1 << 16, 1);
+    if (f && json) json[fread(json, 1, (1 << 16) - 1, f)] = '\0';
+    if (f) fclose(f);
+    remove(chemin);
+
+    const char *texte = json ? json : "";
+    test_result("trace -> phases", strstr(texte, "\"chargement_bc\"") && strstr(texte, "\"compilation\"") &&
+                strstr(texte, "\"tour\"") && strstr(texte, "\"vidage_sortie\""));
+    test_result("trace -> debuts == fins",
+                compter_occurrences(texte, "\"ph\":\"B\"") == compter_occurrences(texte, "\"ph\":\"E\"") &&
+                compter_occurrences(texte, "\"ph\":\"B\"") > 0);
+    test_result("trace -> threads nommes", strstr(texte, "\"ecrivain\"") && strstr(texte, "\"moteur\""));
+    test_result("trace -> desactivee", !atomic_load(&trace_actif));
+
+    free(json);
+    bcc_detruire(&C);
+    bf_detruire(&BF);
+    bc_vider(&BC);
+}
+
+/* Point de reprise utilisé par tests_alloc lors d’un dépassement de quota */
+static jmp_buf reprise_quota;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : quota_depasse
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Gestionnaire d’échec de l’allocateur de test : revient au
+ *  point de reprise au lieu d’arrêter le programme.
+ *
+ * Paramètres :
+ *  - ctx : inutilisé
+ *  - n   : taille refusée
+ *
+ * Valeur de retour :
+ *  - Aucune (ne retourne pas)
+ */
+static void quota_depasse(void *ctx, size_t n) {
+    (void)ctx;
+    (void)n;
+    longjmp(reprise_quota, 1);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : tests_alloc
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Vérifie l’allocateur comptable branché sur une BC, sa forme
+ *  compilée, une session et une base de faits : toute la mémoire
+ *  est comptée puis rendue, et une limite est respectée.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Modules testés :
+ *  - Allocateur interchangeable (alloc.c)
+ */
+void tests_alloc(void) {
+    printf("\n--- Tests ALLOC ---\n");
+
+    CompteurAlloc compteur;
+    compteur_init(&compteur, NULL, 0);
+    const Allocateur *A = compteur_allocateur(&compteur);
+
+    BaseConnaissances BC;
+    bc_init_avec(&BC, A);
+    FILE *f = tmpfile();
+    fputs("A AND B => C\nC => D\n", f);
+    rewind(f);
+    bc_charger_flux(&BC, f);
+    fclose(f);
+    size_t octets_bc = compteur.octets;
+    test_result("alloc -> BC comptee", octets_bc > 0 && compteur.nb_allocations > 0);
+
+    BCCompilee C;
+    bcc_compiler(&C, &BC);
+    Session S;
+    session_init(&S, &C);
+    session_affirmer(&S, symboles_chercher(&C.symboles, "A"));
+    session_affirmer(&S, symboles_chercher(&C.symboles, "B"));
+    session_saturer(&S);
+    test_result("alloc -> session sur compteur", compteur.octets > octets_bc &&
+                session_est_vrai(&S, symboles_chercher(&C.symboles, "D")));
+    session_detruire(&S);
+    bcc_detruire(&C);
+    test_result("alloc -> compilation rendue", compteur.octets == octets_bc);
+
+    BaseFaits BF;
+    bf_init_avec(&BF, A);
+    bf_ajouter(&BF, "A");
+    bf_ajouter(&BF, "B");
+    moteur_inference(&BC, &BF);
+    bf_detruire(&BF);
+    bc_vider(&BC);
+    test_result("alloc -> tout est rendu", compteur.octets == 0 && compteur.nb_allocations == 0);
+    test_result("alloc -> pic mesure", compteur.pic > octets_bc);
+
+    // Quota de 256 octets : l’échec revient ici par longjmp
+    CompteurAlloc quota;
+    compteur_init(&quota, NULL, 256);
+    quota.vtable.echec = quota_depasse;
+    Liste L;
+    liste_init_avec(&L, compteur_allocateur(&quota));
+
+    volatile size_t ajoutes = 0;
+    if (setjmp(reprise_quota) == 0) {
+        for (;;) {
+            liste_ajouter_en_queue(&L, "proposition");
+            ajoutes++;
+        }
+    }
+    test_result("alloc -> quota respecte", quota.nb_refus == 1 && quota.pic <= 256 &&
+                L.size == ajoutes && ajoutes > 0);
+    liste_vider(&L);
+    test_result("alloc -> quota rendu", quota.octets == 0);
 }
 
 /*
@@ -270,8 +2573,25 @@ void phase_tests(void) {
     // Lancement des tests par module
     tests_liste();
     tests_regle();
+    tests_bc();
     tests_hash();
+    tests_faits();
     tests_inference();
+    tests_compilation();
+    tests_flux();
+    tests_codegen();
+    tests_datalog();
+    tests_shards();
+    tests_ensemble();
+    tests_journal();
+    tests_fermeture();
+    tests_veille();
+    tests_profil();
+    tests_abduction();
+    tests_diagramme();
+    tests_lot();
+    tests_trace();
+    tests_alloc();
 
     // Résumé final
     printf("\n=== FIN DES TESTS ===\n");
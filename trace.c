@@ -0,0 +1,273 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "trace.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    const char *nom;
+    uint64_t ns;      // depuis l’activation du traceur
+    char phase;       // 'B' (début) ou 'E' (fin)
+} EvenementTrace;
+
+typedef struct AnneauTrace {
+    EvenementTrace evenements[TRACE_CAPACITE];
+    uint64_t total;                // événements écrits depuis la création
+    unsigned tid;
+    const char *nom_thread;
+    struct AnneauTrace *suivant;   // registre global
+} AnneauTrace;
+
+atomic_bool trace_actif = false;
+
+static uint64_t origine_ns;
+static _Thread_local AnneauTrace *anneau_local = NULL;
+
+static pthread_mutex_t registre_verrou = PTHREAD_MUTEX_INITIALIZER;
+static AnneauTrace *registre = NULL;
+static unsigned prochain_tid = 1;
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : horloge_ns
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Lit l’horloge monotone.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - temps courant en nanosecondes
+ */
+static uint64_t horloge_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : anneau_thread
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retourne l’anneau du thread appelant, en le créant et en
+ *  l’inscrivant au registre lors du premier événement.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - anneau du thread
+ *  - NULL si l’allocation échoue (l’événement est perdu)
+ */
+static AnneauTrace *anneau_thread(void) {
+    if (anneau_local) return anneau_local;
+
+    AnneauTrace *A = (AnneauTrace *)calloc(1, sizeof(AnneauTrace));
+    if (!A) return NULL;
+
+    pthread_mutex_lock(&registre_verrou);
+    A->tid = prochain_tid++;
+    A->suivant = registre;
+    registre = A;
+    pthread_mutex_unlock(&registre_verrou);
+
+    anneau_local = A;
+    return A;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : enregistrer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Ajoute un événement horodaté dans l’anneau du thread.
+ *
+ * Paramètres :
+ *  - nom   : nom de la phase
+ *  - phase : 'B' ou 'E'
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void enregistrer(const char *nom, char phase) {
+    AnneauTrace *A = anneau_thread();
+    if (!A) return;
+
+    EvenementTrace *e = &A->evenements[A->total % TRACE_CAPACITE];
+    e->nom = nom;
+    e->ns = horloge_ns() - origine_ns;
+    e->phase = phase;
+    A->total++;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trace_activer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Active le traceur ; les horodatages partent de cet instant.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void trace_activer(void) {
+    origine_ns = horloge_ns();
+    atomic_store(&trace_actif, true);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trace_debut / trace_fin
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Marquent le début et la fin d’une phase sur le thread
+ *  appelant (utiliser de préférence TRACE_DEBUT / TRACE_FIN).
+ *
+ * Paramètres :
+ *  - nom : nom de la phase (chaîne statique, non copiée)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void trace_debut(const char *nom) {
+    enregistrer(nom, 'B');
+}
+
+void trace_fin(const char *nom) {
+    enregistrer(nom, 'E');
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trace_nommer_thread
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne un nom au thread appelant dans la trace exportée.
+ *
+ * Paramètres :
+ *  - nom : nom du thread (chaîne statique)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void trace_nommer_thread(const char *nom) {
+    if (!atomic_load_explicit(&trace_actif, memory_order_relaxed)) return;
+
+    AnneauTrace *A = anneau_thread();
+    if (A) A->nom_thread = nom;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : ecrire_nom_json
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit une chaîne JSON en échappant guillemets, barres
+ *  obliques inverses et caractères de contrôle.
+ *
+ * Paramètres :
+ *  - f : fichier de sortie
+ *  - s : chaîne à écrire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+static void ecrire_nom_json(FILE *f, const char *s) {
+    fputc('"', f);
+    for (const unsigned char *p = (const unsigned char *)s; *p; p++) {
+        if (*p == '"' || *p == '\\') fprintf(f, "\\%c", *p);
+        else if (*p < 0x20) fprintf(f, "\\u%04x", *p);
+        else fputc(*p, f);
+    }
+    fputc('"', f);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trace_exporter
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Écrit tous les anneaux au format Chrome trace JSON. À appeler
+ *  une fois les threads tracés terminés.
+ *
+ * Paramètres :
+ *  - chemin : fichier de sortie
+ *
+ * Valeur de retour :
+ *  - true  : fichier écrit
+ *  - false : ouverture ou écriture impossible
+ *
+ * Variables locales :
+ *  - premier : aucun événement encore écrit (gestion des virgules)
+ *  - debut   : premier événement encore présent dans l’anneau
+ */
+bool trace_exporter(const char *chemin) {
+    FILE *f = fopen(chemin, "w");
+    if (!f) {
+        perror(chemin);
+        return false;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool premier = true;
+
+    pthread_mutex_lock(&registre_verrou);
+    for (AnneauTrace *A = registre; A; A = A->suivant) {
+        if (A->nom_thread) {
+            fprintf(f, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                    premier ? "" : ",", A->tid);
+            ecrire_nom_json(f, A->nom_thread);
+            fprintf(f, "}}");
+            premier = false;
+        }
+
+        uint64_t debut = A->total > TRACE_CAPACITE ? A->total - TRACE_CAPACITE : 0;
+        for (uint64_t i = debut; i < A->total; i++) {
+            const EvenementTrace *e = &A->evenements[i % TRACE_CAPACITE];
+            fprintf(f, "%s\n{\"name\":", premier ? "" : ",");
+            ecrire_nom_json(f, e->nom);
+            fprintf(f, ",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u}", e->phase,
+                    (unsigned long long)(e->ns / 1000), (unsigned)(e->ns % 1000), A->tid);
+            premier = false;
+        }
+    }
+    pthread_mutex_unlock(&registre_verrou);
+
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : trace_liberer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Désactive le traceur et libère tous les anneaux. Les threads
+ *  tracés doivent être terminés.
+ *
+ * Paramètres :
+ *  - Aucun
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void trace_liberer(void) {
+    atomic_store(&trace_actif, false);
+
+    pthread_mutex_lock(&registre_verrou);
+    while (registre) {
+        AnneauTrace *A = registre;
+        registre = A->suivant;
+        free(A);
+    }
+    pthread_mutex_unlock(&registre_verrou);
+    anneau_local = NULL;
+}
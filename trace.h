@@ -0,0 +1,32 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Traceur optionnel des phases du moteur. Chaque thread écrit dans
+ * son propre anneau d’événements ; l’export produit un fichier JSON
+ * au format Chrome trace (chrome://tracing, Perfetto).
+ * Désactivé, chaque point de trace ne coûte qu’une lecture atomique.
+ */
+
+/* Nombre d’événements conservés par thread (les plus anciens sont écrasés) */
+#define TRACE_CAPACITE 65536
+
+extern atomic_bool trace_actif;
+
+void trace_activer(void);
+void trace_debut(const char *nom);    // nom : chaîne statique
+void trace_fin(const char *nom);
+void trace_nommer_thread(const char *nom);
+bool trace_exporter(const char *chemin);
+void trace_liberer(void);
+
+#define TRACE_DEBUT(nom) \
+    do { if (atomic_load_explicit(&trace_actif, memory_order_relaxed)) trace_debut(nom); } while (0)
+#define TRACE_FIN(nom) \
+    do { if (atomic_load_explicit(&trace_actif, memory_order_relaxed)) trace_fin(nom); } while (0)
+
+#endif
@@ -0,0 +1,256 @@
+#include "veille.h"
+#include "trace.h"
+#include <string.h>
+
+/* Fin d’une liste de surveillance */
+#define VEILLE_FIN UINT32_MAX
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_init
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Prépare une session à prémisses surveillées sur une BC
+ *  compilée, avec l’allocateur de la BC.
+ *
+ * Paramètres :
+ *  - V : session à initialiser
+ *  - C : BC compilée (doit survivre à la session)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void veille_init(SessionVeille *V, const BCCompilee *C) {
+    veille_init_avec(V, C, C->symboles.alloc);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_init_avec
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Comme veille_init, avec un allocateur propre à la session.
+ *  Chaque règle surveille sa première prémisse ; les règles sans
+ *  prémisse placent leur conclusion au fond de la pile.
+ *
+ * Paramètres :
+ *  - V : session à initialiser
+ *  - C : BC compilée (doit survivre à la session)
+ *  - A : allocateur (NULL : allocateur système)
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ *
+ * Variables locales :
+ *  - np : nombre de propositions
+ *  - p  : première prémisse de la règle courante
+ */
+void veille_init_avec(SessionVeille *V, const BCCompilee *C, const Allocateur *A) {
+    size_t np = bcc_nb_propositions(C);
+
+    V->bc = C;
+    V->alloc = A ? A : &allocateur_systeme;
+    V->vrai = (uint8_t *)mem_allouer_zero(V->alloc, np);
+    V->surveillee = (uint32_t *)mem_allouer(V->alloc, C->nb_regles * sizeof(uint32_t));
+    V->tete = (uint32_t *)mem_allouer(V->alloc, np * sizeof(uint32_t));
+    V->suivante = (uint32_t *)mem_allouer(V->alloc, C->nb_regles * sizeof(uint32_t));
+    V->faits = (PropId *)mem_allouer(V->alloc, np * sizeof(PropId));
+    V->nb_faits = V->curseur = V->deplacements = 0;
+
+    memset(V->tete, 0xFF, np * sizeof(uint32_t));
+    for (size_t r = 0; r < C->nb_regles; r++) {
+        const RegleCompilee *R = &C->regles[r];
+        V->surveillee[r] = 0;
+        if (R->nb == 0) {
+            V->suivante[r] = VEILLE_FIN;
+            veille_affirmer(V, R->conclusion);
+            continue;
+        }
+        PropId p = C->premisses[R->debut];
+        V->suivante[r] = V->tete[p];
+        V->tete[p] = (uint32_t)r;
+    }
+    V->base = V->nb_faits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_affirmer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Empile un fait. La propagation n’a lieu qu’à l’appel de
+ *  veille_saturer.
+ *
+ * Paramètres :
+ *  - V : session
+ *  - p : proposition affirmée
+ *
+ * Valeur de retour :
+ *  - true  : le fait est nouveau
+ *  - false : il était déjà vrai (ou l’identifiant est inconnu)
+ */
+bool veille_affirmer(SessionVeille *V, PropId p) {
+    if (p >= bcc_nb_propositions(V->bc) || V->vrai[p]) return false;
+
+    V->vrai[p] = 1;
+    V->faits[V->nb_faits++] = p;
+    return true;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_saturer
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Propage les faits en attente. Pour chaque règle qui surveille
+ *  le fait propagé, les prémisses sont parcourues circulairement
+ *  à partir de la prémisse surveillée jusqu’à en trouver une
+ *  fausse, qui devient surveillée ; s’il n’y en a pas, la règle
+ *  affirme sa conclusion et garde sa surveillance (sur le fait le
+ *  plus récent de ses prémisses).
+ *
+ * Paramètres :
+ *  - V : session
+ *
+ * Valeur de retour :
+ *  - nombre de faits déduits pendant l’appel
+ *
+ * Variables locales :
+ *  - p     : fait en cours de propagation
+ *  - r     : règle qui surveillait p
+ *  - prem  : prémisses de r
+ *  - j     : rang de la prémisse examinée
+ */
+size_t veille_saturer(SessionVeille *V) {
+    const BCCompilee *C = V->bc;
+    const uint8_t *vrai = V->vrai;
+    size_t deduits = 0;
+
+    while (V->curseur < V->nb_faits) {
+        PropId p = V->faits[V->curseur++];
+
+        // La liste de p est reconstruite avec les règles qui la gardent
+        uint32_t r = V->tete[p];
+        V->tete[p] = VEILLE_FIN;
+        while (r != VEILLE_FIN) {
+            uint32_t suivante = V->suivante[r];
+            const RegleCompilee *R = &C->regles[r];
+            const PropId *prem = C->premisses + R->debut;
+
+            uint32_t j = V->surveillee[r];
+            bool trouve = false;
+            for (uint32_t k = 1; k < R->nb; k++) {
+                if (++j == R->nb) j = 0;
+                if (!vrai[prem[j]]) {
+                    trouve = true;
+                    break;
+                }
+            }
+
+            if (trouve) {
+                V->surveillee[r] = j;
+                V->suivante[r] = V->tete[prem[j]];
+                V->tete[prem[j]] = r;
+                V->deplacements++;
+            } else {
+                V->suivante[r] = V->tete[p];
+                V->tete[p] = r;
+                if (veille_affirmer(V, R->conclusion)) deduits++;
+            }
+            r = suivante;
+        }
+    }
+    return deduits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_est_vrai
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Indique si une proposition est vraie dans la session.
+ *
+ * Paramètres :
+ *  - V : session
+ *  - p : proposition testée
+ *
+ * Valeur de retour :
+ *  - true si le fait est connu (affirmé ou déduit)
+ */
+bool veille_est_vrai(const SessionVeille *V, PropId p) {
+    return p < bcc_nb_propositions(V->bc) && V->vrai[p];
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_niveau
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Donne la hauteur de la pile des faits, point de retour pour
+ *  veille_revenir. Le niveau doit être relevé sur une session
+ *  saturée (tous les faits empilés ont été propagés).
+ *
+ * Paramètres :
+ *  - V : session
+ *
+ * Valeur de retour :
+ *  - nombre de faits vrais
+ */
+size_t veille_niveau(const SessionVeille *V) {
+    return V->nb_faits;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_revenir
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Retire les faits empilés au-delà d’un niveau (hypothèses et
+ *  leurs conséquences). Aucune surveillance n’est modifiée : une
+ *  règle dont une prémisse est dépilée surveille une prémisse
+ *  empilée au moins aussi tard, donc redevenue fausse elle aussi.
+ *  Le coût ne dépend que du nombre de faits retirés.
+ *
+ * Paramètres :
+ *  - V      : session
+ *  - niveau : niveau relevé par veille_niveau
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void veille_revenir(SessionVeille *V, size_t niveau) {
+    if (niveau < V->base) niveau = V->base;
+    if (niveau >= V->nb_faits) return;
+
+    TRACE_DEBUT("veille_revenir");
+    for (size_t i = niveau; i < V->nb_faits; i++) V->vrai[V->faits[i]] = 0;
+    V->nb_faits = niveau;
+    if (V->curseur > niveau) V->curseur = niveau;
+    TRACE_FIN("veille_revenir");
+}
+
+/*
+ * ------------------------------------------------------------
+ * Fonction : veille_detruire
+ * ------------------------------------------------------------
+ * Rôle :
+ *  Libère les tableaux de la session (la BC compilée n’est pas
+ *  touchée).
+ *
+ * Paramètres :
+ *  - V : session à détruire
+ *
+ * Valeur de retour :
+ *  - Aucune (void)
+ */
+void veille_detruire(SessionVeille *V) {
+    mem_liberer(V->alloc, V->vrai);
+    mem_liberer(V->alloc, V->surveillee);
+    mem_liberer(V->alloc, V->tete);
+    mem_liberer(V->alloc, V->suivante);
+    mem_liberer(V->alloc, V->faits);
+    V->vrai = NULL;
+    V->surveillee = V->tete = V->suivante = NULL;
+    V->faits = NULL;
+    V->nb_faits = V->curseur = 0;
+}
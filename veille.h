@@ -0,0 +1,51 @@
+#ifndef VEILLE_H
+#define VEILLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "compile.h"
+
+/*
+ * Propagation par prémisse surveillée (idée des « littéraux
+ * surveillés » des solveurs SAT), alternative à Session pour les
+ * règles à très nombreuses prémisses. Chaque règle ne surveille
+ * qu’une prémisse encore fausse ; quand elle devient vraie, la
+ * surveillance passe à la prémisse fausse suivante, et la règle se
+ * déclenche s’il n’y en a plus. Il n’y a ni compteur par règle ni
+ * parcours des listes complètes : le travail est proportionnel aux
+ * déplacements de surveillance.
+ *
+ * Les faits forment une pile (ordre d’arrivée). Une règle déclenchée
+ * surveille la prémisse devenue vraie en dernier, si bien qu’un retour
+ * à un niveau antérieur (veille_revenir) ne touche aucune
+ * surveillance : seuls les faits dépilés redeviennent faux.
+ */
+
+typedef struct {
+    const BCCompilee *bc;
+    uint8_t *vrai;          // par proposition
+    uint32_t *surveillee;   // par règle : rang de la prémisse surveillée
+    uint32_t *tete;         // par proposition : première règle qui la surveille
+    uint32_t *suivante;     // par règle : règle suivante surveillant la même prémisse
+    PropId *faits;          // pile des faits vrais (sert d’agenda)
+    size_t nb_faits;
+    size_t curseur;         // prochain fait à propager
+    size_t base;            // conclusions des règles sans prémisse (jamais dépilées)
+    size_t deplacements;    // surveillances déplacées depuis l’initialisation
+    const Allocateur *alloc;
+} SessionVeille;
+
+void veille_init(SessionVeille *V, const BCCompilee *C);
+void veille_init_avec(SessionVeille *V, const BCCompilee *C, const Allocateur *A);
+bool veille_affirmer(SessionVeille *V, PropId p);
+size_t veille_saturer(SessionVeille *V);
+bool veille_est_vrai(const SessionVeille *V, PropId p);
+
+/* Niveau (taille de la pile) à relever après veille_saturer, puis retour arrière */
+size_t veille_niveau(const SessionVeille *V);
+void veille_revenir(SessionVeille *V, size_t niveau);
+
+void veille_detruire(SessionVeille *V);
+
+#endif